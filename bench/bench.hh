@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Minimal google-benchmark style harness for bench-typed-geometry
+//
+// usage:
+//
+//   template <class ScalarT>
+//   void bench_foo(tgbench::state& s)
+//   {
+//       auto data = ...; // setup is not timed
+//       size_t i = 0;
+//       while (s.keep_running())
+//           tgbench::do_not_optimize(foo(data[i++ % data.size()]));
+//   }
+//   TG_BENCHMARK_TEMPLATE(bench_foo, tg::f32);
+//   TG_BENCHMARK_TEMPLATE(bench_foo, tg::f64);
+//
+// the runner calls each benchmark with increasing iteration counts until the timed loop
+// takes at least the configured minimum time and reports ns/op and items/s
+// (items per iteration default to 1 and can be changed via s.set_items_per_iteration)
+//
+// all random inputs must use tgbench::seed so runs are reproducible
+
+namespace tgbench
+{
+inline constexpr std::uint64_t seed = 0x7e0d5eed;
+
+class state
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    explicit state(std::size_t iterations) : _iterations(iterations), _remaining(iterations) {}
+
+    /// returns true exactly iterations() times, the time between the first and last call is measured
+    bool keep_running()
+    {
+        if (_remaining == _iterations)
+            _start = clock::now();
+        if (_remaining > 0)
+        {
+            --_remaining;
+            return true;
+        }
+        _stop = clock::now();
+        return false;
+    }
+
+    std::size_t iterations() const { return _iterations; }
+    void set_items_per_iteration(std::size_t n) { _items_per_iteration = n; }
+    std::size_t items_per_iteration() const { return _items_per_iteration; }
+
+    double elapsed_ns() const { return double(std::chrono::duration_cast<std::chrono::nanoseconds>(_stop - _start).count()); }
+
+private:
+    std::size_t _iterations;
+    std::size_t _remaining;
+    std::size_t _items_per_iteration = 1;
+    clock::time_point _start;
+    clock::time_point _stop;
+};
+
+/// prevents the compiler from removing the computation of v
+template <class T>
+inline void do_not_optimize(T const& v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(v) : "memory");
+#else
+    auto volatile sink = &v;
+    (void)sink;
+#endif
+}
+
+struct benchmark
+{
+    std::string name;
+    void (*fn)(state&);
+};
+
+inline std::vector<benchmark>& registry()
+{
+    static std::vector<benchmark> r;
+    return r;
+}
+
+struct registrar
+{
+    registrar(char const* name, void (*fn)(state&)) { registry().push_back({name, fn}); }
+};
+}
+
+#define TG_BENCH_DETAIL_CONCAT_IMPL(a, b) a##b
+#define TG_BENCH_DETAIL_CONCAT(a, b) TG_BENCH_DETAIL_CONCAT_IMPL(a, b)
+
+#define TG_BENCHMARK(fn) static ::tgbench::registrar TG_BENCH_DETAIL_CONCAT(_tg_bench_reg_, __LINE__)(#fn, fn)
+#define TG_BENCHMARK_TEMPLATE(fn, T) static ::tgbench::registrar TG_BENCH_DETAIL_CONCAT(_tg_bench_reg_, __LINE__)(#fn "<" #T ">", fn<T>)
@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench.hh"
+
+// bench-typed-geometry [options]
+//
+//   --filter <substr>      only run benchmarks whose name contains substr
+//   --min-time <seconds>   minimum timed duration per measurement (default 0.2)
+//   --repetitions <n>      measurements per benchmark, the median is reported (default 3)
+//   --json <file>          write results as JSON
+//   --compare <file>       compare against a JSON file written by --json
+//   --threshold <ratio>    relative ns/op increase that counts as regression (default 0.1)
+//   --list                 print benchmark names and exit
+//
+// returns 1 if --compare found a regression
+
+namespace
+{
+struct result
+{
+    std::string name;
+    std::size_t iterations;
+    double ns_per_op;
+    double items_per_second;
+};
+
+result run(tgbench::benchmark const& b, double min_time_ns, int repetitions)
+{
+    std::vector<double> ns_per_op;
+    std::size_t iterations = 1;
+    std::size_t items = 1;
+    for (auto r = 0; r < repetitions; ++r)
+    {
+        while (true)
+        {
+            tgbench::state s(iterations);
+            b.fn(s);
+            auto const ns = s.elapsed_ns();
+            if (ns >= min_time_ns || iterations >= std::size_t(1) << 40)
+            {
+                ns_per_op.push_back(ns / double(iterations));
+                items = s.items_per_iteration();
+                break;
+            }
+
+            // aim slightly above the minimum time, but grow at most 10x per step
+            auto const predicted = ns > 0 ? min_time_ns * 1.4 / ns * double(iterations) : double(iterations) * 10;
+            iterations = std::max(iterations + 1, std::min(iterations * 10, std::size_t(predicted)));
+        }
+    }
+
+    std::sort(ns_per_op.begin(), ns_per_op.end());
+    auto const median = ns_per_op[ns_per_op.size() / 2];
+    return {b.name, iterations, median, median > 0 ? double(items) * 1e9 / median : 0.0};
+}
+
+std::string json_escape(std::string const& s)
+{
+    std::string r;
+    for (auto c : s)
+    {
+        if (c == '"' || c == '\\')
+            r += '\\';
+        r += c;
+    }
+    return r;
+}
+
+bool write_json(char const* filename, std::vector<result> const& results)
+{
+    std::ofstream out(filename);
+    if (!out)
+        return false;
+
+    out << "{\n";
+    out << "  \"context\": {\n";
+#if defined(__clang__)
+    out << "    \"compiler\": \"clang " << __clang_major__ << "." << __clang_minor__ << "\",\n";
+#elif defined(__GNUC__)
+    out << "    \"compiler\": \"gcc " << __GNUC__ << "." << __GNUC_MINOR__ << "\",\n";
+#elif defined(_MSC_VER)
+    out << "    \"compiler\": \"msvc " << _MSC_VER << "\",\n";
+#else
+    out << "    \"compiler\": \"unknown\",\n";
+#endif
+#ifdef TG_ENABLE_SIMD
+    out << "    \"tg_enable_simd\": true,\n";
+#else
+    out << "    \"tg_enable_simd\": false,\n";
+#endif
+    out << "    \"seed\": " << tgbench::seed << "\n";
+    out << "  },\n";
+    out << "  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        auto const& r = results[i];
+        out << "    {\"name\": \"" << json_escape(r.name) << "\", \"iterations\": " << r.iterations << ", \"ns_per_op\": " << r.ns_per_op
+            << ", \"items_per_second\": " << r.items_per_second << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+    return bool(out);
+}
+
+/// reads name -> ns_per_op from a file written by write_json
+/// (not a general JSON parser, only understands the "benchmarks" entries)
+bool read_json(char const* filename, std::map<std::string, double>& ns_per_op)
+{
+    std::ifstream in(filename);
+    if (!in)
+        return false;
+
+    std::stringstream ss;
+    ss << in.rdbuf();
+    auto const text = ss.str();
+
+    auto const read_string = [&](std::size_t p, std::string& s) {
+        s.clear();
+        for (; p < text.size() && text[p] != '"'; ++p)
+        {
+            if (text[p] == '\\' && p + 1 < text.size())
+                ++p;
+            s += text[p];
+        }
+    };
+
+    std::size_t p = text.find("\"benchmarks\"");
+    while (p != std::string::npos)
+    {
+        p = text.find("\"name\"", p);
+        if (p == std::string::npos)
+            break;
+        p = text.find('"', text.find(':', p));
+        std::string name;
+        read_string(p + 1, name);
+
+        p = text.find("\"ns_per_op\"", p);
+        if (p == std::string::npos)
+            break;
+        ns_per_op[name] = std::strtod(text.c_str() + text.find(':', p) + 1, nullptr);
+    }
+    return true;
+}
+}
+
+int main(int argc, char** argv)
+{
+    char const* filter = nullptr;
+    char const* json_file = nullptr;
+    char const* compare_file = nullptr;
+    double min_time = 0.2;
+    double threshold = 0.1;
+    int repetitions = 3;
+    bool list = false;
+
+    for (auto i = 1; i < argc; ++i)
+    {
+        auto const arg = argv[i];
+        auto const has_value = i + 1 < argc;
+        if (std::strcmp(arg, "--filter") == 0 && has_value)
+            filter = argv[++i];
+        else if (std::strcmp(arg, "--min-time") == 0 && has_value)
+            min_time = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--repetitions") == 0 && has_value)
+            repetitions = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(arg, "--json") == 0 && has_value)
+            json_file = argv[++i];
+        else if (std::strcmp(arg, "--compare") == 0 && has_value)
+            compare_file = argv[++i];
+        else if (std::strcmp(arg, "--threshold") == 0 && has_value)
+            threshold = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--list") == 0)
+            list = true;
+        else
+        {
+            std::fprintf(stderr, "unknown or incomplete argument '%s'\n", arg);
+            std::fprintf(stderr, "usage: %s [--filter s] [--min-time sec] [--repetitions n] [--json file] [--compare file] [--threshold ratio] [--list]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    auto benchmarks = tgbench::registry();
+    std::sort(benchmarks.begin(), benchmarks.end(), [](auto const& a, auto const& b) { return a.name < b.name; });
+
+    std::map<std::string, double> baseline;
+    if (compare_file && !read_json(compare_file, baseline))
+    {
+        std::fprintf(stderr, "could not read '%s'\n", compare_file);
+        return 2;
+    }
+
+    std::vector<result> results;
+    auto regressions = 0;
+
+    if (!list)
+    {
+        std::printf("%-50s %14s %14s %16s", "benchmark", "iterations", "ns/op", "items/s");
+        if (compare_file)
+            std::printf(" %12s", "vs baseline");
+        std::printf("\n");
+    }
+
+    for (auto const& b : benchmarks)
+    {
+        if (filter && b.name.find(filter) == std::string::npos)
+            continue;
+
+        if (list)
+        {
+            std::printf("%s\n", b.name.c_str());
+            continue;
+        }
+
+        auto const r = run(b, min_time * 1e9, repetitions);
+        results.push_back(r);
+
+        std::printf("%-50s %14zu %14.3f %16.4g", r.name.c_str(), r.iterations, r.ns_per_op, r.items_per_second);
+        if (compare_file)
+        {
+            auto const it = baseline.find(r.name);
+            if (it == baseline.end() || it->second <= 0)
+                std::printf(" %12s", "new");
+            else
+            {
+                auto const change = r.ns_per_op / it->second - 1;
+                auto const regressed = change > threshold;
+                regressions += regressed;
+                std::printf(" %+11.1f%%%s", change * 100, regressed ? "  REGRESSION" : "");
+            }
+        }
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+
+    if (json_file && !write_json(json_file, results))
+    {
+        std::fprintf(stderr, "could not write '%s'\n", json_file);
+        return 2;
+    }
+
+    if (regressions > 0)
+    {
+        std::printf("%d benchmark(s) regressed by more than %.1f%%\n", regressions, threshold * 100);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <vector>
+
+#include <typed-geometry/feature/matrix.hh>
+#include <typed-geometry/feature/random.hh>
+
+#include "bench.hh"
+
+namespace
+{
+constexpr size_t input_count = 1024;
+
+template <class ScalarT>
+void bench_eigen_decomposition_symmetric3(tgbench::state& s)
+{
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+
+    std::vector<tg::mat<3, 3, ScalarT>> ms;
+    for (size_t i = 0; i < input_count; ++i)
+    {
+        tg::mat<3, 3, ScalarT> m;
+        for (auto c = 0; c < 3; ++c)
+            for (auto r = 0; r <= c; ++r)
+                m[c][r] = m[r][c] = uniform(rng, ScalarT(-1), ScalarT(1));
+        ms.push_back(m);
+    }
+
+    size_t i = 0;
+    while (s.keep_running())
+    {
+        tgbench::do_not_optimize(eigen_decomposition_symmetric(ms[i]));
+        i = (i + 1) % input_count;
+    }
+}
+TG_BENCHMARK_TEMPLATE(bench_eigen_decomposition_symmetric3, tg::f32);
+TG_BENCHMARK_TEMPLATE(bench_eigen_decomposition_symmetric3, tg::f64);
+
+template <class ScalarT>
+void bench_mat4_mul_mat4(tgbench::state& s)
+{
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+
+    std::vector<tg::mat<4, 4, ScalarT>> ms;
+    for (size_t i = 0; i < input_count; ++i)
+    {
+        tg::mat<4, 4, ScalarT> m;
+        for (auto c = 0; c < 4; ++c)
+            for (auto r = 0; r < 4; ++r)
+                m[c][r] = uniform(rng, ScalarT(-1), ScalarT(1));
+        ms.push_back(m);
+    }
+
+    size_t i = 0;
+    while (s.keep_running())
+    {
+        tgbench::do_not_optimize(ms[i] * ms[(i + 1) % input_count]);
+        i = (i + 1) % input_count;
+    }
+}
+TG_BENCHMARK_TEMPLATE(bench_mat4_mul_mat4, tg::f32);
+TG_BENCHMARK_TEMPLATE(bench_mat4_mul_mat4, tg::f64);
+
+template <class ScalarT>
+void bench_transform_points(tgbench::state& s)
+{
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+    auto const domain = tg::aabb<3, ScalarT>(tg::pos<3, ScalarT>(-10), tg::pos<3, ScalarT>(10));
+
+    std::vector<tg::pos<3, ScalarT>> in;
+    std::vector<tg::pos<3, ScalarT>> out(input_count);
+    for (size_t i = 0; i < input_count; ++i)
+        in.push_back(uniform(rng, domain));
+
+    auto const m = tg::translation(tg::vec<3, ScalarT>(1, 2, 3)) * tg::rotation_y(tg::angle_t<ScalarT>::from_degree(ScalarT(30)));
+
+    s.set_items_per_iteration(input_count);
+    while (s.keep_running())
+    {
+        tg::transform_points(m, in, out);
+        tgbench::do_not_optimize(out.data());
+    }
+}
+TG_BENCHMARK_TEMPLATE(bench_transform_points, tg::f32);
+TG_BENCHMARK_TEMPLATE(bench_transform_points, tg::f64);
+}
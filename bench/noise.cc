@@ -0,0 +1,45 @@
+#include <vector>
+
+#include <typed-geometry/feature/noise.hh>
+#include <typed-geometry/tg.hh>
+
+#include "bench.hh"
+
+namespace
+{
+constexpr size_t input_count = 1024;
+
+template <class ScalarT, int D>
+void bench_perlin_noise(tgbench::state& s)
+{
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+    auto const domain = tg::aabb<D, ScalarT>(tg::pos<D, ScalarT>(-100), tg::pos<D, ScalarT>(100));
+
+    std::vector<tg::pos<D, ScalarT>> ps;
+    for (size_t i = 0; i < input_count; ++i)
+        ps.push_back(uniform(rng, domain));
+
+    size_t i = 0;
+    while (s.keep_running())
+    {
+        tgbench::do_not_optimize(tg::perlin_noise(ps[i]));
+        i = (i + 1) % input_count;
+    }
+}
+
+template <class ScalarT>
+void bench_perlin_noise2(tgbench::state& s)
+{
+    bench_perlin_noise<ScalarT, 2>(s);
+}
+template <class ScalarT>
+void bench_perlin_noise3(tgbench::state& s)
+{
+    bench_perlin_noise<ScalarT, 3>(s);
+}
+TG_BENCHMARK_TEMPLATE(bench_perlin_noise2, tg::f32);
+TG_BENCHMARK_TEMPLATE(bench_perlin_noise2, tg::f64);
+TG_BENCHMARK_TEMPLATE(bench_perlin_noise3, tg::f32);
+TG_BENCHMARK_TEMPLATE(bench_perlin_noise3, tg::f64);
+}
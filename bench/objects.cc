@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <vector>
+
+#include <typed-geometry/feature/objects.hh>
+#include <typed-geometry/feature/random.hh>
+
+#include "bench.hh"
+
+namespace
+{
+constexpr size_t input_count = 1024; // power of two, fits in L1/L2
+
+template <class ScalarT>
+void bench_intersects_triangle3_aabb3(tgbench::state& s)
+{
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+    auto const domain = tg::aabb<3, ScalarT>(tg::pos<3, ScalarT>(-10), tg::pos<3, ScalarT>(10));
+
+    std::vector<tg::triangle<3, ScalarT>> tris;
+    std::vector<tg::aabb<3, ScalarT>> boxes;
+    for (size_t i = 0; i < input_count; ++i)
+    {
+        tris.emplace_back(uniform(rng, domain), uniform(rng, domain), uniform(rng, domain));
+        auto const c = uniform(rng, domain);
+        auto const e = tg::vec<3, ScalarT>(uniform(rng, ScalarT(0.1), ScalarT(4)), uniform(rng, ScalarT(0.1), ScalarT(4)), uniform(rng, ScalarT(0.1), ScalarT(4)));
+        boxes.emplace_back(c - e, c + e);
+    }
+
+    size_t i = 0;
+    while (s.keep_running())
+    {
+        tgbench::do_not_optimize(intersects(tris[i], boxes[i]));
+        i = (i + 1) % input_count;
+    }
+}
+TG_BENCHMARK_TEMPLATE(bench_intersects_triangle3_aabb3, tg::f32);
+TG_BENCHMARK_TEMPLATE(bench_intersects_triangle3_aabb3, tg::f64);
+
+void bench_rasterize_depth(tgbench::state& s)
+{
+    // occluder-sized triangles on a 256x256 depth buffer
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+    auto const screen = tg::aabb2(tg::pos2(0), tg::pos2(256));
+
+    std::vector<tg::triangle4> tris;
+    for (size_t i = 0; i < input_count; ++i)
+    {
+        auto const c = uniform(rng, screen);
+        auto const v = [&] {
+            auto const p = c + tg::vec2(uniform(rng, -24.f, 24.f), uniform(rng, -24.f, 24.f));
+            return tg::pos4(p.x, p.y, uniform(rng, 0.f, 1.f), uniform(rng, 1.f, 10.f));
+        };
+        tris.emplace_back(v(), v(), v());
+    }
+
+    std::vector<float> depth(256 * 256);
+    s.set_items_per_iteration(tris.size());
+    while (s.keep_running())
+    {
+        std::fill(depth.begin(), depth.end(), 1.f);
+        tg::rasterize_depth(tris, depth, tg::isize2(256, 256));
+        tgbench::do_not_optimize(depth.data());
+    }
+}
+TG_BENCHMARK(bench_rasterize_depth);
+
+template <bool Spans>
+void bench_rasterize_triangle_mask(tgbench::state& s)
+{
+    // filling a 256x256 byte mask per pixel vs. per span
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+    auto const screen = tg::aabb2(tg::pos2(0), tg::pos2(255));
+
+    std::vector<tg::triangle2> tris;
+    for (size_t i = 0; i < input_count; ++i)
+        tris.emplace_back(uniform(rng, screen), uniform(rng, screen), uniform(rng, screen));
+
+    std::vector<tg::u8> mask(256 * 256);
+    size_t i = 0;
+    while (s.keep_running())
+    {
+        if constexpr (Spans)
+            tg::rasterize_spans(tris[i], [&](int y, int x_begin, int x_end, float, float, float, float) {
+                std::fill(mask.begin() + (y * 256 + x_begin), mask.begin() + (y * 256 + x_end), tg::u8(255));
+            });
+        else
+            tg::rasterize(tris[i], [&](tg::ipos2 p, float, float) { mask[p.y * 256 + p.x] = 255; });
+        tgbench::do_not_optimize(mask.data());
+        i = (i + 1) % input_count;
+    }
+}
+TG_BENCHMARK_TEMPLATE(bench_rasterize_triangle_mask, false);
+TG_BENCHMARK_TEMPLATE(bench_rasterize_triangle_mask, true);
+
+void bench_rasterize_coverage(tgbench::state& s)
+{
+    // random 16-gons on a 256x256 tile
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+
+    std::vector<tg::pos2> polys;
+    for (size_t i = 0; i < input_count * 16; ++i)
+        polys.push_back(uniform(rng, tg::aabb2(tg::pos2(-16), tg::pos2(272))));
+
+    tg::coverage_buffer buffer(tg::isize2(256, 256));
+    std::vector<tg::u8> coverage(256 * 256);
+    size_t i = 0;
+    while (s.keep_running())
+    {
+        buffer.clear();
+        buffer.add_polygon(tg::span<tg::pos2 const>(polys.data() + i * 16, 16));
+        buffer.resolve(coverage);
+        tgbench::do_not_optimize(coverage.data());
+        i = (i + 1) % input_count;
+    }
+}
+TG_BENCHMARK(bench_rasterize_coverage);
+
+template <bool Indexed>
+void bench_contains_polygon(tgbench::state& s)
+{
+    // point queries against a 1024-gon, with and without slab index
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+
+    tg::polygon2 poly;
+    for (auto i = 0; i < 1024; ++i)
+    {
+        auto const a = tg::degree(360.f * float(i) / 1024);
+        poly.vertices.push_back(tg::pos2::zero + tg::vec2(tg::cos(a), tg::sin(a)) * uniform(rng, 0.5f, 1.f));
+    }
+    if constexpr (Indexed)
+        poly.build_slab_index();
+
+    std::vector<tg::pos2> queries;
+    for (size_t i = 0; i < input_count; ++i)
+        queries.push_back(uniform(rng, tg::aabb2(tg::pos2(-1), tg::pos2(1))));
+
+    size_t i = 0;
+    while (s.keep_running())
+    {
+        tgbench::do_not_optimize(contains(poly, queries[i]));
+        i = (i + 1) % input_count;
+    }
+}
+TG_BENCHMARK_TEMPLATE(bench_contains_polygon, false);
+TG_BENCHMARK_TEMPLATE(bench_contains_polygon, true);
+
+void bench_traverse_grid(tgbench::state& s)
+{
+    // random rays through a 128^3 grid
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+    auto const grid = tg::aabb3(-1, 1);
+
+    std::vector<tg::ray3> rays;
+    for (size_t i = 0; i < input_count; ++i)
+        rays.emplace_back(uniform(rng, tg::aabb3(-2, 2)), tg::uniform<tg::dir3>(rng));
+
+    size_t i = 0;
+    while (s.keep_running())
+    {
+        auto cells = 0;
+        tg::traverse_grid(rays[i], grid, tg::isize3(128, 128, 128), [&](tg::ipos3, float, float) { ++cells; });
+        tgbench::do_not_optimize(cells);
+        i = (i + 1) % input_count;
+    }
+}
+TG_BENCHMARK(bench_traverse_grid);
+
+void bench_voxelize(tgbench::state& s)
+{
+    // random spheres in a 256^3 grid
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+    auto const grid = tg::aabb3(-1, 1);
+
+    std::vector<tg::sphere3> spheres;
+    for (size_t i = 0; i < input_count; ++i)
+        spheres.emplace_back(uniform(rng, tg::aabb3(-1, 1)), uniform(rng, 0.05f, 0.5f));
+
+    size_t i = 0;
+    while (s.keep_running())
+    {
+        auto voxels = 0;
+        tg::voxelize(spheres[i], grid, tg::isize3(256, 256, 256), [&](tg::ipos3 b, tg::ipos3 e) { voxels += (e.x - b.x) * (e.y - b.y) * (e.z - b.z); });
+        tgbench::do_not_optimize(voxels);
+        i = (i + 1) % input_count;
+    }
+}
+TG_BENCHMARK(bench_voxelize);
+}
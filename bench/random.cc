@@ -0,0 +1,33 @@
+#include <typed-geometry/feature/objects.hh>
+#include <typed-geometry/feature/random.hh>
+
+#include "bench.hh"
+
+namespace
+{
+template <class ScalarT>
+void bench_uniform_sphere3(tgbench::state& s)
+{
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+    auto const sphere = tg::sphere<3, ScalarT>(tg::pos<3, ScalarT>(1, 2, 3), ScalarT(2));
+
+    while (s.keep_running())
+        tgbench::do_not_optimize(uniform(rng, sphere));
+}
+TG_BENCHMARK_TEMPLATE(bench_uniform_sphere3, tg::f32);
+TG_BENCHMARK_TEMPLATE(bench_uniform_sphere3, tg::f64);
+
+template <class ScalarT>
+void bench_uniform_sphere_boundary3(tgbench::state& s)
+{
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+    auto const sphere = tg::sphere_boundary<3, ScalarT>(tg::pos<3, ScalarT>(1, 2, 3), ScalarT(2));
+
+    while (s.keep_running())
+        tgbench::do_not_optimize(uniform(rng, sphere));
+}
+TG_BENCHMARK_TEMPLATE(bench_uniform_sphere_boundary3, tg::f32);
+TG_BENCHMARK_TEMPLATE(bench_uniform_sphere_boundary3, tg::f64);
+}
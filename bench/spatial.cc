@@ -0,0 +1,231 @@
+#include <typed-geometry/feature/random.hh>
+#include <typed-geometry/feature/spatial.hh>
+
+#include <vector>
+
+#include "bench.hh"
+
+namespace
+{
+template <class ScalarT>
+std::vector<tg::pos<3, ScalarT>> random_points(tg::rng& rng, size_t count)
+{
+    auto const range = tg::aabb<3, ScalarT>(ScalarT(-100), ScalarT(100));
+    std::vector<tg::pos<3, ScalarT>> pts;
+    pts.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        pts.push_back(uniform(rng, range));
+    return pts;
+}
+
+template <class ScalarT>
+void bench_dynamic_aabb_tree_update(tgbench::state& s)
+{
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+    auto const centers = random_points<ScalarT>(rng, 1 << 16);
+    auto const e = tg::vec<3, ScalarT>(ScalarT(0.5));
+
+    tg::dynamic_aabb_tree<3, ScalarT> tree(ScalarT(0.2));
+    std::vector<tg::u32> ids;
+    for (auto const& c : centers)
+        ids.push_back(tree.insert(tg::aabb<3, ScalarT>(c - e, c + e)));
+    tree.update_pairs([](tg::u32, tg::u32) {});
+
+    // every object moves a bit per frame, some leave their fat bounds
+    std::vector<tg::vec<3, ScalarT>> velocities;
+    for (size_t i = 0; i < centers.size(); ++i)
+        velocities.push_back(uniform_vec(rng, tg::aabb<3, ScalarT>(ScalarT(-0.1), ScalarT(0.1))));
+
+    auto pos = centers;
+    size_t pairs = 0;
+    s.set_items_per_iteration(centers.size());
+    while (s.keep_running())
+    {
+        for (size_t i = 0; i < pos.size(); ++i)
+        {
+            pos[i] += velocities[i];
+            tree.move(ids[i], tg::aabb<3, ScalarT>(pos[i] - e, pos[i] + e), velocities[i]);
+        }
+        tree.update_pairs([&pairs](tg::u32, tg::u32) { ++pairs; });
+        tgbench::do_not_optimize(pairs);
+    }
+}
+TG_BENCHMARK_TEMPLATE(bench_dynamic_aabb_tree_update, tg::f32);
+
+template <class ScalarT>
+void bench_sweep_and_prune_update(tgbench::state& s)
+{
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+    auto const centers = random_points<ScalarT>(rng, 1 << 16);
+    auto const e = tg::vec<3, ScalarT>(ScalarT(0.5));
+
+    std::vector<tg::aabb<3, ScalarT>> boxes;
+    std::vector<tg::vec<3, ScalarT>> velocities;
+    for (auto const& c : centers)
+    {
+        boxes.push_back({c - e, c + e});
+        velocities.push_back(uniform_vec(rng, tg::aabb<3, ScalarT>(ScalarT(-0.1), ScalarT(0.1))));
+    }
+
+    tg::sweep_and_prune<3, ScalarT> sap;
+    sap.update(boxes);
+
+    s.set_items_per_iteration(boxes.size());
+    while (s.keep_running())
+    {
+        for (size_t i = 0; i < boxes.size(); ++i)
+            boxes[i] = {boxes[i].min + velocities[i], boxes[i].max + velocities[i]};
+        sap.update(boxes);
+        tgbench::do_not_optimize(sap.find_pairs_parallel().size());
+    }
+}
+TG_BENCHMARK_TEMPLATE(bench_sweep_and_prune_update, tg::f32);
+
+template <class ScalarT>
+void bench_mesh_distance_signed_batch(tgbench::state& s)
+{
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+
+    // 128 x 128 height field (open, but signed queries still exercise all pseudo-normals)
+    auto const res = 128;
+    std::vector<tg::pos<3, ScalarT>> vertices;
+    std::vector<tg::u32> indices;
+    for (auto y = 0; y <= res; ++y)
+        for (auto x = 0; x <= res; ++x)
+            vertices.push_back({ScalarT(x), ScalarT(y), uniform(rng, ScalarT(-1), ScalarT(1))});
+    for (auto y = 0; y < res; ++y)
+        for (auto x = 0; x < res; ++x)
+        {
+            auto const i = tg::u32(y * (res + 1) + x);
+            auto const j = i + tg::u32(res + 1);
+            indices.insert(indices.end(), {i, i + 1, j + 1, i, j + 1, j});
+        }
+
+    auto const md = tg::mesh_distance<ScalarT>(vertices, indices);
+    std::vector<tg::pos<3, ScalarT>> queries;
+    for (auto i = 0; i < (1 << 14); ++i)
+        queries.push_back(uniform(rng, tg::aabb<3, ScalarT>({0, 0, -10}, {ScalarT(res), ScalarT(res), 10})));
+    std::vector<ScalarT> out(queries.size());
+
+    s.set_items_per_iteration(queries.size());
+    while (s.keep_running())
+    {
+        md.signed_distance_batch(queries, out);
+        tgbench::do_not_optimize(out.data());
+    }
+}
+TG_BENCHMARK_TEMPLATE(bench_mesh_distance_signed_batch, tg::f32);
+
+void bench_bake_sdf(tgbench::state& s)
+{
+    // closed box mesh, 128^3 grid
+    std::vector<tg::pos3> vertices;
+    for (auto i = 0; i < 8; ++i)
+        vertices.push_back({i & 1 ? 1.f : -1.f, i & 2 ? 1.f : -1.f, i & 4 ? 1.f : -1.f});
+    std::vector<tg::u32> const indices = {0, 4, 6, 0, 6, 2, 1, 3, 7, 1, 7, 5, 0, 1, 5, 0, 5, 4, 2, 6, 7, 2, 7, 3, 0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6};
+    auto const md = tg::mesh_distance<float>(vertices, indices);
+
+    s.set_items_per_iteration(128 * 128 * 128);
+    while (s.keep_running())
+        tgbench::do_not_optimize(tg::bake_sdf(md, tg::aabb3(-2, 2), 4.f / 128).values.data());
+}
+TG_BENCHMARK(bench_bake_sdf);
+
+void bench_voxelize_surface(tgbench::state& s)
+{
+    // soup of small triangles in a 128^3 grid
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+    auto const domain = tg::aabb3(-1, 1);
+
+    std::vector<tg::triangle3> tris;
+    for (auto i = 0; i < 20000; ++i)
+    {
+        auto const c = uniform(rng, domain);
+        auto const v = [&] { return c + tg::vec3(uniform(rng, -0.05f, 0.05f), uniform(rng, -0.05f, 0.05f), uniform(rng, -0.05f, 0.05f)); };
+        tris.emplace_back(v(), v(), v());
+    }
+
+    s.set_items_per_iteration(tris.size());
+    while (s.keep_running())
+        tgbench::do_not_optimize(tg::voxelize_surface<float>(tris, domain, 2.f / 128).bits.data());
+}
+TG_BENCHMARK(bench_voxelize_surface);
+
+template <class ScalarT>
+void bench_kdtree_nearest(tgbench::state& s)
+{
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+    auto const pts = random_points<ScalarT>(rng, 100000);
+    auto const tree = tg::kdtree<3, ScalarT>(pts);
+    auto const queries = random_points<ScalarT>(rng, 1024);
+
+    size_t i = 0;
+    while (s.keep_running())
+        tgbench::do_not_optimize(tree.nearest(queries[i++ % queries.size()]));
+}
+TG_BENCHMARK_TEMPLATE(bench_kdtree_nearest, tg::f32);
+TG_BENCHMARK_TEMPLATE(bench_kdtree_nearest, tg::f64);
+
+template <class ScalarT>
+void bench_kdtree_knn_batch(tgbench::state& s)
+{
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+    auto const pts = random_points<ScalarT>(rng, 100000);
+    auto const tree = tg::kdtree<3, ScalarT>(pts);
+    auto const queries = random_points<ScalarT>(rng, 1 << 14);
+    auto const k = size_t(8);
+    std::vector<tg::kdtree_neighbor<ScalarT>> out(queries.size() * k);
+
+    s.set_items_per_iteration(queries.size());
+    while (s.keep_running())
+    {
+        tree.knn_batch(queries, k, out);
+        tgbench::do_not_optimize(out.data());
+    }
+}
+TG_BENCHMARK_TEMPLATE(bench_kdtree_knn_batch, tg::f32);
+TG_BENCHMARK_TEMPLATE(bench_kdtree_knn_batch, tg::f64);
+
+template <class ScalarT>
+void bench_spatial_hash_build(tgbench::state& s)
+{
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+    auto const pts = random_points<ScalarT>(rng, 1 << 18);
+    tg::spatial_hash<ScalarT> grid;
+
+    s.set_items_per_iteration(pts.size());
+    while (s.keep_running())
+    {
+        grid.build(pts, ScalarT(2));
+        tgbench::do_not_optimize(grid.indices().data());
+    }
+}
+TG_BENCHMARK_TEMPLATE(bench_spatial_hash_build, tg::f32);
+TG_BENCHMARK_TEMPLATE(bench_spatial_hash_build, tg::f64);
+
+template <class ScalarT>
+void bench_spatial_hash_neighbors(tgbench::state& s)
+{
+    tg::rng rng;
+    rng.seed(tgbench::seed);
+    auto const pts = random_points<ScalarT>(rng, 1 << 18);
+    auto const grid = tg::spatial_hash<ScalarT>(pts, ScalarT(2));
+    std::vector<int> counts(pts.size());
+
+    s.set_items_per_iteration(pts.size());
+    while (s.keep_running())
+    {
+        grid.for_each_neighbor(ScalarT(2), [&](tg::u32 i, tg::u32, ScalarT) { ++counts[i]; });
+        tgbench::do_not_optimize(counts.data());
+    }
+}
+TG_BENCHMARK_TEMPLATE(bench_spatial_hash_neighbors, tg::f32);
+TG_BENCHMARK_TEMPLATE(bench_spatial_hash_neighbors, tg::f64);
+}
@@ -0,0 +1,8 @@
+#include <smmintrin.h>
+
+int main()
+{
+    __m128 a = _mm_set1_ps(1.0f);
+    __m128 b = _mm_dp_ps(a, a, 0xFF);
+    return int(_mm_cvtss_f32(b));
+}
@@ -4,6 +4,10 @@
 #include <typed-geometry/types/mat.hh>
 #include <typed-geometry/types/pos.hh>
 
+#ifdef TG_ENABLE_SIMD
+#include <typed-geometry/detail/simd.hh>
+#endif
+
 /*
  * Supported operations:
  *   mat * vec (of same dimension)
@@ -43,6 +47,15 @@ template <int C, class ScalarT>
 template <int C, class ScalarT>
 [[nodiscard]] constexpr vec<4, ScalarT> operator*(mat<C, 4, ScalarT> const& m, vec<C, ScalarT> const& v)
 {
+#ifdef TG_SIMD_BACKEND
+    if constexpr (C == 4 && std::is_same_v<ScalarT, f32>)
+        if (!TG_IS_CONSTANT_EVALUATED())
+        {
+            vec<4, f32> r;
+            detail::simd_mat4_mul_vec4(&m[0].x, &v.x, &r.x);
+            return r;
+        }
+#endif
     return {dot(m.row(0), v), dot(m.row(1), v), dot(m.row(2), v), dot(m.row(3), v)};
 }
 
@@ -107,6 +120,14 @@ template <int A, int B, class ScalarT>
 [[nodiscard]] constexpr mat<4, A, ScalarT> operator*(mat<B, A, ScalarT> const& a, mat<4, B, ScalarT> const& b)
 {
     mat<4, A, ScalarT> m;
+#ifdef TG_SIMD_BACKEND
+    if constexpr (A == 4 && B == 4 && std::is_same_v<ScalarT, f32>)
+        if (!TG_IS_CONSTANT_EVALUATED())
+        {
+            detail::simd_mat4_mul_mat4(&a[0].x, &b[0].x, &m[0].x);
+            return m;
+        }
+#endif
     m[0] = a * b[0];
     m[1] = a * b[1];
     m[2] = a * b[2];
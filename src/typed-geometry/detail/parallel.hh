@@ -0,0 +1,104 @@
+#pragma once
+
+#include <thread>
+
+#include <clean-core/vector.hh>
+
+#include <typed-geometry/detail/utility.hh>
+
+// minimal fork-join helper for the data-parallel builders in functions/spatial
+// NOTE: spawns threads per call, so only use it for coarse-grained work (e.g. >= 10k items)
+
+namespace tg::detail
+{
+/// joins the thread on destruction, so that an exception on the calling thread does not hit a joinable std::thread
+struct joining_thread
+{
+    std::thread thread;
+
+    template <class F>
+    explicit joining_thread(F&& f) : thread(static_cast<F&&>(f))
+    {
+    }
+    joining_thread(joining_thread&&) = default;
+    joining_thread& operator=(joining_thread&&) = delete;
+    ~joining_thread()
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+};
+
+/// number of worker threads used by parallel_for (at least 1)
+inline int parallel_thread_count()
+{
+    auto const c = int(std::thread::hardware_concurrency());
+    return c < 1 ? 1 : c;
+}
+
+/// calls f(begin, end) for disjoint chunks covering [0, count)
+/// runs serially if count < min_chunk_size * 2 or only one thread is available
+template <class F>
+void parallel_for_chunks(size_t count, F&& f, size_t min_chunk_size = 4096)
+{
+    if (count == 0)
+        return;
+
+    auto threads = size_t(parallel_thread_count());
+    if (min_chunk_size < 1)
+        min_chunk_size = 1;
+    if (threads > count / min_chunk_size)
+        threads = count / min_chunk_size;
+
+    if (threads <= 1)
+    {
+        f(size_t(0), count);
+        return;
+    }
+
+    auto const chunk = (count + threads - 1) / threads;
+
+    // joined on scope exit, also if the calling thread's chunk throws
+    cc::vector<joining_thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t t = 1; t < threads; ++t)
+    {
+        auto const b = t * chunk;
+        auto const e = b + chunk < count ? b + chunk : count;
+        if (b >= e)
+            break;
+        workers.emplace_back([&f, b, e] { f(b, e); });
+    }
+
+    // calling thread does the first chunk
+    f(size_t(0), chunk < count ? chunk : count);
+}
+
+/// calls f(i) for every i in [0, count), potentially in parallel
+template <class F>
+void parallel_for(size_t count, F&& f, size_t min_chunk_size = 4096)
+{
+    parallel_for_chunks(
+        count,
+        [&f](size_t b, size_t e) {
+            for (auto i = b; i < e; ++i)
+                f(i);
+        },
+        min_chunk_size);
+}
+
+/// calls f() and g(), in parallel if run_parallel is true (f on a new thread, g on the calling thread)
+template <class F, class G>
+void parallel_invoke(F&& f, G&& g, bool run_parallel = true)
+{
+    if (!run_parallel || parallel_thread_count() <= 1)
+    {
+        f();
+        g();
+        return;
+    }
+
+    joining_thread worker([&f] { f(); });
+    g();
+}
+}
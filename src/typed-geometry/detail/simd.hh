@@ -0,0 +1,241 @@
+#pragma once
+
+#include <cstring> // std::memcpy
+
+#include <typed-geometry/detail/macros.hh>
+#include <typed-geometry/types/scalars/default.hh>
+
+// thin wrappers around x86 SIMD registers for the batched kernels (e.g. contains_batch)
+//
+// detail::simd_f32 is the widest available float lane type:
+//   - f32x8 (AVX2) if compiled with -mavx2 (or /arch:AVX2)
+//   - f32x4 (SSE4.1) if compiled with -msse4.1 (or /arch:AVX)
+//   - otherwise TG_SIMD_F32_WIDTH is not defined and callers use their scalar path
+//
+// the wrappers only provide the operations that map 1:1 to single instructions
+// (no FMA contraction), so results are bit-identical to the scalar expressions they mirror
+//
+// if TG_ENABLE_SIMD is defined (see CMake option of the same name, which also adds -msse4.1),
+// TG_SIMD_BACKEND is defined and some f32 vec/mat operators use the f32x4 kernels below at runtime
+// (constant evaluation always takes the scalar path)
+// it is an error to define TG_ENABLE_SIMD without SSE4.1 code generation
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TG_SIMD_F32_WIDTH 8
+#elif defined(__SSE4_1__) || defined(__AVX__)
+#include <smmintrin.h>
+#define TG_SIMD_F32_WIDTH 4
+#endif
+
+#if defined(TG_COMPILER_MSVC)
+#if _MSC_VER >= 1925
+#define TG_HAS_IS_CONSTANT_EVALUATED
+#endif
+#elif defined(TG_COMPILER_CLANG)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define TG_HAS_IS_CONSTANT_EVALUATED
+#endif
+#elif defined(TG_COMPILER_GCC)
+#if __GNUC__ >= 9
+#define TG_HAS_IS_CONSTANT_EVALUATED
+#endif
+#endif
+
+#if defined(TG_ENABLE_SIMD)
+#if !defined(TG_SIMD_F32_WIDTH)
+#error "TG_ENABLE_SIMD requires SSE4.1 code generation (compile with -msse4.1 or /arch:AVX)"
+#elif !defined(TG_HAS_IS_CONSTANT_EVALUATED)
+#error "TG_ENABLE_SIMD requires __builtin_is_constant_evaluated (GCC 9, Clang 9 or MSVC 19.25)"
+#endif
+#define TG_SIMD_BACKEND
+#define TG_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+namespace tg::detail
+{
+#if defined(__AVX2__)
+
+struct f32x8
+{
+    static constexpr int width = 8;
+    __m256 v;
+
+    static f32x8 load(f32 const* p) { return {_mm256_loadu_ps(p)}; }
+    static f32x8 broadcast(f32 s) { return {_mm256_set1_ps(s)}; }
+    static f32x8 zero() { return {_mm256_setzero_ps()}; }
+    static f32x8 all_set() { return {_mm256_castsi256_ps(_mm256_set1_epi32(-1))}; }
+
+    void store(f32* p) const { _mm256_storeu_ps(p, v); }
+
+    /// bit i is set iff lane i of the mask is set
+    int movemask() const { return _mm256_movemask_ps(v); }
+};
+
+inline f32x8 operator+(f32x8 a, f32x8 b) { return {_mm256_add_ps(a.v, b.v)}; }
+inline f32x8 operator-(f32x8 a, f32x8 b) { return {_mm256_sub_ps(a.v, b.v)}; }
+inline f32x8 operator*(f32x8 a, f32x8 b) { return {_mm256_mul_ps(a.v, b.v)}; }
+inline f32x8 operator/(f32x8 a, f32x8 b) { return {_mm256_div_ps(a.v, b.v)}; }
+
+// comparisons return lane masks (all bits set or all bits cleared)
+inline f32x8 operator<(f32x8 a, f32x8 b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+inline f32x8 operator<=(f32x8 a, f32x8 b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ)}; }
+inline f32x8 operator>(f32x8 a, f32x8 b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)}; }
+inline f32x8 operator>=(f32x8 a, f32x8 b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)}; }
+
+inline f32x8 operator&(f32x8 a, f32x8 b) { return {_mm256_and_ps(a.v, b.v)}; }
+inline f32x8 operator|(f32x8 a, f32x8 b) { return {_mm256_or_ps(a.v, b.v)}; }
+/// a & ~b
+inline f32x8 and_not(f32x8 a, f32x8 b) { return {_mm256_andnot_ps(b.v, a.v)}; }
+
+inline f32x8 simd_min(f32x8 a, f32x8 b) { return {_mm256_min_ps(a.v, b.v)}; }
+inline f32x8 simd_max(f32x8 a, f32x8 b) { return {_mm256_max_ps(a.v, b.v)}; }
+inline f32x8 simd_abs(f32x8 a) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)}; }
+inline f32x8 simd_sqrt(f32x8 a) { return {_mm256_sqrt_ps(a.v)}; }
+inline f32x8 simd_floor(f32x8 a) { return {_mm256_floor_ps(a.v)}; }
+
+#endif
+
+#ifdef TG_SIMD_F32_WIDTH
+
+struct f32x4
+{
+    static constexpr int width = 4;
+    __m128 v;
+
+    static f32x4 load(f32 const* p) { return {_mm_loadu_ps(p)}; }
+    static f32x4 broadcast(f32 s) { return {_mm_set1_ps(s)}; }
+    static f32x4 zero() { return {_mm_setzero_ps()}; }
+    static f32x4 all_set() { return {_mm_castsi128_ps(_mm_set1_epi32(-1))}; }
+
+    void store(f32* p) const { _mm_storeu_ps(p, v); }
+
+    /// bit i is set iff lane i of the mask is set
+    int movemask() const { return _mm_movemask_ps(v); }
+};
+
+inline f32x4 operator+(f32x4 a, f32x4 b) { return {_mm_add_ps(a.v, b.v)}; }
+inline f32x4 operator-(f32x4 a, f32x4 b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline f32x4 operator*(f32x4 a, f32x4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline f32x4 operator/(f32x4 a, f32x4 b) { return {_mm_div_ps(a.v, b.v)}; }
+
+// comparisons return lane masks (all bits set or all bits cleared)
+inline f32x4 operator<(f32x4 a, f32x4 b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+inline f32x4 operator<=(f32x4 a, f32x4 b) { return {_mm_cmple_ps(a.v, b.v)}; }
+inline f32x4 operator>(f32x4 a, f32x4 b) { return {_mm_cmpgt_ps(a.v, b.v)}; }
+inline f32x4 operator>=(f32x4 a, f32x4 b) { return {_mm_cmpge_ps(a.v, b.v)}; }
+
+inline f32x4 operator&(f32x4 a, f32x4 b) { return {_mm_and_ps(a.v, b.v)}; }
+inline f32x4 operator|(f32x4 a, f32x4 b) { return {_mm_or_ps(a.v, b.v)}; }
+/// a & ~b
+inline f32x4 and_not(f32x4 a, f32x4 b) { return {_mm_andnot_ps(b.v, a.v)}; }
+
+inline f32x4 simd_min(f32x4 a, f32x4 b) { return {_mm_min_ps(a.v, b.v)}; }
+inline f32x4 simd_max(f32x4 a, f32x4 b) { return {_mm_max_ps(a.v, b.v)}; }
+inline f32x4 simd_abs(f32x4 a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+inline f32x4 simd_sqrt(f32x4 a) { return {_mm_sqrt_ps(a.v)}; }
+inline f32x4 simd_floor(f32x4 a) { return {_mm_floor_ps(a.v)}; }
+
+// ======== helpers for scan kernels (e.g. rasterize_coverage), these are short instruction sequences ========
+
+/// inclusive prefix sum (a0, a0 + a1, a0 + a1 + a2, a0 + a1 + a2 + a3), summed pairwise
+inline f32x4 simd_prefix_sum(f32x4 a)
+{
+    auto const s = _mm_add_ps(a.v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(a.v), 4)));
+    return {_mm_add_ps(s, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(s), 8)))};
+}
+
+/// all lanes set to lane 3
+inline f32x4 simd_broadcast_last(f32x4 a) { return {_mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(3, 3, 3, 3))}; }
+
+/// converts the lanes to int with truncation (like int(x)), saturates them to [0, 255] and stores 4 bytes
+inline void simd_store_u8(f32x4 a, u8* p)
+{
+    auto const i = _mm_cvttps_epi32(a.v);
+    auto const b = _mm_packus_epi16(_mm_packs_epi32(i, i), _mm_setzero_si128());
+    auto const w = _mm_cvtsi128_si32(b);
+    std::memcpy(p, &w, 4);
+}
+
+#endif
+
+#ifdef TG_SIMD_BACKEND
+
+// ======== kernels for the f32 operator backend ========
+// matrices are column-major (16 contiguous floats), vec3 are 3 contiguous floats
+// mat * vec accumulates column by column, which rounds exactly like the row-dot scalar path
+// NOTE: dot of 4D vectors sums pairwise ((x + y) + (z + w)) and may differ in the last bit
+
+inline f32x4 simd_load3(f32 const* p) { return {_mm_setr_ps(p[0], p[1], p[2], 0.0f)}; }
+inline void simd_store3(f32x4 a, f32* p)
+{
+    alignas(16) f32 t[4];
+    _mm_store_ps(t, a.v);
+    p[0] = t[0];
+    p[1] = t[1];
+    p[2] = t[2];
+}
+
+inline void simd_mat4_mul_vec4(f32 const* m, f32 const* v, f32* out)
+{
+    auto r = f32x4::load(m) * f32x4::broadcast(v[0]);
+    r = r + f32x4::load(m + 4) * f32x4::broadcast(v[1]);
+    r = r + f32x4::load(m + 8) * f32x4::broadcast(v[2]);
+    r = r + f32x4::load(m + 12) * f32x4::broadcast(v[3]);
+    r.store(out);
+}
+
+inline void simd_mat4_mul_mat4(f32 const* a, f32 const* b, f32* out)
+{
+    auto const c0 = f32x4::load(a);
+    auto const c1 = f32x4::load(a + 4);
+    auto const c2 = f32x4::load(a + 8);
+    auto const c3 = f32x4::load(a + 12);
+    f32x4 r[4];
+    for (auto i = 0; i < 4; ++i)
+    {
+        auto const bi = b + 4 * i;
+        r[i] = c0 * f32x4::broadcast(bi[0]);
+        r[i] = r[i] + c1 * f32x4::broadcast(bi[1]);
+        r[i] = r[i] + c2 * f32x4::broadcast(bi[2]);
+        r[i] = r[i] + c3 * f32x4::broadcast(bi[3]);
+    }
+    for (auto i = 0; i < 4; ++i)
+        r[i].store(out + 4 * i);
+}
+
+inline f32 simd_dot3(f32 const* a, f32 const* b) { return _mm_cvtss_f32(_mm_dp_ps(simd_load3(a).v, simd_load3(b).v, 0x71)); }
+inline f32 simd_dot4(f32 const* a, f32 const* b) { return _mm_cvtss_f32(_mm_dp_ps(_mm_loadu_ps(a), _mm_loadu_ps(b), 0xF1)); }
+
+inline void simd_cross3(f32 const* a, f32 const* b, f32* out)
+{
+    auto const va = simd_load3(a).v;
+    auto const vb = simd_load3(b).v;
+    auto const a_yzx = f32x4{_mm_shuffle_ps(va, va, _MM_SHUFFLE(3, 0, 2, 1))};
+    auto const a_zxy = f32x4{_mm_shuffle_ps(va, va, _MM_SHUFFLE(3, 1, 0, 2))};
+    auto const b_yzx = f32x4{_mm_shuffle_ps(vb, vb, _MM_SHUFFLE(3, 0, 2, 1))};
+    auto const b_zxy = f32x4{_mm_shuffle_ps(vb, vb, _MM_SHUFFLE(3, 1, 0, 2))};
+    simd_store3(a_yzx * b_zxy - a_zxy * b_yzx, out);
+}
+
+inline void simd_normalize3(f32 const* v, f32* out)
+{
+    auto const a = simd_load3(v).v;
+    auto const l = _mm_sqrt_ps(_mm_dp_ps(a, a, 0x7F));
+    simd_store3(f32x4{_mm_div_ps(a, l)}, out);
+}
+inline void simd_normalize4(f32 const* v, f32* out)
+{
+    auto const a = _mm_loadu_ps(v);
+    auto const l = _mm_sqrt_ps(_mm_dp_ps(a, a, 0xFF));
+    _mm_storeu_ps(out, _mm_div_ps(a, l));
+}
+
+#endif
+
+#if defined(__AVX2__)
+using simd_f32 = f32x8;
+#elif defined(TG_SIMD_F32_WIDTH)
+using simd_f32 = f32x4;
+#endif
+}
@@ -1,3 +1,5 @@
 #pragma once
 
 #include <typed-geometry/functions/objects/intersection.hh>
+#include <typed-geometry/functions/objects/intersection_packet.hh>
+#include <typed-geometry/functions/objects/ray_cast.hh>
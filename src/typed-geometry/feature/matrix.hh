@@ -18,6 +18,7 @@
 #include <typed-geometry/functions/matrix/scaling.hh>
 #include <typed-geometry/functions/matrix/submatrix.hh>
 #include <typed-geometry/functions/matrix/trace.hh>
+#include <typed-geometry/functions/matrix/transform.hh>
 #include <typed-geometry/functions/matrix/translation.hh>
 #include <typed-geometry/functions/matrix/transpose.hh>
 
@@ -11,23 +11,34 @@
 #include <typed-geometry/functions/objects/centroid.hh>
 #include <typed-geometry/functions/objects/closest_points.hh>
 #include <typed-geometry/functions/objects/contains.hh>
+#include <typed-geometry/functions/objects/contains_batch.hh>
 #include <typed-geometry/functions/objects/coordinates.hh>
 #include <typed-geometry/functions/objects/direction.hh>
 #include <typed-geometry/functions/objects/distance.hh>
 #include <typed-geometry/functions/objects/edges.hh>
 #include <typed-geometry/functions/objects/faces.hh>
 #include <typed-geometry/functions/objects/frustum.hh>
+#include <typed-geometry/functions/objects/gjk.hh>
 #include <typed-geometry/functions/objects/intersection.hh>
+#include <typed-geometry/functions/objects/intersection_batch.hh>
+#include <typed-geometry/functions/objects/intersection_packet.hh>
 #include <typed-geometry/functions/objects/normal.hh>
 #include <typed-geometry/functions/objects/perimeter.hh>
 #include <typed-geometry/functions/objects/plane.hh>
 #include <typed-geometry/functions/objects/project.hh>
 #include <typed-geometry/functions/objects/rasterize.hh>
+#include <typed-geometry/functions/objects/rasterize_coverage.hh>
+#include <typed-geometry/functions/objects/rasterize_depth.hh>
+#include <typed-geometry/functions/objects/ray_cast.hh>
+#include <typed-geometry/functions/objects/sat_cache.hh>
 #include <typed-geometry/functions/objects/segmentize.hh>
 #include <typed-geometry/functions/objects/size.hh>
+#include <typed-geometry/functions/objects/support_point.hh>
 #include <typed-geometry/functions/objects/tangent.hh>
+#include <typed-geometry/functions/objects/traverse_grid.hh>
 #include <typed-geometry/functions/objects/triangle.hh>
 #include <typed-geometry/functions/objects/triangulate.hh>
 #include <typed-geometry/functions/objects/triangulation.hh>
 #include <typed-geometry/functions/objects/vertices.hh>
 #include <typed-geometry/functions/objects/volume.hh>
+#include <typed-geometry/functions/objects/voxelize.hh>
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <typed-geometry/feature/basic.hh>
+#include <typed-geometry/feature/objects.hh>
+
+#include <typed-geometry/functions/spatial/bvh.hh>
+#include <typed-geometry/functions/spatial/dynamic_aabb_tree.hh>
+#include <typed-geometry/functions/spatial/kdtree.hh>
+#include <typed-geometry/functions/spatial/lbvh.hh>
+#include <typed-geometry/functions/spatial/mesh_distance.hh>
+#include <typed-geometry/functions/spatial/sdf_grid.hh>
+#include <typed-geometry/functions/spatial/spatial_hash.hh>
+#include <typed-geometry/functions/spatial/sweep_and_prune.hh>
+#include <typed-geometry/functions/spatial/voxelize_mesh.hh>
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <typed-geometry/feature/matrix.hh>
+#include <typed-geometry/feature/quat.hh>
+
+#include <typed-geometry/functions/transform/affine.hh>
+#include <typed-geometry/functions/transform/rigid.hh>
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <type_traits>
+
+#include <typed-geometry/detail/operators/ops_mat.hh>
+#include <typed-geometry/detail/simd.hh>
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/functions/tests/mat_tests.hh>
+#include <typed-geometry/functions/vector/normalize.hh>
+#include <typed-geometry/types/dir.hh>
+#include <typed-geometry/types/mat.hh>
+#include <typed-geometry/types/pos.hh>
+#include <typed-geometry/types/span.hh>
+#include <typed-geometry/types/vec.hh>
+
+#include "inverse.hh"
+#include "transpose.hh"
+
+// Bulk transformation of arrays with a homogeneous (D+1)x(D+1) matrix
+//
+// transform_points(m, in, out)     -> out[i] = m * in[i] (perspective divide is skipped if is_affine(m))
+// transform_directions(m, in, out) -> out[i] = linear part of m times in[i] (no translation, no divide)
+// transform_normals(m, in, out)    -> out[i] = normalize(transpose(inverse(linear part of m)) * in[i])
+//
+// out must be at least as large as in and may alias it (in-place transformation)
+// results are identical to the per-element expressions (up to compiler floating point contraction)
+//
+// f32 3D versions process simd_f32::width elements at once if SSE4.1 or AVX2 is available (see detail/simd.hh)
+
+namespace tg
+{
+template <int D, class ScalarT>
+void transform_points(mat<D, D, ScalarT> const& m, dont_deduce<span<pos<D - 1, ScalarT> const>> in, dont_deduce<span<pos<D - 1, ScalarT>>> out);
+
+template <int D, class ScalarT>
+void transform_directions(mat<D, D, ScalarT> const& m, dont_deduce<span<vec<D - 1, ScalarT> const>> in, dont_deduce<span<vec<D - 1, ScalarT>>> out);
+
+template <int D, class ScalarT>
+void transform_normals(mat<D, D, ScalarT> const& m, dont_deduce<span<dir<D - 1, ScalarT> const>> in, dont_deduce<span<dir<D - 1, ScalarT>>> out);
+
+// ======== IMPLEMENTATION ========
+
+namespace detail
+{
+template <int D, class ScalarT>
+constexpr vec<D - 1, ScalarT> transform_linear(mat<D, D, ScalarT> const& m, vec<D - 1, ScalarT> const& v)
+{
+    auto r = vec<D - 1, ScalarT>(m[0]) * v[0];
+    for (auto c = 1; c < D - 1; ++c)
+        r = r + vec<D - 1, ScalarT>(m[c]) * v[c];
+    return r;
+}
+
+// same rounding as m * p for affine m (the last column is multiplied by 1)
+template <int D, class ScalarT>
+constexpr pos<D - 1, ScalarT> transform_point_affine(mat<D, D, ScalarT> const& m, pos<D - 1, ScalarT> const& p)
+{
+    return pos<D - 1, ScalarT>::zero + (transform_linear(m, p - pos<D - 1, ScalarT>::zero) + vec<D - 1, ScalarT>(m[D - 1]));
+}
+
+#ifdef TG_SIMD_F32_WIDTH
+/// calls f(x, y, z, rx, ry, rz) on SoA blocks of simd_f32::width consecutive 3D elements
+/// returns the number of processed elements, the tail (< width elements) is left to the caller
+template <class F>
+size_t transform_blocks3(f32 const* in, f32* out, size_t n, F&& f)
+{
+    using L = simd_f32;
+    constexpr auto W = size_t(L::width);
+
+    size_t i = 0;
+    for (; i + W <= n; i += W)
+    {
+        alignas(32) f32 x[W];
+        alignas(32) f32 y[W];
+        alignas(32) f32 z[W];
+        for (size_t k = 0; k < W; ++k)
+        {
+            x[k] = in[3 * (i + k) + 0];
+            y[k] = in[3 * (i + k) + 1];
+            z[k] = in[3 * (i + k) + 2];
+        }
+
+        L rx, ry, rz;
+        f(L::load(x), L::load(y), L::load(z), rx, ry, rz);
+        rx.store(x);
+        ry.store(y);
+        rz.store(z);
+
+        for (size_t k = 0; k < W; ++k)
+        {
+            out[3 * (i + k) + 0] = x[k];
+            out[3 * (i + k) + 1] = y[k];
+            out[3 * (i + k) + 2] = z[k];
+        }
+    }
+    return i;
+}
+#endif
+}
+
+template <int D, class ScalarT>
+void transform_points(mat<D, D, ScalarT> const& m, dont_deduce<span<pos<D - 1, ScalarT> const>> in, dont_deduce<span<pos<D - 1, ScalarT>>> out)
+{
+    TG_CONTRACT(out.size() >= in.size());
+
+    auto const affine = is_affine(m);
+    size_t i = 0;
+
+#ifdef TG_SIMD_F32_WIDTH
+    if constexpr (D == 4 && std::is_same_v<ScalarT, f32>)
+    {
+        using L = detail::simd_f32;
+        L c[4][4];
+        for (auto x = 0; x < 4; ++x)
+            for (auto y = 0; y < 4; ++y)
+                c[x][y] = L::broadcast(m[x][y]);
+
+        if (affine)
+            i = detail::transform_blocks3(&in.data()->x, &out.data()->x, in.size(), [&](L x, L y, L z, L& rx, L& ry, L& rz) {
+                rx = c[0][0] * x + c[1][0] * y + c[2][0] * z + c[3][0];
+                ry = c[0][1] * x + c[1][1] * y + c[2][1] * z + c[3][1];
+                rz = c[0][2] * x + c[1][2] * y + c[2][2] * z + c[3][2];
+            });
+        else // x / 1 == x, so always dividing matches the conditional divide of mat * pos
+            i = detail::transform_blocks3(&in.data()->x, &out.data()->x, in.size(), [&](L x, L y, L z, L& rx, L& ry, L& rz) {
+                auto const w = c[0][3] * x + c[1][3] * y + c[2][3] * z + c[3][3];
+                rx = (c[0][0] * x + c[1][0] * y + c[2][0] * z + c[3][0]) / w;
+                ry = (c[0][1] * x + c[1][1] * y + c[2][1] * z + c[3][1]) / w;
+                rz = (c[0][2] * x + c[1][2] * y + c[2][2] * z + c[3][2]) / w;
+            });
+    }
+#endif
+
+    if (affine)
+        for (; i < in.size(); ++i)
+            out[i] = detail::transform_point_affine(m, in[i]);
+    else
+        for (; i < in.size(); ++i)
+            out[i] = m * in[i];
+}
+
+template <int D, class ScalarT>
+void transform_directions(mat<D, D, ScalarT> const& m, dont_deduce<span<vec<D - 1, ScalarT> const>> in, dont_deduce<span<vec<D - 1, ScalarT>>> out)
+{
+    TG_CONTRACT(out.size() >= in.size());
+
+    size_t i = 0;
+
+#ifdef TG_SIMD_F32_WIDTH
+    if constexpr (D == 4 && std::is_same_v<ScalarT, f32>)
+    {
+        using L = detail::simd_f32;
+        L c[3][3];
+        for (auto x = 0; x < 3; ++x)
+            for (auto y = 0; y < 3; ++y)
+                c[x][y] = L::broadcast(m[x][y]);
+
+        i = detail::transform_blocks3(&in.data()->x, &out.data()->x, in.size(), [&](L x, L y, L z, L& rx, L& ry, L& rz) {
+            rx = c[0][0] * x + c[1][0] * y + c[2][0] * z;
+            ry = c[0][1] * x + c[1][1] * y + c[2][1] * z;
+            rz = c[0][2] * x + c[1][2] * y + c[2][2] * z;
+        });
+    }
+#endif
+
+    for (; i < in.size(); ++i)
+        out[i] = detail::transform_linear(m, in[i]);
+}
+
+template <int D, class ScalarT>
+void transform_normals(mat<D, D, ScalarT> const& m, dont_deduce<span<dir<D - 1, ScalarT> const>> in, dont_deduce<span<dir<D - 1, ScalarT>>> out)
+{
+    TG_CONTRACT(out.size() >= in.size());
+
+    auto const n = transpose(inverse(mat<D - 1, D - 1, ScalarT>(m)));
+    size_t i = 0;
+
+#ifdef TG_SIMD_F32_WIDTH
+    if constexpr (D == 4 && std::is_same_v<ScalarT, f32>)
+    {
+        using L = detail::simd_f32;
+        L c[3][3];
+        for (auto x = 0; x < 3; ++x)
+            for (auto y = 0; y < 3; ++y)
+                c[x][y] = L::broadcast(n[x][y]);
+
+        i = detail::transform_blocks3(&in.data()->x, &out.data()->x, in.size(), [&](L x, L y, L z, L& rx, L& ry, L& rz) {
+            auto const tx = c[0][0] * x + c[1][0] * y + c[2][0] * z;
+            auto const ty = c[0][1] * x + c[1][1] * y + c[2][1] * z;
+            auto const tz = c[0][2] * x + c[1][2] * y + c[2][2] * z;
+            auto const l = detail::simd_sqrt(tx * tx + ty * ty + tz * tz);
+            rx = tx / l;
+            ry = ty / l;
+            rz = tz / l;
+        });
+    }
+#endif
+
+    for (; i < in.size(); ++i)
+        out[i] = normalize(n * vec<D - 1, ScalarT>(in[i]));
+}
+}
@@ -8,6 +8,7 @@
 #include <typed-geometry/types/objects/cylinder.hh>
 #include <typed-geometry/types/objects/ellipse.hh>
 #include <typed-geometry/types/objects/hemisphere.hh>
+#include <typed-geometry/types/objects/polygon.hh>
 #include <typed-geometry/types/objects/pyramid.hh>
 #include <typed-geometry/types/objects/quad.hh>
 #include <typed-geometry/types/objects/segment.hh>
@@ -108,6 +109,24 @@ template <int D, class ScalarT>
     return aabb_of(q.pos00, q.pos10, q.pos11, q.pos01);
 }
 
+template <class ScalarT>
+[[nodiscard]] aabb<2, ScalarT> aabb_of(polygon<2, ScalarT> const& p)
+{
+    TG_CONTRACT(!p.empty() && "empty polygon has no aabb");
+    // one pass over the contiguous vertices with branch-free min/max selects
+    auto const v = p.vertices.data();
+    auto const n = p.vertices.size();
+    auto bb = aabb<2, ScalarT>(v[0], v[0]);
+    for (size_t i = 1; i < n; ++i)
+    {
+        bb.min.x = v[i].x < bb.min.x ? v[i].x : bb.min.x;
+        bb.min.y = v[i].y < bb.min.y ? v[i].y : bb.min.y;
+        bb.max.x = v[i].x > bb.max.x ? v[i].x : bb.max.x;
+        bb.max.y = v[i].y > bb.max.y ? v[i].y : bb.max.y;
+    }
+    return bb;
+}
+
 template <int ObjectD, class ScalarT, int DomainD, class TraitsT>
 [[nodiscard]] constexpr aabb<DomainD, ScalarT> aabb_of(box<ObjectD, ScalarT, DomainD, TraitsT> const& b)
 {
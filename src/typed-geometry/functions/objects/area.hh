@@ -6,6 +6,7 @@
 #include <typed-geometry/types/objects/cylinder.hh>
 #include <typed-geometry/types/objects/ellipse.hh>
 #include <typed-geometry/types/objects/hemisphere.hh>
+#include <typed-geometry/types/objects/polygon.hh>
 #include <typed-geometry/types/objects/pyramid.hh>
 #include <typed-geometry/types/objects/sphere.hh>
 #include <typed-geometry/types/objects/triangle.hh>
@@ -59,6 +60,75 @@ template <class ScalarT>
     return length(cross(b.pos1 - b.pos0, b.pos2 - b.pos0)) * fractional_result<ScalarT>(0.5);
 }
 
+namespace detail
+{
+/// shoelace sums of a polygon relative to its first vertex o:
+/// area2 = sum cross(v_i - o, v_i+1 - o), cx/cy = sum (v_i + v_i+1 - 2 o) * cross(v_i - o, v_i+1 - o)
+template <class ScalarT>
+struct polygon_moments
+{
+    ScalarT area2 = ScalarT(0);
+    ScalarT cx = ScalarT(0);
+    ScalarT cy = ScalarT(0);
+};
+
+template <bool WithCentroid, class ScalarT>
+[[nodiscard]] polygon_moments<ScalarT> polygon_shoelace(polygon<2, ScalarT> const& p)
+{
+    polygon_moments<ScalarT> m;
+    auto const n = p.vertices.size();
+    if (n < 3)
+        return m;
+
+    // the edges at o vanish, the others are summed with 4 independent accumulators
+    // (this shortens the floating-point add dependency chain, it is not a promise of auto-vectorization:
+    //  without -ffast-math compilers may not reassociate the sums)
+    auto const v = p.vertices.data();
+    auto const o = v[0];
+    ScalarT a[4] = {};
+    ScalarT cx[4] = {};
+    ScalarT cy[4] = {};
+    auto const add = [&](int k, size_t i) {
+        auto const ax = v[i].x - o.x;
+        auto const ay = v[i].y - o.y;
+        auto const bx = v[i + 1].x - o.x;
+        auto const by = v[i + 1].y - o.y;
+        auto const c = ax * by - ay * bx;
+        a[k] += c;
+        if constexpr (WithCentroid)
+        {
+            cx[k] += (ax + bx) * c;
+            cy[k] += (ay + by) * c;
+        }
+    };
+
+    size_t i = 1;
+    for (; i + 4 < n; i += 4)
+        for (auto k = 0; k < 4; ++k)
+            add(k, i + size_t(k));
+    for (; i + 1 < n; ++i)
+        add(0, i);
+
+    m.area2 = (a[0] + a[1]) + (a[2] + a[3]);
+    m.cx = (cx[0] + cx[1]) + (cx[2] + cx[3]);
+    m.cy = (cy[0] + cy[1]) + (cy[2] + cy[3]);
+    return m;
+}
+}
+
+/// positive for counter-clockwise polygons
+template <class ScalarT>
+[[nodiscard]] fractional_result<ScalarT> signed_area_of(polygon<2, ScalarT> const& p)
+{
+    return fractional_result<ScalarT>(detail::polygon_shoelace<false>(p).area2) * fractional_result<ScalarT>(0.5);
+}
+
+template <class ScalarT>
+[[nodiscard]] fractional_result<ScalarT> area_of(polygon<2, ScalarT> const& p)
+{
+    return abs(signed_area_of(p));
+}
+
 template <class ScalarT, int D, class TraitsT>
 [[nodiscard]] constexpr fractional_result<ScalarT> area_of(sphere<2, ScalarT, D, TraitsT> const& b)
 {
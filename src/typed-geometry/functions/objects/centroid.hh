@@ -7,6 +7,7 @@
 #include <typed-geometry/types/objects/cylinder.hh>
 #include <typed-geometry/types/objects/ellipse.hh>
 #include <typed-geometry/types/objects/hemisphere.hh>
+#include <typed-geometry/types/objects/polygon.hh>
 #include <typed-geometry/types/objects/pyramid.hh>
 #include <typed-geometry/types/objects/quad.hh>
 #include <typed-geometry/types/objects/segment.hh>
@@ -17,6 +18,8 @@
 #include <typed-geometry/detail/operators/ops_vec.hh>
 #include <typed-geometry/functions/basic/constants.hh>
 
+#include "area.hh"
+
 // returns the arithmetic mean of all points contained in an object
 // has variadic versions
 
@@ -66,6 +69,24 @@ template <int D, class ScalarT>
     return centroid_of(c1, c2);
 }
 
+/// area centroid, falls back to the mean of the vertices for polygons without area
+template <class ScalarT>
+[[nodiscard]] pos<2, fractional_result<ScalarT>> centroid_of(polygon<2, ScalarT> const& p)
+{
+    using T = fractional_result<ScalarT>;
+    TG_CONTRACT(!p.empty() && "empty polygon has no centroid");
+
+    auto const m = detail::polygon_shoelace<true>(p);
+    auto const o = pos<2, T>(p.vertices[0]);
+    if (m.area2 != ScalarT(0))
+        return o + vec<2, T>(T(m.cx), T(m.cy)) / (T(3) * T(m.area2));
+
+    auto s = vec<2, T>::zero;
+    for (auto const& v : p.vertices)
+        s += pos<2, T>(v) - o;
+    return o + s / T(p.vertices.size());
+}
+
 template <int ObjectD, class ScalarT, int DomainD, class TraitsT>
 [[nodiscard]] constexpr pos<DomainD, ScalarT> centroid_of(sphere<ObjectD, ScalarT, DomainD, TraitsT> const& s)
 {
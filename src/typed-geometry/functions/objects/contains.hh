@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 
 #include <typed-geometry/types/objects/aabb.hh>
@@ -13,6 +14,7 @@
 #include <typed-geometry/types/objects/hemisphere.hh>
 #include <typed-geometry/types/objects/inf_cone.hh>
 #include <typed-geometry/types/objects/inf_cylinder.hh>
+#include <typed-geometry/types/objects/polygon.hh>
 #include <typed-geometry/types/objects/pyramid.hh>
 #include <typed-geometry/types/objects/sphere.hh>
 #include <typed-geometry/types/objects/triangle.hh>
@@ -496,4 +498,36 @@ template <class ScalarT>
 
     return true;
 }
+
+// crossing number test (even-odd rule), points exactly on the boundary may be inside or outside
+// uses the slab index if it was built (O(log n)), otherwise tests all edges (O(n))
+template <class ScalarT>
+[[nodiscard]] bool contains(polygon<2, ScalarT> const& poly, pos<2, ScalarT> const& p)
+{
+    if (poly.has_slab_index())
+    {
+        auto const& ys = poly.slab_y;
+        if (ys.empty() || p.y < ys.front() || !(p.y < ys.back()))
+            return false;
+
+        // ys[s] <= p.y < ys[s + 1]
+        auto const s = size_t(std::upper_bound(ys.begin(), ys.end(), p.y) - ys.begin()) - 1;
+        auto const begin = poly.slab_edges.begin() + poly.slab_offsets[s];
+        auto const end = poly.slab_edges.begin() + poly.slab_offsets[s + 1];
+        auto const right = std::partition_point(begin, end, [&](detail::polygon_edge<ScalarT> const& e) { return e.x_at(p.y) <= p.x; });
+        return ((end - right) & 1) != 0;
+    }
+
+    auto const n = poly.vertices.size();
+    auto inside = false;
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto const a = poly.vertices[i];
+        auto const b = poly.vertices[i + 1 == n ? 0 : i + 1];
+        // same edge set and intersection formula as the slab index
+        if ((a.y <= p.y) != (b.y <= p.y) && p.x < detail::polygon_edge_of(a, b).x_at(p.y))
+            inside = !inside;
+    }
+    return inside;
+}
 } // namespace tg
@@ -0,0 +1,392 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include <typed-geometry/detail/simd.hh>
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/types/objects/aabb.hh>
+#include <typed-geometry/types/objects/box.hh>
+#include <typed-geometry/types/objects/capsule.hh>
+#include <typed-geometry/types/objects/cylinder.hh>
+#include <typed-geometry/types/objects/frustum.hh>
+#include <typed-geometry/types/objects/halfspace.hh>
+#include <typed-geometry/types/objects/inf_frustum.hh>
+#include <typed-geometry/types/objects/sphere.hh>
+#include <typed-geometry/types/span.hh>
+
+#include "contains.hh"
+
+// Batched version of contains(obj, pos, eps) for many points
+//
+// contains_batch(obj, points, out, eps)      -> out[i] = contains(obj, points[i], eps), out is span<bool> or span<u8>
+// contains_batch_mask(obj, points, mask, eps) -> bit (i % 64) of mask[i / 64] is contains(obj, points[i], eps), returns the number of contained points
+//
+// results are identical to contains(obj, pos, eps) (up to compiler floating point contraction, e.g. -ffp-contract=fast with FMA)
+//
+// SIMD kernels (SSE4.1 or AVX2, depending on the compile flags, see detail/simd.hh) exist for f32 versions of
+//   aabb3, box3, sphere3, capsule3, cylinder3, halfspace3, frustum3, inf_frustum3
+// all other objects use contains(obj, pos, eps) per point
+
+namespace tg
+{
+namespace detail
+{
+// contains_batch_kernel<Obj>(obj, eps) precomputes per-object data and evaluates contains for a batch of lanes
+// operator()(x, y, z) returns a lane mask
+template <class Obj>
+struct contains_batch_kernel;
+
+template <class Obj, class = void>
+struct has_contains_batch_kernel : std::false_type
+{
+};
+template <class Obj>
+struct has_contains_batch_kernel<Obj, std::void_t<decltype(contains_batch_kernel<Obj>(std::declval<Obj const&>(), f32(0)))>> : std::true_type
+{
+};
+
+template <>
+struct contains_batch_kernel<aabb<3, f32>>
+{
+    f32 lo[3];
+    f32 hi[3];
+
+    contains_batch_kernel(aabb<3, f32> const& b, f32 eps)
+    {
+        for (auto i = 0; i < 3; ++i)
+        {
+            lo[i] = b.min[i] - eps;
+            hi[i] = b.max[i] + eps;
+        }
+    }
+
+    template <class L>
+    L operator()(L x, L y, L z) const
+    {
+        return (L::broadcast(lo[0]) <= x) & (x <= L::broadcast(hi[0])) & //
+               (L::broadcast(lo[1]) <= y) & (y <= L::broadcast(hi[1])) & //
+               (L::broadcast(lo[2]) <= z) & (z <= L::broadcast(hi[2]));
+    }
+};
+
+template <>
+struct contains_batch_kernel<sphere<3, f32>>
+{
+    pos<3, f32> center;
+    f32 r2;
+
+    contains_batch_kernel(sphere<3, f32> const& s, f32 eps) : center(s.center)
+    {
+        auto const r = s.radius + eps;
+        r2 = pow2(r);
+    }
+
+    template <class L>
+    L operator()(L x, L y, L z) const
+    {
+        // same as distance_sqr(s.center, p)
+        auto const dx = L::broadcast(center.x) - x;
+        auto const dy = L::broadcast(center.y) - y;
+        auto const dz = L::broadcast(center.z) - z;
+        return dx * dx + dy * dy + dz * dz <= L::broadcast(r2);
+    }
+};
+
+template <>
+struct contains_batch_kernel<box<3, f32>>
+{
+    pos<3, f32> center;
+    vec<3, f32> axes[3];
+    f32 limits[3];
+
+    contains_batch_kernel(box<3, f32> const& b, f32 eps) : center(b.center)
+    {
+        for (auto i = 0; i < 3; ++i)
+        {
+            axes[i] = b.half_extents[i];
+            limits[i] = length_sqr(b.half_extents[i]) + eps;
+        }
+    }
+
+    template <class L>
+    L operator()(L x, L y, L z) const
+    {
+        auto const rx = x - L::broadcast(center.x);
+        auto const ry = y - L::broadcast(center.y);
+        auto const rz = z - L::broadcast(center.z);
+
+        auto outside = L::zero();
+        for (auto i = 0; i < 3; ++i)
+        {
+            auto const d = L::broadcast(axes[i].x) * rx + L::broadcast(axes[i].y) * ry + L::broadcast(axes[i].z) * rz;
+            outside = outside | (simd_abs(d) > L::broadcast(limits[i]));
+        }
+        return and_not(L::all_set(), outside);
+    }
+};
+
+template <>
+struct contains_batch_kernel<capsule<3, f32>>
+{
+    pos<3, f32> p0;
+    vec<3, f32> d;
+    f32 dd;
+    f32 r2;
+
+    contains_batch_kernel(capsule<3, f32> const& c, f32 eps) : p0(c.axis.pos0), d(c.axis.pos1 - c.axis.pos0)
+    {
+        dd = dot(d, d);
+        auto const r = c.radius + eps;
+        r2 = pow2(r);
+    }
+
+    template <class L>
+    L operator()(L x, L y, L z) const
+    {
+        // same as distance_sqr(c.axis, p), i.e. project(p, segment) with clamped coordinates
+        auto const dx = L::broadcast(d.x);
+        auto const dy = L::broadcast(d.y);
+        auto const dz = L::broadcast(d.z);
+        auto const px = x - L::broadcast(p0.x);
+        auto const py = y - L::broadcast(p0.y);
+        auto const pz = z - L::broadcast(p0.z);
+        auto t = (px * dx + py * dy + pz * dz) / L::broadcast(dd);
+        t = simd_min(simd_max(t, L::zero()), L::broadcast(1.0f));
+        auto const qx = L::broadcast(p0.x) + t * dx - x;
+        auto const qy = L::broadcast(p0.y) + t * dy - y;
+        auto const qz = L::broadcast(p0.z) + t * dz - z;
+        return qx * qx + qy * qy + qz * qz <= L::broadcast(r2);
+    }
+};
+
+template <>
+struct contains_batch_kernel<cylinder<3, f32>>
+{
+    pos<3, f32> p0;
+    vec<3, f32> ad;
+    f32 hsqd;
+    f32 rsqd;
+
+    contains_batch_kernel(cylinder<3, f32> const& c, f32 eps) : p0(c.axis.pos0), ad(c.axis.pos1 - c.axis.pos0)
+    {
+        TG_CONTRACT(eps == 0.0f && "contains(cylinder, pos) has no eps");
+        hsqd = length_sqr(ad);
+        rsqd = pow2(c.radius);
+    }
+
+    template <class L>
+    L operator()(L x, L y, L z) const
+    {
+        // same as contains(cylinder, pos)
+        auto const px = x - L::broadcast(p0.x);
+        auto const py = y - L::broadcast(p0.y);
+        auto const pz = z - L::broadcast(p0.z);
+        auto const d0 = px * L::broadcast(ad.x) + py * L::broadcast(ad.y) + pz * L::broadcast(ad.z);
+        auto const h = L::broadcast(hsqd);
+        auto const outside = (d0 < L::zero()) | (d0 > h) | (px * px + py * py + pz * pz - d0 * d0 / h > L::broadcast(rsqd));
+        return and_not(L::all_set(), outside);
+    }
+};
+
+template <>
+struct contains_batch_kernel<halfspace<3, f32>>
+{
+    dir<3, f32> n;
+    f32 dis;
+    f32 eps;
+
+    contains_batch_kernel(halfspace<3, f32> const& h, f32 eps) : n(h.normal), dis(h.dis), eps(eps) {}
+
+    template <class L>
+    L operator()(L x, L y, L z) const
+    {
+        // same as signed_distance(p, h) <= eps
+        auto const sd = x * L::broadcast(n.x) + y * L::broadcast(n.y) + z * L::broadcast(n.z) - L::broadcast(dis);
+        return sd <= L::broadcast(eps);
+    }
+};
+
+template <class FrustumT>
+struct contains_batch_frustum_kernel
+{
+    FrustumT f;
+    f32 eps;
+
+    contains_batch_frustum_kernel(FrustumT const& f, f32 eps) : f(f), eps(eps) {}
+
+    template <class L>
+    L operator()(L x, L y, L z) const
+    {
+        auto outside = L::zero();
+        for (auto const& pl : f.planes)
+        {
+            auto const sd = x * L::broadcast(pl.normal.x) + y * L::broadcast(pl.normal.y) + z * L::broadcast(pl.normal.z) - L::broadcast(pl.dis);
+            outside = outside | (sd > L::broadcast(eps));
+        }
+        return and_not(L::all_set(), outside);
+    }
+};
+template <>
+struct contains_batch_kernel<frustum<3, f32>> : contains_batch_frustum_kernel<frustum<3, f32>>
+{
+    using contains_batch_frustum_kernel::contains_batch_frustum_kernel;
+};
+template <>
+struct contains_batch_kernel<inf_frustum<3, f32>> : contains_batch_frustum_kernel<inf_frustum<3, f32>>
+{
+    using contains_batch_frustum_kernel::contains_batch_frustum_kernel;
+};
+
+/// point and scalar type of an object (frusta have no object_traits)
+template <class Obj>
+struct contains_batch_traits
+{
+    using pos_t = typename object_traits<Obj>::pos_t;
+    using scalar_t = typename object_traits<Obj>::scalar_t;
+};
+template <int D, class ScalarT, class TraitsT>
+struct contains_batch_traits<frustum<D, ScalarT, TraitsT>>
+{
+    using pos_t = pos<D, ScalarT>;
+    using scalar_t = ScalarT;
+};
+template <int D, class ScalarT, class TraitsT>
+struct contains_batch_traits<inf_frustum<D, ScalarT, TraitsT>>
+{
+    using pos_t = pos<D, ScalarT>;
+    using scalar_t = ScalarT;
+};
+
+template <class Obj, class PosT, class ScalarT, class = void>
+struct has_contains_eps : std::false_type
+{
+};
+template <class Obj, class PosT, class ScalarT>
+struct has_contains_eps<Obj, PosT, ScalarT, std::void_t<decltype(contains(std::declval<Obj const&>(), std::declval<PosT const&>(), std::declval<ScalarT>()))>>
+  : std::true_type
+{
+};
+
+template <class Obj, class PosT, class ScalarT>
+bool contains_batch_scalar(Obj const& obj, PosT const& p, ScalarT eps)
+{
+    // eps == 0 goes through contains(obj, p) because the generic distance-based eps overload can disagree with it
+    if constexpr (has_contains_eps<Obj, PosT, ScalarT>::value)
+        return eps == ScalarT(0) ? contains(obj, p) : contains(obj, p, eps);
+    else
+    {
+        TG_CONTRACT(eps == ScalarT(0) && "contains(obj, pos) has no eps");
+        return contains(obj, p);
+    }
+}
+
+/// calls on_block(first, bits) for consecutive blocks of up to 64 points
+template <class Obj, class F>
+void contains_batch_blocks(Obj const& obj,
+                           span<typename detail::contains_batch_traits<Obj>::pos_t const> points,
+                           typename detail::contains_batch_traits<Obj>::scalar_t eps,
+                           F&& on_block)
+{
+    auto const n = points.size();
+
+#ifdef TG_SIMD_F32_WIDTH
+    if constexpr (has_contains_batch_kernel<Obj>::value)
+    {
+        using L = simd_f32;
+        constexpr auto W = size_t(L::width);
+        auto const kernel = contains_batch_kernel<Obj>(obj, eps);
+
+        for (size_t b = 0; b < n; b += 64)
+        {
+            auto const cnt = n - b < 64 ? n - b : size_t(64);
+            u64 bits = 0;
+            for (size_t i = 0; i < cnt; i += W)
+            {
+                // AoS -> SoA, the tail replicates the last point
+                alignas(32) f32 xs[W];
+                alignas(32) f32 ys[W];
+                alignas(32) f32 zs[W];
+                for (size_t l = 0; l < W; ++l)
+                {
+                    auto const& p = points[b + (i + l < cnt ? i + l : cnt - 1)];
+                    xs[l] = p.x;
+                    ys[l] = p.y;
+                    zs[l] = p.z;
+                }
+                auto const m = kernel(L::load(xs), L::load(ys), L::load(zs)).movemask();
+                bits |= u64(unsigned(m)) << i;
+            }
+            if (cnt < 64)
+                bits &= (u64(1) << cnt) - 1;
+            on_block(b, bits);
+        }
+        return;
+    }
+#endif
+
+    for (size_t b = 0; b < n; b += 64)
+    {
+        auto const cnt = n - b < 64 ? n - b : size_t(64);
+        u64 bits = 0;
+        for (size_t i = 0; i < cnt; ++i)
+            if (contains_batch_scalar(obj, points[b + i], eps))
+                bits |= u64(1) << i;
+        on_block(b, bits);
+    }
+}
+
+inline int contains_batch_popcount(u64 v)
+{
+    auto c = 0;
+    for (; v; v &= v - 1)
+        ++c;
+    return c;
+}
+}
+
+template <class Obj>
+void contains_batch(Obj const& obj,
+                    span<typename detail::contains_batch_traits<Obj>::pos_t const> points,
+                    span<bool> out,
+                    typename detail::contains_batch_traits<Obj>::scalar_t eps = 0)
+{
+    TG_CONTRACT(out.size() >= points.size());
+    detail::contains_batch_blocks(obj, points, eps, [&](size_t first, u64 bits) {
+        auto const cnt = points.size() - first < 64 ? points.size() - first : size_t(64);
+        for (size_t i = 0; i < cnt; ++i)
+            out[first + i] = (bits >> i) & 1;
+    });
+}
+
+template <class Obj>
+void contains_batch(Obj const& obj,
+                    span<typename detail::contains_batch_traits<Obj>::pos_t const> points,
+                    span<u8> out,
+                    typename detail::contains_batch_traits<Obj>::scalar_t eps = 0)
+{
+    TG_CONTRACT(out.size() >= points.size());
+    detail::contains_batch_blocks(obj, points, eps, [&](size_t first, u64 bits) {
+        auto const cnt = points.size() - first < 64 ? points.size() - first : size_t(64);
+        for (size_t i = 0; i < cnt; ++i)
+            out[first + i] = u8((bits >> i) & 1);
+    });
+}
+
+/// mask must have at least (points.size() + 63) / 64 entries
+/// returns the number of contained points
+template <class Obj>
+size_t contains_batch_mask(Obj const& obj,
+                           span<typename detail::contains_batch_traits<Obj>::pos_t const> points,
+                           span<u64> mask,
+                           typename detail::contains_batch_traits<Obj>::scalar_t eps = 0)
+{
+    TG_CONTRACT(mask.size() >= (points.size() + 63) / 64);
+    size_t count = 0;
+    detail::contains_batch_blocks(obj, points, eps, [&](size_t first, u64 bits) {
+        mask[first / 64] = bits;
+        count += size_t(detail::contains_batch_popcount(bits));
+    });
+    return count;
+}
+}
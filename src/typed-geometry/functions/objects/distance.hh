@@ -19,6 +19,7 @@
 #include <typed-geometry/types/vec.hh>
 
 #include "closest_points.hh"
+#include "gjk.hh"
 #include "intersection.hh"
 
 namespace tg
@@ -161,29 +162,11 @@ template <int D, class ScalarT>
     return distance_sqr(s, l);
 }
 
-// TODO: use GJK or something?
 template <class ScalarT>
 [[nodiscard]] constexpr fractional_result<ScalarT> distance(aabb<3, ScalarT> const& bb, triangle<3, ScalarT> const& t)
 {
-    if (intersects(bb, t))
-        return fractional_result<ScalarT>(0);
-
-    auto d = tg::max<ScalarT>();
-
-    // tri vertices to bb
-    for (auto p : vertices_of(t))
-        d = min(d, distance(bb, p));
-
-    // bb vertices to tri
-    for (auto p : vertices_of(bb))
-        d = min(d, distance(t, p));
-
-    // edges to edges
-    for (auto e0 : edges_of(t))
-        for (auto e1 : edges_of(bb))
-            d = min(d, distance(e0, e1));
-
-    return d;
+    using T = fractional_result<ScalarT>;
+    return distance_gjk(aabb<3, T>(bb), triangle<3, T>(t));
 }
 template <class ScalarT>
 [[nodiscard]] constexpr fractional_result<ScalarT> distance(triangle<3, ScalarT> const& t, aabb<3, ScalarT> const& bb)
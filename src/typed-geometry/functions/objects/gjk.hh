@@ -0,0 +1,758 @@
+#pragma once
+
+#include <type_traits>
+
+#include <typed-geometry/detail/operators/common.hh>
+#include <typed-geometry/detail/operators/ops_pos.hh>
+#include <typed-geometry/detail/operators/ops_vec.hh>
+#include <typed-geometry/detail/special_values.hh>
+#include <typed-geometry/detail/utility.hh>
+#include <typed-geometry/functions/basic/constants.hh>
+#include <typed-geometry/functions/basic/scalar_math.hh>
+#include <typed-geometry/functions/vector/cross.hh>
+#include <typed-geometry/functions/vector/dot.hh>
+#include <typed-geometry/functions/vector/length.hh>
+#include <typed-geometry/functions/vector/math.hh>
+#include <typed-geometry/types/objects/traits.hh>
+#include <typed-geometry/types/pos.hh>
+#include <typed-geometry/types/vec.hh>
+
+#include "support_point.hh"
+
+// GJK (Gilbert-Johnson-Keerthi) and EPA (expanding polytope algorithm) for pairs of convex objects in 2D and 3D
+//
+// gjk(a, b)                -> gjk_result with intersects, distance and closest points
+// intersects_gjk(a, b)     -> true if a and b overlap or touch (stops as soon as a separating axis is found)
+// distance_gjk(a, b)       -> distance between a and b (0 if they intersect)
+// closest_points_gjk(a, b) -> {p_a, p_b} with minimal distance (a common point if they intersect)
+// epa(a, b)                -> epa_result with penetration depth, normal and contact points
+//
+// works for every pair of objects (and positions) that have a support_point(obj, vec), see support_point.hh
+// all objects must be convex and solid
+//
+// no heap allocations: GJK needs at most D + 1 simplex vertices, EPA uses fixed capacity polytopes
+// (if the capacity is exhausted, EPA returns the best estimate so far)
+// polytopes converge in a finite number of steps, curved objects up to a relative tolerance
+
+namespace tg
+{
+template <int D, class ScalarT>
+struct gjk_result
+{
+    using pos_t = pos<D, ScalarT>;
+
+    bool intersects = false; ///< true if the objects overlap or touch
+    ScalarT distance = 0;    ///< 0 if intersects
+    pos_t closest_a;         ///< closest point in a (a common point if intersects)
+    pos_t closest_b;         ///< closest point in b (a common point if intersects)
+    int iterations = 0;      ///< number of support point evaluations (per object)
+};
+
+template <int D, class ScalarT>
+struct epa_result
+{
+    using pos_t = pos<D, ScalarT>;
+    using vec_t = vec<D, ScalarT>;
+
+    bool intersects = false; ///< if false, depth is 0 and contact points are the closest points
+    ScalarT depth = 0;       ///< penetration depth, i.e. translating b by depth * normal separates the objects
+    vec_t normal;            ///< unit vector pointing from a to b
+    pos_t contact_a;         ///< deepest point of a in b, contact_a - contact_b == depth * normal
+    pos_t contact_b;         ///< deepest point of b in a
+};
+
+template <class A, class B>
+[[nodiscard]] constexpr auto gjk(A const& a, B const& b);
+
+template <class A, class B>
+[[nodiscard]] constexpr bool intersects_gjk(A const& a, B const& b);
+
+template <class A, class B>
+[[nodiscard]] constexpr auto distance_gjk(A const& a, B const& b);
+
+template <class A, class B>
+[[nodiscard]] constexpr auto closest_points_gjk(A const& a, B const& b);
+
+template <class A, class B>
+[[nodiscard]] constexpr auto epa(A const& a, B const& b);
+
+// ======== IMPLEMENTATION ========
+
+namespace detail
+{
+template <class ObjT>
+struct gjk_traits
+{
+    static constexpr int domain_dimension = object_traits<ObjT>::domain_dimension;
+    using scalar_t = typename object_traits<ObjT>::scalar_t;
+};
+template <int D, class ScalarT>
+struct gjk_traits<pos<D, ScalarT>>
+{
+    static constexpr int domain_dimension = D;
+    using scalar_t = ScalarT;
+};
+
+/// a point of the Minkowski difference a - b together with the support points that generated it
+template <int D, class ScalarT>
+struct gjk_vertex
+{
+    vec<D, ScalarT> w;
+    pos<D, ScalarT> a;
+    pos<D, ScalarT> b;
+};
+
+template <int D, class ScalarT, class A, class B>
+constexpr gjk_vertex<D, ScalarT> gjk_support(A const& a, B const& b, vec<D, ScalarT> const& d)
+{
+    auto const pa = support_point(a, d);
+    auto const pb = support_point(b, -d);
+    return {pa - pb, pa, pb};
+}
+
+/// simplex with barycentric weights of its point closest to the origin
+template <int D, class ScalarT>
+struct gjk_simplex
+{
+    gjk_vertex<D, ScalarT> vertices[D + 1];
+    ScalarT weights[D + 1] = {};
+    int size = 0;
+
+    constexpr void push(gjk_vertex<D, ScalarT> const& v, ScalarT weight)
+    {
+        vertices[size] = v;
+        weights[size] = weight;
+        ++size;
+    }
+
+    constexpr vec<D, ScalarT> closest() const
+    {
+        vec<D, ScalarT> r;
+        for (auto i = 0; i < size; ++i)
+            r += vertices[i].w * weights[i];
+        return r;
+    }
+    constexpr pair<pos<D, ScalarT>, pos<D, ScalarT>> closest_points() const
+    {
+        vec<D, ScalarT> a, b;
+        for (auto i = 0; i < size; ++i)
+        {
+            a += (vertices[i].a - pos<D, ScalarT>::zero) * weights[i];
+            b += (vertices[i].b - pos<D, ScalarT>::zero) * weights[i];
+        }
+        return {pos<D, ScalarT>::zero + a, pos<D, ScalarT>::zero + b};
+    }
+};
+
+// closest point to the origin of a segment / triangle / tetrahedron, see "Real-Time Collision Detection", Ericson 2004
+// only the vertices that support the closest point remain in the returned simplex
+
+template <int D, class ScalarT>
+constexpr gjk_simplex<D, ScalarT> gjk_closest_segment(gjk_vertex<D, ScalarT> const& a, gjk_vertex<D, ScalarT> const& b)
+{
+    gjk_simplex<D, ScalarT> s;
+    auto const ab = b.w - a.w;
+    auto const t = -dot(a.w, ab);
+    auto const ll = dot(ab, ab);
+    if (t <= ScalarT(0) || ll == ScalarT(0))
+        s.push(a, ScalarT(1));
+    else if (t >= ll)
+        s.push(b, ScalarT(1));
+    else
+    {
+        s.push(a, ScalarT(1) - t / ll);
+        s.push(b, t / ll);
+    }
+    return s;
+}
+
+template <int D, class ScalarT>
+constexpr gjk_simplex<D, ScalarT> gjk_closest_triangle(gjk_vertex<D, ScalarT> const& a, gjk_vertex<D, ScalarT> const& b, gjk_vertex<D, ScalarT> const& c)
+{
+    gjk_simplex<D, ScalarT> s;
+
+    auto const ab = b.w - a.w;
+    auto const ac = c.w - a.w;
+
+    auto const d1 = -dot(ab, a.w);
+    auto const d2 = -dot(ac, a.w);
+    if (d1 <= ScalarT(0) && d2 <= ScalarT(0))
+    {
+        s.push(a, ScalarT(1));
+        return s;
+    }
+
+    auto const d3 = -dot(ab, b.w);
+    auto const d4 = -dot(ac, b.w);
+    if (d3 >= ScalarT(0) && d4 <= d3)
+    {
+        s.push(b, ScalarT(1));
+        return s;
+    }
+
+    auto const vc = d1 * d4 - d3 * d2;
+    if (vc <= ScalarT(0) && d1 >= ScalarT(0) && d3 <= ScalarT(0))
+    {
+        auto const t = d1 / (d1 - d3);
+        s.push(a, ScalarT(1) - t);
+        s.push(b, t);
+        return s;
+    }
+
+    auto const d5 = -dot(ab, c.w);
+    auto const d6 = -dot(ac, c.w);
+    if (d6 >= ScalarT(0) && d5 <= d6)
+    {
+        s.push(c, ScalarT(1));
+        return s;
+    }
+
+    auto const vb = d5 * d2 - d1 * d6;
+    if (vb <= ScalarT(0) && d2 >= ScalarT(0) && d6 <= ScalarT(0))
+    {
+        auto const t = d2 / (d2 - d6);
+        s.push(a, ScalarT(1) - t);
+        s.push(c, t);
+        return s;
+    }
+
+    auto const va = d3 * d6 - d5 * d4;
+    if (va <= ScalarT(0) && d4 - d3 >= ScalarT(0) && d5 - d6 >= ScalarT(0))
+    {
+        auto const t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        s.push(b, ScalarT(1) - t);
+        s.push(c, t);
+        return s;
+    }
+
+    auto const sum = va + vb + vc;
+    if (sum <= ScalarT(0)) // degenerate triangle, closest of the edges
+    {
+        auto const sab = gjk_closest_segment(a, b);
+        auto const sbc = gjk_closest_segment(b, c);
+        auto const sca = gjk_closest_segment(c, a);
+        auto const lab = length_sqr(sab.closest());
+        auto const lbc = length_sqr(sbc.closest());
+        auto const lca = length_sqr(sca.closest());
+        return lab <= lbc && lab <= lca ? sab : lbc <= lca ? sbc : sca;
+    }
+
+    s.push(a, va / sum);
+    s.push(b, vb / sum);
+    s.push(c, vc / sum);
+    return s;
+}
+
+template <class ScalarT>
+constexpr gjk_simplex<3, ScalarT> gjk_closest_tetrahedron(gjk_vertex<3, ScalarT> const& a,
+                                                          gjk_vertex<3, ScalarT> const& b,
+                                                          gjk_vertex<3, ScalarT> const& c,
+                                                          gjk_vertex<3, ScalarT> const& d)
+{
+    // origin is outside of the face (p0, p1, p2) if it lies on the other side than the opposite vertex q
+    auto const outside = [](vec<3, ScalarT> const& p0, vec<3, ScalarT> const& p1, vec<3, ScalarT> const& p2, vec<3, ScalarT> const& q) {
+        auto const n = cross(p1 - p0, p2 - p0);
+        auto const so = -dot(p0, n);
+        auto const sq = dot(q - p0, n);
+        return sq == ScalarT(0) || so * sq < ScalarT(0);
+    };
+
+    gjk_simplex<3, ScalarT> best;
+    auto best_dist = tg::max<ScalarT>();
+    auto inside = true;
+    auto const test = [&](gjk_simplex<3, ScalarT> const& s) {
+        inside = false;
+        auto const l = length_sqr(s.closest());
+        if (l < best_dist)
+        {
+            best_dist = l;
+            best = s;
+        }
+    };
+
+    if (outside(a.w, b.w, c.w, d.w))
+        test(gjk_closest_triangle(a, b, c));
+    if (outside(a.w, c.w, d.w, b.w))
+        test(gjk_closest_triangle(a, c, d));
+    if (outside(a.w, d.w, b.w, c.w))
+        test(gjk_closest_triangle(a, d, b));
+    if (outside(b.w, d.w, c.w, a.w))
+        test(gjk_closest_triangle(b, d, c));
+
+    if (!inside)
+        return best;
+
+    // origin inside: barycentric coordinates via signed volumes
+    auto const vol = dot(b.w - a.w, cross(c.w - a.w, d.w - a.w));
+    auto const la = dot(b.w, cross(c.w, d.w)) / vol;
+    auto const lb = -dot(a.w, cross(c.w - a.w, d.w - a.w)) / vol;
+    auto const lc = -dot(b.w - a.w, cross(a.w, d.w - a.w)) / vol;
+
+    gjk_simplex<3, ScalarT> s;
+    s.push(a, la);
+    s.push(b, lb);
+    s.push(c, lc);
+    s.push(d, ScalarT(1) - la - lb - lc);
+    return s;
+}
+
+template <int D, class ScalarT>
+constexpr gjk_simplex<D, ScalarT> gjk_closest(gjk_simplex<D, ScalarT> const& s)
+{
+    auto const& v = s.vertices;
+    switch (s.size)
+    {
+    case 1:
+    {
+        auto r = s;
+        r.weights[0] = ScalarT(1);
+        return r;
+    }
+    case 2:
+        return gjk_closest_segment(v[0], v[1]);
+    case 3:
+        return gjk_closest_triangle(v[0], v[1], v[2]);
+    default:
+        if constexpr (D == 3)
+            return gjk_closest_tetrahedron(v[0], v[1], v[2], v[3]);
+        else
+        {
+            TG_ASSERT(false && "unreachable");
+            return s;
+        }
+    }
+}
+
+template <int D, class ScalarT>
+struct gjk_state
+{
+    gjk_simplex<D, ScalarT> simplex;
+    vec<D, ScalarT> v; // closest point of the Minkowski difference a - b to the origin
+    bool intersects = false;
+    bool separated = false; // only for stop_if_separated: a separating axis was found
+    int iterations = 0;
+};
+
+template <bool stop_if_separated, class A, class B>
+constexpr auto gjk_run(A const& a, B const& b)
+{
+    constexpr int D = gjk_traits<A>::domain_dimension;
+    using ScalarT = typename gjk_traits<A>::scalar_t;
+    static_assert(D == 2 || D == 3, "GJK is only implemented for 2D and 3D");
+    static_assert(D == gjk_traits<B>::domain_dimension, "objects must live in the same space");
+    static_assert(std::is_same_v<ScalarT, typename gjk_traits<B>::scalar_t>, "objects must have the same scalar type");
+
+    constexpr int max_iterations = 64;
+    constexpr auto eps_rel = ScalarT(64) * tg::epsilon<ScalarT>;
+    constexpr auto eps_abs = ScalarT(16) * tg::epsilon<ScalarT>;
+
+    gjk_state<D, ScalarT> r;
+
+    vec<D, ScalarT> d0;
+    d0[0] = ScalarT(1);
+    r.simplex.push(gjk_support(a, b, d0), ScalarT(1));
+    r.v = r.simplex.vertices[0].w;
+    r.iterations = 1;
+
+    auto max_w2 = length_sqr(r.v);
+    auto v2 = max_w2;
+
+    while (r.iterations < max_iterations)
+    {
+        if (v2 <= eps_abs * eps_abs * max_w2)
+        {
+            r.intersects = true;
+            return r;
+        }
+
+        auto const w = gjk_support(a, b, -r.v);
+        ++r.iterations;
+
+        auto const vw = dot(r.v, w.w);
+        if constexpr (stop_if_separated)
+            if (vw > ScalarT(0))
+            {
+                r.separated = true;
+                return r;
+            }
+
+        // no progress possible: v is (up to the tolerance) the closest point
+        if (v2 - vw <= eps_rel * v2)
+            return r;
+        for (auto i = 0; i < r.simplex.size; ++i)
+            if (r.simplex.vertices[i].w == w.w)
+                return r;
+
+        auto next = r.simplex;
+        next.push(w, ScalarT(0));
+        next = gjk_closest(next);
+
+        max_w2 = tg::max(max_w2, length_sqr(w.w));
+        auto const next_v = next.closest();
+        auto const next_v2 = length_sqr(next_v);
+
+        if (next.size == D + 1)
+        {
+            r.simplex = next;
+            r.v = next_v;
+            r.intersects = true;
+            return r;
+        }
+
+        if (next_v2 >= v2) // numerical stagnation, keep the previous (better) simplex
+            return r;
+
+        r.simplex = next;
+        r.v = next_v;
+        v2 = next_v2;
+    }
+
+    r.intersects = v2 <= eps_abs * eps_abs * max_w2;
+    return r;
+}
+
+// ---------------- EPA ----------------
+
+template <class ScalarT>
+struct epa_face
+{
+    int i0, i1, i2;
+    vec<3, ScalarT> normal;
+    ScalarT dist;
+};
+
+template <int D, class ScalarT>
+constexpr epa_result<D, ScalarT> epa_finish(vec<D, ScalarT> const& n, ScalarT dist, gjk_simplex<D, ScalarT> const& s)
+{
+    epa_result<D, ScalarT> r;
+    r.intersects = true;
+    r.depth = tg::max(dist, ScalarT(0));
+    r.normal = n;
+    auto const [pa, pb] = s.closest_points();
+    r.contact_a = pa;
+    r.contact_b = pb;
+    return r;
+}
+
+/// extends a GJK simplex containing the origin to a full D-simplex (used if the objects merely touch)
+/// returns false if the Minkowski difference is degenerate (lower dimensional)
+template <int D, class ScalarT, class A, class B>
+constexpr bool epa_blow_up(A const& a, B const& b, gjk_simplex<D, ScalarT>& s, ScalarT tol)
+{
+    auto const try_add = [&](vec<D, ScalarT> const& d) {
+        auto const w = gjk_support(a, b, d);
+        auto valid = true;
+        if (s.size == 1)
+            valid = length_sqr(w.w - s.vertices[0].w) > tol * tol;
+        else if (s.size == 2)
+        {
+            auto const e = s.vertices[1].w - s.vertices[0].w;
+            auto const p = w.w - s.vertices[0].w;
+            valid = length_sqr(p - e * (dot(p, e) / dot(e, e))) > tol * tol;
+        }
+        else if constexpr (D == 3)
+        {
+            auto const n = cross(s.vertices[1].w - s.vertices[0].w, s.vertices[2].w - s.vertices[0].w);
+            valid = abs(dot(w.w - s.vertices[0].w, n)) > tol * length(n);
+        }
+        if (valid)
+            s.push(w, ScalarT(0));
+        return valid;
+    };
+
+    if (s.size == 1)
+    {
+        for (auto i = 0; i < D && s.size == 1; ++i)
+        {
+            vec<D, ScalarT> d;
+            d[i] = ScalarT(1);
+            if (!try_add(d))
+                try_add(-d);
+        }
+        if (s.size == 1)
+            return false;
+    }
+
+    if (s.size == 2)
+    {
+        auto const e = s.vertices[1].w - s.vertices[0].w;
+        if constexpr (D == 2)
+        {
+            auto const p = vec<2, ScalarT>(-e.y, e.x);
+            if (!try_add(p) && !try_add(-p))
+                return false;
+        }
+        else
+        {
+            // two directions perpendicular to e
+            auto const ae = abs(e);
+            auto const axis = ae.x <= ae.y && ae.x <= ae.z ? vec<3, ScalarT>(1, 0, 0) : ae.y <= ae.z ? vec<3, ScalarT>(0, 1, 0) : vec<3, ScalarT>(0, 0, 1);
+            auto const p0 = cross(e, axis);
+            auto const p1 = cross(e, p0);
+            if (!try_add(p0) && !try_add(-p0) && !try_add(p1) && !try_add(-p1))
+                return false;
+        }
+    }
+
+    if constexpr (D == 3)
+        if (s.size == 3)
+        {
+            auto const n = cross(s.vertices[1].w - s.vertices[0].w, s.vertices[2].w - s.vertices[0].w);
+            if (!try_add(n) && !try_add(-n))
+                return false;
+        }
+
+    return true;
+}
+
+template <class ScalarT, class A, class B>
+constexpr epa_result<2, ScalarT> epa_run(A const& a, B const& b, gjk_simplex<2, ScalarT> s)
+{
+    constexpr int max_vertices = 64;
+    constexpr auto eps_rel = ScalarT(64) * tg::epsilon<ScalarT>;
+
+    auto scale = ScalarT(0);
+    for (auto i = 0; i < s.size; ++i)
+        scale = tg::max(scale, length(s.vertices[i].w));
+    auto const tol = eps_rel * tg::max(scale, ScalarT(1));
+
+    if (!epa_blow_up(a, b, s, tol))
+        return epa_finish(vec<2, ScalarT>(1, 0), ScalarT(0), s);
+
+    // polygon in counter-clockwise order
+    gjk_vertex<2, ScalarT> poly[max_vertices];
+    auto n = 3;
+    poly[0] = s.vertices[0];
+    poly[1] = s.vertices[1];
+    poly[2] = s.vertices[2];
+    if (cross(poly[1].w - poly[0].w, poly[2].w - poly[0].w) < ScalarT(0))
+        detail::swap(poly[1], poly[2]);
+
+    while (true)
+    {
+        // closest edge
+        auto best = 0;
+        auto best_dist = tg::max<ScalarT>();
+        vec<2, ScalarT> best_n;
+        for (auto i = 0; i < n; ++i)
+        {
+            auto const e = poly[(i + 1) % n].w - poly[i].w;
+            auto const l = length(e);
+            if (l == ScalarT(0))
+                continue;
+            auto const en = vec<2, ScalarT>(e.y, -e.x) / l;
+            auto const d = dot(en, poly[i].w);
+            if (d < best_dist)
+            {
+                best = i;
+                best_dist = d;
+                best_n = en;
+            }
+        }
+
+        auto const w = gjk_support(a, b, best_n);
+        auto const converged = dot(w.w, best_n) - best_dist <= tol;
+
+        if (converged || n == max_vertices)
+        {
+            // projection of the origin onto the closest edge
+            auto const e = poly[(best + 1) % n].w - poly[best].w;
+            auto const t = clamp(dot(best_n * best_dist - poly[best].w, e) / dot(e, e), ScalarT(0), ScalarT(1));
+            gjk_simplex<2, ScalarT> fs;
+            fs.push(poly[best], ScalarT(1) - t);
+            fs.push(poly[(best + 1) % n], t);
+            return epa_finish(best_n, best_dist, fs);
+        }
+
+        for (auto i = n; i > best + 1; --i)
+            poly[i] = poly[i - 1];
+        poly[best + 1] = w;
+        ++n;
+    }
+}
+
+template <class ScalarT, class A, class B>
+constexpr epa_result<3, ScalarT> epa_run(A const& a, B const& b, gjk_simplex<3, ScalarT> s)
+{
+    constexpr int max_vertices = 128;
+    constexpr int max_faces = 2 * max_vertices;
+    constexpr auto eps_rel = ScalarT(64) * tg::epsilon<ScalarT>;
+
+    auto scale = ScalarT(0);
+    for (auto i = 0; i < s.size; ++i)
+        scale = tg::max(scale, length(s.vertices[i].w));
+    auto const tol = eps_rel * tg::max(scale, ScalarT(1));
+
+    if (!epa_blow_up(a, b, s, tol))
+        return epa_finish(vec<3, ScalarT>(1, 0, 0), ScalarT(0), s);
+
+    gjk_vertex<3, ScalarT> verts[max_vertices];
+    epa_face<ScalarT> faces[max_faces];
+    bool visible[max_faces] = {};
+    int edges[3 * max_faces][2];
+    auto nv = 4;
+    auto nf = 0;
+
+    for (auto i = 0; i < 4; ++i)
+        verts[i] = s.vertices[i];
+
+    // orient the tetrahedron so that all faces point outwards
+    if (dot(verts[1].w - verts[0].w, cross(verts[2].w - verts[0].w, verts[3].w - verts[0].w)) > ScalarT(0))
+        detail::swap(verts[1], verts[2]);
+
+    auto const add_face = [&](int i0, int i1, int i2) {
+        auto const n = cross(verts[i1].w - verts[i0].w, verts[i2].w - verts[i0].w);
+        auto const l = length(n);
+        auto& f = faces[nf++];
+        f.i0 = i0;
+        f.i1 = i1;
+        f.i2 = i2;
+        f.normal = l > ScalarT(0) ? n / l : n;
+        f.dist = l > ScalarT(0) ? dot(f.normal, verts[i0].w) : tg::max<ScalarT>();
+    };
+    add_face(0, 1, 2);
+    add_face(0, 3, 1);
+    add_face(0, 2, 3);
+    add_face(1, 3, 2);
+
+    while (true)
+    {
+        auto best = 0;
+        for (auto i = 1; i < nf; ++i)
+            if (faces[i].dist < faces[best].dist)
+                best = i;
+
+        auto const f = faces[best];
+
+        auto const finish = [&] {
+            // barycentric coordinates of the projected origin
+            auto const p = f.normal * f.dist;
+            auto const v0 = verts[f.i1].w - verts[f.i0].w;
+            auto const v1 = verts[f.i2].w - verts[f.i0].w;
+            auto const v2 = p - verts[f.i0].w;
+            auto const d00 = dot(v0, v0);
+            auto const d01 = dot(v0, v1);
+            auto const d11 = dot(v1, v1);
+            auto const d20 = dot(v2, v0);
+            auto const d21 = dot(v2, v1);
+            auto const denom = d00 * d11 - d01 * d01;
+            auto const l1 = denom == ScalarT(0) ? ScalarT(0) : (d11 * d20 - d01 * d21) / denom;
+            auto const l2 = denom == ScalarT(0) ? ScalarT(0) : (d00 * d21 - d01 * d20) / denom;
+
+            gjk_simplex<3, ScalarT> fs;
+            fs.push(verts[f.i0], ScalarT(1) - l1 - l2);
+            fs.push(verts[f.i1], l1);
+            fs.push(verts[f.i2], l2);
+            return epa_finish(f.normal, f.dist, fs);
+        };
+
+        auto const w = gjk_support(a, b, f.normal);
+        if (dot(w.w, f.normal) - f.dist <= tol || nv == max_vertices)
+            return finish();
+
+        // faces visible from w are removed, the horizon (edges that belong to exactly one removed face) is connected to w
+        // (faces that w is only marginally in front of are kept, otherwise rounding can make the horizon inconsistent)
+        auto ne = 0;
+        auto const add_edge = [&](int i0, int i1) {
+            for (auto e = 0; e < ne; ++e)
+                if (edges[e][0] == i1 && edges[e][1] == i0)
+                {
+                    edges[e][0] = edges[ne - 1][0];
+                    edges[e][1] = edges[ne - 1][1];
+                    --ne;
+                    return;
+                }
+            edges[ne][0] = i0;
+            edges[ne][1] = i1;
+            ++ne;
+        };
+
+        auto removed = 0;
+        for (auto i = 0; i < nf; ++i)
+        {
+            auto const& fi = faces[i];
+            visible[i] = i == best || dot(fi.normal, w.w - verts[fi.i0].w) > tol * ScalarT(0.5);
+            if (visible[i])
+            {
+                add_edge(fi.i0, fi.i1);
+                add_edge(fi.i1, fi.i2);
+                add_edge(fi.i2, fi.i0);
+                ++removed;
+            }
+        }
+
+        if (nf - removed + ne > max_faces)
+            return finish();
+
+        auto const iw = nv++;
+        verts[iw] = w;
+
+        auto kept = 0;
+        for (auto i = 0; i < nf; ++i)
+            if (!visible[i])
+                faces[kept++] = faces[i];
+        nf = kept;
+
+        for (auto e = 0; e < ne; ++e)
+            add_face(edges[e][0], edges[e][1], iw);
+    }
+}
+}
+
+template <class A, class B>
+[[nodiscard]] constexpr auto gjk(A const& a, B const& b)
+{
+    constexpr int D = detail::gjk_traits<A>::domain_dimension;
+    using ScalarT = typename detail::gjk_traits<A>::scalar_t;
+
+    auto const s = detail::gjk_run<false>(a, b);
+    auto const [pa, pb] = s.simplex.closest_points();
+
+    gjk_result<D, ScalarT> r;
+    r.intersects = s.intersects;
+    r.distance = s.intersects ? ScalarT(0) : length(s.v);
+    r.closest_a = pa;
+    r.closest_b = pb;
+    r.iterations = s.iterations;
+    return r;
+}
+
+template <class A, class B>
+[[nodiscard]] constexpr bool intersects_gjk(A const& a, B const& b)
+{
+    return detail::gjk_run<true>(a, b).intersects;
+}
+
+template <class A, class B>
+[[nodiscard]] constexpr auto distance_gjk(A const& a, B const& b)
+{
+    return gjk(a, b).distance;
+}
+
+template <class A, class B>
+[[nodiscard]] constexpr auto closest_points_gjk(A const& a, B const& b)
+{
+    auto const r = gjk(a, b);
+    return pair<decltype(r.closest_a), decltype(r.closest_b)>{r.closest_a, r.closest_b};
+}
+
+template <class A, class B>
+[[nodiscard]] constexpr auto epa(A const& a, B const& b)
+{
+    constexpr int D = detail::gjk_traits<A>::domain_dimension;
+    using ScalarT = typename detail::gjk_traits<A>::scalar_t;
+
+    auto const s = detail::gjk_run<false>(a, b);
+    if (!s.intersects)
+    {
+        auto const [pa, pb] = s.simplex.closest_points();
+        epa_result<D, ScalarT> r;
+        r.normal = s.v / -length(s.v);
+        r.contact_a = pa;
+        r.contact_b = pb;
+        return r;
+    }
+
+    return detail::epa_run(a, b, s.simplex);
+}
+}
@@ -69,7 +69,7 @@
 // Notes:
 //  - intersection_exact is currently unsupported
 //  - intersection_safe is currently unsupported
-//  - for more elaborate ray-tracing, a future ray_cast function will exist (which also returns the intersection normal)
+//  - for more elaborate ray-tracing, see ray_cast in ray_cast.hh (which also returns the intersection normal)
 
 // Implementation guidelines:
 // if object has boundary_of(obj) defined
@@ -1495,6 +1495,14 @@ template <int ObjectD, class ScalarT, int DomainD>
 
     return {c - e, c + e};
 }
+template <int D, class ScalarT>
+[[nodiscard]] constexpr hit_interval<ScalarT> shadow(triangle<D, ScalarT> const& t, vec<D, ScalarT> const& axis)
+{
+    auto const d0 = dot(t.pos0, axis);
+    auto const d1 = dot(t.pos1, axis);
+    auto const d2 = dot(t.pos2, axis);
+    return {tg::min(d0, d1, d2), tg::max(d0, d1, d2)};
+}
 template <class BaseT>
 [[nodiscard]] constexpr hit_interval<typename BaseT::scalar_t> shadow(pyramid<BaseT> const& p, vec<3, typename BaseT::scalar_t> const& axis)
 {
@@ -3022,123 +3030,17 @@ template <class ScalarT>
 template <class ScalarT>
 [[nodiscard]] constexpr bool intersects(box<3, ScalarT> const& a, box<3, ScalarT> const& b)
 {
-    if (a.center == b.center)
-        return true;
-
-    // Separating Axes Theorem
-    auto const axis_check = [](dir<3, ScalarT> d, box<3, ScalarT> const& box_a, box<3, ScalarT> const& box_b) -> bool
+    // Separating Axes Theorem: face normals of a and b and the 9 edge-edge cross products
+    // (parallel edges give a zero axis, which never separates)
+    vec<3, ScalarT> axes[15];
+    for (auto i = 0; i < 3; ++i)
     {
-        ScalarT minProja = tg::max<ScalarT>();
-        ScalarT maxProja = tg::min<ScalarT>();
-        ScalarT minProjb = tg::max<ScalarT>();
-        ScalarT maxProjb = tg::min<ScalarT>();
-
-        for (auto x : {-1, 1})
-            for (auto y : {-1, 1})
-                for (auto z : {-1, 1})
-                {
-                    vec3 v = {float(x), float(y), float(z)};
-
-                    auto proja = dot(d, box_a.half_extents * v);
-                    if (proja < minProja)
-                        minProja = proja;
-                    if (proja > maxProja)
-                        maxProja = proja;
-
-                    auto projb = dot(d, box_b.half_extents * v);
-                    if (projb < minProjb)
-                        minProjb = projb;
-                    if (projb > maxProjb)
-                        maxProjb = projb;
-                }
-
-        if (maxProja < minProjb || minProja > maxProjb)
-            return true; // extents of boxes projected onto axis are overlapping -> intersection)
-
-        return false;
-    };
-
-    dir<3, ScalarT> ax = normalize(a.half_extents[0]);
-    dir<3, ScalarT> ay = normalize(a.half_extents[1]);
-    dir<3, ScalarT> az = normalize(a.half_extents[2]);
-
-    dir<3, ScalarT> bx = normalize(b.half_extents[0]);
-    dir<3, ScalarT> by = normalize(b.half_extents[1]);
-    dir<3, ScalarT> bz = normalize(b.half_extents[2]);
-
-    auto cross_ax_bx = cross(ax, bx);
-    auto cross_ax_by = cross(ax, by);
-    auto cross_ax_bz = cross(ax, bz);
-
-    auto cross_ay_bx = cross(ay, bx);
-    auto cross_ay_by = cross(ay, by);
-    auto cross_ay_bz = cross(ay, bz);
-
-    auto cross_az_bx = cross(az, bx);
-    auto cross_az_by = cross(az, by);
-    auto cross_az_bz = cross(az, bz);
-
-    // ax
-    if (axis_check(ax, a, b))
-        return true;
-
-    // ay
-    if (axis_check(ay, a, b))
-        return true;
-
-    // az
-    if (axis_check(az, a, b))
-        return true;
-
-    // bx
-    if (axis_check(bx, a, b))
-        return true;
-
-    // by
-    if (axis_check(by, a, b))
-        return true;
-
-    // bz
-    if (axis_check(bz, a, b))
-        return true;
-
-    // ax_bx
-    if (length_sqr(cross_ax_bx) > 0 ? axis_check(normalize(cross_ax_bx), a, b) : false)
-        return true;
-
-    // ax_by
-    if (length_sqr(cross_ax_by) > 0 ? axis_check(normalize(cross_ax_by), a, b) : false)
-        return true;
-
-    // ax_bz
-    if (length_sqr(cross_ax_bz) > 0 ? axis_check(normalize(cross_ax_bz), a, b) : false)
-        return true;
-
-    // ay_by
-    if (length_sqr(cross_ay_bx) > 0 ? axis_check(normalize(cross_ay_bx), a, b) : false)
-        return true;
-
-    // ay_by
-    if (length_sqr(cross_ay_by) > 0 ? axis_check(normalize(cross_ay_by), a, b) : false)
-        return true;
-
-    // ay_bz
-    if (length_sqr(cross_ay_bz) > 0 ? axis_check(normalize(cross_ay_bz), a, b) : false)
-        return true;
-
-    // az_bx
-    if (length_sqr(cross_az_bx) > 0 ? axis_check(normalize(cross_az_bx), a, b) : false)
-        return true;
-
-    // az_by
-    if (length_sqr(cross_az_by) > 0 ? axis_check(normalize(cross_az_by), a, b) : false)
-        return true;
-
-    // az_bz
-    if (length_sqr(cross_az_bz) > 0 ? axis_check(normalize(cross_az_bz), a, b) : false)
-        return true;
-
-    return false;
+        axes[i] = a.half_extents[i];
+        axes[3 + i] = b.half_extents[i];
+        for (auto j = 0; j < 3; ++j)
+            axes[6 + 3 * i + j] = cross(a.half_extents[i], b.half_extents[j]);
+    }
+    return detail::intersects_SAT(a, b, span<vec<3, ScalarT> const>(axes));
 }
 
 template <class ScalarT>
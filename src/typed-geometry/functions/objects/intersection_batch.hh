@@ -0,0 +1,271 @@
+#pragma once
+
+#include <type_traits>
+
+#include <typed-geometry/detail/simd.hh>
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/functions/basic/scalar_math.hh>
+#include <typed-geometry/types/objects/frustum.hh>
+#include <typed-geometry/types/objects/inf_frustum.hh>
+#include <typed-geometry/types/span.hh>
+
+// Batched frustum culling, i.e. intersects_conservative(frustum, aabb/sphere) for many objects and frusta at once
+//
+// bounds are given as SoA views (one span per component):
+//   aabb_soa_view<ScalarT>   -> center_x/y/z, half_extent_x/y/z
+//   sphere_soa_view<ScalarT> -> center_x/y/z, radius
+//
+// intersects_conservative_batch(frustum, bounds, mask)         -> bit (i % 64) of mask[i / 64] is intersects_conservative(frustum, object i)
+//                                                                 returns the number of visible objects
+// intersects_conservative_batch(span of frusta, bounds, masks) -> same for every frustum f, writing masks[f * words + i / 64]
+//                                                                 with words = (bounds.size() + 63) / 64 (e.g. shadow cascades)
+//
+// each batch of objects is loaded once and tested against all frusta (f32: simd_f32::width objects per instruction)
+// results match the scalar intersects_conservative (up to compiler floating point contraction)
+// unused bits of the last word are cleared
+
+namespace tg
+{
+template <class ScalarT>
+struct aabb_soa_view
+{
+    span<ScalarT const> center_x;
+    span<ScalarT const> center_y;
+    span<ScalarT const> center_z;
+    span<ScalarT const> half_extent_x;
+    span<ScalarT const> half_extent_y;
+    span<ScalarT const> half_extent_z;
+
+    constexpr size_t size() const { return center_x.size(); }
+};
+
+template <class ScalarT>
+struct sphere_soa_view
+{
+    span<ScalarT const> center_x;
+    span<ScalarT const> center_y;
+    span<ScalarT const> center_z;
+    span<ScalarT const> radius;
+
+    constexpr size_t size() const { return center_x.size(); }
+};
+
+// ======== IMPLEMENTATION ========
+
+namespace detail
+{
+template <class ScalarT>
+void check_soa_view(aabb_soa_view<ScalarT> const& b)
+{
+    TG_CONTRACT(b.center_y.size() == b.size() && b.center_z.size() == b.size());
+    TG_CONTRACT(b.half_extent_x.size() == b.size() && b.half_extent_y.size() == b.size() && b.half_extent_z.size() == b.size());
+}
+template <class ScalarT>
+void check_soa_view(sphere_soa_view<ScalarT> const& b)
+{
+    TG_CONTRACT(b.center_y.size() == b.size() && b.center_z.size() == b.size() && b.radius.size() == b.size());
+}
+
+// same as intersects(halfspace, aabb) for each plane: dist <= 0 || shadow >= dist
+template <class FrustumT, class ScalarT>
+bool frustum_cull_visible(FrustumT const& f, aabb_soa_view<ScalarT> const& b, size_t i, ScalarT)
+{
+    auto const cx = b.center_x[i];
+    auto const cy = b.center_y[i];
+    auto const cz = b.center_z[i];
+    auto const ex = b.half_extent_x[i];
+    auto const ey = b.half_extent_y[i];
+    auto const ez = b.half_extent_z[i];
+    for (auto const& p : f.planes)
+    {
+        auto const dist = (cx * p.normal.x + cy * p.normal.y + cz * p.normal.z) - p.dis;
+        auto const shadow = ex * abs(p.normal.x) + ey * abs(p.normal.y) + ez * abs(p.normal.z);
+        if (!(dist <= ScalarT(0) || shadow >= dist))
+            return false;
+    }
+    return true;
+}
+// same as intersects_conservative(frustum, sphere, eps): signed_distance(center, plane) <= radius + eps for each plane
+template <class FrustumT, class ScalarT>
+bool frustum_cull_visible(FrustumT const& f, sphere_soa_view<ScalarT> const& b, size_t i, ScalarT eps)
+{
+    auto const cx = b.center_x[i];
+    auto const cy = b.center_y[i];
+    auto const cz = b.center_z[i];
+    auto const r = b.radius[i] + eps;
+    for (auto const& p : f.planes)
+    {
+        auto const dist = (cx * p.normal.x + cy * p.normal.y + cz * p.normal.z) - p.dis;
+        if (dist > r)
+            return false;
+    }
+    return true;
+}
+
+#ifdef TG_SIMD_F32_WIDTH
+/// SIMD versions of frustum_cull_visible, returns lane masks for objects [i, i + width)
+/// (one specialization per view type so each kernel is a branch-free loop over the planes)
+template <class FrustumT, class BoundsT>
+struct frustum_cull_simd;
+
+template <class FrustumT>
+struct frustum_cull_simd<FrustumT, aabb_soa_view<f32>>
+{
+    using L = simd_f32;
+
+    L cx, cy, cz;
+    L ex, ey, ez;
+
+    frustum_cull_simd(aabb_soa_view<f32> const& b, size_t i, f32)
+      : cx(L::load(b.center_x.data() + i)),
+        cy(L::load(b.center_y.data() + i)),
+        cz(L::load(b.center_z.data() + i)),
+        ex(L::load(b.half_extent_x.data() + i)),
+        ey(L::load(b.half_extent_y.data() + i)),
+        ez(L::load(b.half_extent_z.data() + i))
+    {
+    }
+
+    L visible(FrustumT const& f) const
+    {
+        auto visible = L::all_set();
+        for (auto const& p : f.planes)
+        {
+            auto const dist = (cx * L::broadcast(p.normal.x) + cy * L::broadcast(p.normal.y) + cz * L::broadcast(p.normal.z)) - L::broadcast(p.dis);
+            auto const shadow = ex * L::broadcast(abs(p.normal.x)) + ey * L::broadcast(abs(p.normal.y)) + ez * L::broadcast(abs(p.normal.z));
+            visible = visible & ((dist <= L::zero()) | (shadow >= dist));
+        }
+        return visible;
+    }
+};
+
+template <class FrustumT>
+struct frustum_cull_simd<FrustumT, sphere_soa_view<f32>>
+{
+    using L = simd_f32;
+
+    L cx, cy, cz;
+    L r; // radius + eps
+
+    frustum_cull_simd(sphere_soa_view<f32> const& b, size_t i, f32 eps)
+      : cx(L::load(b.center_x.data() + i)),
+        cy(L::load(b.center_y.data() + i)),
+        cz(L::load(b.center_z.data() + i)),
+        r(L::load(b.radius.data() + i) + L::broadcast(eps))
+    {
+    }
+
+    L visible(FrustumT const& f) const
+    {
+        auto visible = L::all_set();
+        for (auto const& p : f.planes)
+        {
+            auto const dist = (cx * L::broadcast(p.normal.x) + cy * L::broadcast(p.normal.y) + cz * L::broadcast(p.normal.z)) - L::broadcast(p.dis);
+            visible = visible & (dist <= r);
+        }
+        return visible;
+    }
+};
+#endif
+
+template <class FrustumT, class BoundsT, class ScalarT>
+void frustum_cull_batch(FrustumT const* frusta, size_t frustum_count, BoundsT const& b, span<u64> masks, ScalarT eps)
+{
+    check_soa_view(b);
+
+    auto const n = b.size();
+    auto const words = (n + 63) / 64;
+    TG_CONTRACT(masks.size() >= frustum_count * words);
+
+    for (size_t w = 0; w < words; ++w)
+    {
+        auto const base = w * 64;
+        auto const cnt = n - base < 64 ? n - base : size_t(64);
+
+        for (size_t f = 0; f < frustum_count; ++f)
+            masks[f * words + w] = 0;
+
+        size_t i = 0;
+
+#ifdef TG_SIMD_F32_WIDTH
+        if constexpr (std::is_same_v<ScalarT, f32>)
+        {
+            constexpr auto W = size_t(simd_f32::width);
+            for (; i + W <= cnt; i += W)
+            {
+                auto const block = frustum_cull_simd<FrustumT, BoundsT>(b, base + i, eps);
+                for (size_t f = 0; f < frustum_count; ++f)
+                    masks[f * words + w] |= u64(block.visible(frusta[f]).movemask()) << i;
+            }
+        }
+#endif
+
+        for (; i < cnt; ++i)
+            for (size_t f = 0; f < frustum_count; ++f)
+                if (frustum_cull_visible(frusta[f], b, base + i, eps))
+                    masks[f * words + w] |= u64(1) << i;
+    }
+}
+
+inline size_t frustum_cull_popcount(span<u64 const> masks)
+{
+    size_t c = 0;
+    for (auto v : masks)
+        for (; v; v &= v - 1)
+            ++c;
+    return c;
+}
+}
+
+template <class ScalarT>
+size_t intersects_conservative_batch(frustum<3, ScalarT> const& f, aabb_soa_view<ScalarT> const& bounds, span<u64> mask)
+{
+    detail::frustum_cull_batch(&f, 1, bounds, mask, ScalarT(0));
+    return detail::frustum_cull_popcount({mask.data(), (bounds.size() + 63) / 64});
+}
+template <class ScalarT>
+size_t intersects_conservative_batch(inf_frustum<3, ScalarT> const& f, aabb_soa_view<ScalarT> const& bounds, span<u64> mask)
+{
+    detail::frustum_cull_batch(&f, 1, bounds, mask, ScalarT(0));
+    return detail::frustum_cull_popcount({mask.data(), (bounds.size() + 63) / 64});
+}
+template <class ScalarT>
+size_t intersects_conservative_batch(frustum<3, ScalarT> const& f, sphere_soa_view<ScalarT> const& bounds, span<u64> mask, dont_deduce<ScalarT> eps = ScalarT(0))
+{
+    detail::frustum_cull_batch(&f, 1, bounds, mask, eps);
+    return detail::frustum_cull_popcount({mask.data(), (bounds.size() + 63) / 64});
+}
+template <class ScalarT>
+size_t intersects_conservative_batch(inf_frustum<3, ScalarT> const& f, sphere_soa_view<ScalarT> const& bounds, span<u64> mask, dont_deduce<ScalarT> eps = ScalarT(0))
+{
+    detail::frustum_cull_batch(&f, 1, bounds, mask, eps);
+    return detail::frustum_cull_popcount({mask.data(), (bounds.size() + 63) / 64});
+}
+
+template <class ScalarT>
+void intersects_conservative_batch(dont_deduce<span<frustum<3, ScalarT> const>> frusta, aabb_soa_view<ScalarT> const& bounds, span<u64> masks)
+{
+    detail::frustum_cull_batch(frusta.data(), frusta.size(), bounds, masks, ScalarT(0));
+}
+template <class ScalarT>
+void intersects_conservative_batch(dont_deduce<span<inf_frustum<3, ScalarT> const>> frusta, aabb_soa_view<ScalarT> const& bounds, span<u64> masks)
+{
+    detail::frustum_cull_batch(frusta.data(), frusta.size(), bounds, masks, ScalarT(0));
+}
+template <class ScalarT>
+void intersects_conservative_batch(dont_deduce<span<frustum<3, ScalarT> const>> frusta,
+                                   sphere_soa_view<ScalarT> const& bounds,
+                                   span<u64> masks,
+                                   dont_deduce<ScalarT> eps = ScalarT(0))
+{
+    detail::frustum_cull_batch(frusta.data(), frusta.size(), bounds, masks, eps);
+}
+template <class ScalarT>
+void intersects_conservative_batch(dont_deduce<span<inf_frustum<3, ScalarT> const>> frusta,
+                                   sphere_soa_view<ScalarT> const& bounds,
+                                   span<u64> masks,
+                                   dont_deduce<ScalarT> eps = ScalarT(0))
+{
+    detail::frustum_cull_batch(frusta.data(), frusta.size(), bounds, masks, eps);
+}
+}
@@ -0,0 +1,358 @@
+#pragma once
+
+#include <clean-core/optional.hh>
+
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/functions/basic/constants.hh>
+#include <typed-geometry/functions/basic/limits.hh>
+#include <typed-geometry/functions/basic/scalar_math.hh>
+
+#include <typed-geometry/types/objects/aabb.hh>
+#include <typed-geometry/types/objects/box.hh>
+#include <typed-geometry/types/objects/plane.hh>
+#include <typed-geometry/types/objects/ray_packet.hh>
+#include <typed-geometry/types/objects/sphere.hh>
+#include <typed-geometry/types/objects/triangle.hh>
+
+#include "intersection.hh"
+
+// packet versions of the ray intersection functions:
+
+// intersection_parameter(packet, obj)         -> packet_hits<N, ScalarT, W> or packet_hit_intervals<ScalarT, W> (when obj is solid)
+// closest_intersection_parameter(packet, obj) -> packet_hits<1, ScalarT, W>
+// intersects(packet, obj)                     -> u32 (bit i is set iff lane i intersects obj)
+
+// Notes:
+//  - each lane yields the same result as the scalar function applied to packet.lane(i) (up to floating point reordering)
+//  - the kernels are branchless loops over the lanes so that the compiler can map them to SSE/AVX registers
+//  - unused lanes should contain valid rays (see ray_packet(span<ray const>))
+
+namespace tg
+{
+// ====================================== Result Structs ======================================
+
+/// per-lane ordered list of ray intersection hits
+/// t[h][lane] is the h-th hit of the given lane (only valid for h < count[lane])
+template <int MaxHits, class ScalarT, int W>
+struct packet_hits
+{
+    static constexpr int max_hits = MaxHits;
+    static constexpr int width = W;
+
+    u32 mask = 0; ///< bit i is set iff lane i has at least one hit
+    u8 count[W] = {};
+    ScalarT t[MaxHits][W] = {};
+
+    [[nodiscard]] constexpr bool any() const { return mask != 0; }
+    [[nodiscard]] constexpr bool has_hit(int lane) const { return (mask >> lane) & 1u; }
+
+    /// returns the hits of a single lane
+    [[nodiscard]] hits<MaxHits, ScalarT> operator[](int lane) const
+    {
+        TG_CONTRACT(0 <= lane && lane < W);
+        ScalarT ts[MaxHits] = {};
+        for (auto h = 0; h < count[lane]; ++h)
+            ts[h] = t[h][lane];
+        return {ts, int(count[lane])};
+    }
+};
+
+/// per-lane continuous interval on a ray between start[lane] and end[lane]
+/// start and end are only valid for lanes with a set bit in mask
+template <class ScalarT, int W>
+struct packet_hit_intervals
+{
+    static constexpr int width = W;
+
+    u32 mask = 0; ///< bit i is set iff lane i intersects the object
+    ScalarT start[W] = {};
+    ScalarT end[W] = {};
+
+    [[nodiscard]] constexpr bool any() const { return mask != 0; }
+    [[nodiscard]] constexpr bool has_hit(int lane) const { return (mask >> lane) & 1u; }
+
+    /// returns the interval of a single lane
+    [[nodiscard]] constexpr cc::optional<hit_interval<ScalarT>> operator[](int lane) const
+    {
+        TG_CONTRACT(0 <= lane && lane < W);
+        if (!has_hit(lane))
+            return {};
+        return hit_interval<ScalarT>{start[lane], end[lane]};
+    }
+};
+
+
+// ====================================== Helper functions ======================================
+
+namespace detail
+{
+template <int W>
+[[nodiscard]] constexpr u32 lane_mask(bool const (&b)[W])
+{
+    u32 m = 0;
+    for (auto l = 0; l < W; ++l)
+        m |= u32(b[l]) << l;
+    return m;
+}
+
+// slab test along one axis
+// for (near) parallel rays, the slab is either the full line (origin inside) or empty (origin outside)
+template <class ScalarT, int W>
+constexpr void packet_clip_slab(ScalarT const (&origin)[W],
+                                ScalarT const (&dir)[W],
+                                ScalarT const (&smin)[W],
+                                ScalarT const (&smax)[W],
+                                ScalarT (&tFirst)[W],
+                                ScalarT (&tSecond)[W])
+{
+    for (auto l = 0; l < W; ++l)
+    {
+        auto const parallel = abs(dir[l]) <= ScalarT(100) * tg::epsilon<ScalarT>;
+        auto const inside = smin[l] <= origin[l] && origin[l] <= smax[l];
+        auto const invD = ScalarT(1) / (parallel ? ScalarT(1) : dir[l]);
+        auto const t0 = (smin[l] - origin[l]) * invD;
+        auto const t1 = (smax[l] - origin[l]) * invD;
+        auto const tNear = parallel ? (inside ? tg::min<ScalarT>() : tg::max<ScalarT>()) : tg::min(t0, t1);
+        auto const tFar = parallel ? (inside ? tg::max<ScalarT>() : tg::min<ScalarT>()) : tg::max(t0, t1);
+        tFirst[l] = tg::max(tFirst[l], tNear);
+        tSecond[l] = tg::min(tSecond[l], tFar);
+    }
+}
+
+// converts per-lane line intervals into ray intervals (same semantics as intersection_parameter(ray, solid))
+template <class ScalarT, int W>
+[[nodiscard]] constexpr packet_hit_intervals<ScalarT, W> packet_ray_intervals(ScalarT const (&tFirst)[W], ScalarT const (&tSecond)[W])
+{
+    packet_hit_intervals<ScalarT, W> r;
+    bool hit[W] = {};
+    for (auto l = 0; l < W; ++l)
+    {
+        hit[l] = tFirst[l] <= tSecond[l] && tSecond[l] >= ScalarT(0);
+        r.start[l] = tg::max(tFirst[l], ScalarT(0));
+        r.end[l] = tSecond[l];
+    }
+    r.mask = lane_mask<W>(hit);
+    return r;
+}
+}
+
+
+// ====================================== Packet - Object Intersections ======================================
+
+// packet - aabb
+template <int D, class ScalarT, int W>
+[[nodiscard]] constexpr packet_hit_intervals<ScalarT, W> intersection_parameter(ray_packet<D, ScalarT, W> const& rp, aabb<D, ScalarT> const& b)
+{
+    ScalarT tFirst[W];
+    ScalarT tSecond[W];
+    for (auto l = 0; l < W; ++l)
+    {
+        tFirst[l] = tg::min<ScalarT>();
+        tSecond[l] = tg::max<ScalarT>();
+    }
+
+    ScalarT smin[W];
+    ScalarT smax[W];
+    for (auto i = 0; i < D; ++i)
+    {
+        for (auto l = 0; l < W; ++l)
+        {
+            smin[l] = b.min[i];
+            smax[l] = b.max[i];
+        }
+        detail::packet_clip_slab<ScalarT, W>(rp.origin[i], rp.dir[i], smin, smax, tFirst, tSecond);
+    }
+
+    return detail::packet_ray_intervals<ScalarT, W>(tFirst, tSecond);
+}
+
+// packet - box
+template <int D, class ScalarT, int W>
+[[nodiscard]] constexpr packet_hit_intervals<ScalarT, W> intersection_parameter(ray_packet<D, ScalarT, W> const& rp, box<D, ScalarT> const& b)
+{
+    ScalarT tFirst[W];
+    ScalarT tSecond[W];
+    for (auto l = 0; l < W; ++l)
+    {
+        tFirst[l] = tg::min<ScalarT>();
+        tSecond[l] = tg::max<ScalarT>();
+    }
+
+    // project the rays onto each (unnormalized) half extent h, where the box covers the slab dot(center, h) +- dot(h, h)
+    ScalarT origin[W];
+    ScalarT dir[W];
+    ScalarT smin[W];
+    ScalarT smax[W];
+    for (auto i = 0; i < D; ++i)
+    {
+        auto const h = b.half_extents[i];
+        auto const hh = dot(h, h);
+        auto const hc = dot(b.center, h);
+        for (auto l = 0; l < W; ++l)
+        {
+            auto o = ScalarT(0);
+            auto d = ScalarT(0);
+            for (auto j = 0; j < D; ++j)
+            {
+                o += rp.origin[j][l] * h[j];
+                d += rp.dir[j][l] * h[j];
+            }
+            origin[l] = o;
+            dir[l] = d;
+            smin[l] = hc - hh;
+            smax[l] = hc + hh;
+        }
+        detail::packet_clip_slab<ScalarT, W>(origin, dir, smin, smax, tFirst, tSecond);
+    }
+
+    return detail::packet_ray_intervals<ScalarT, W>(tFirst, tSecond);
+}
+
+// packet - plane
+template <int D, class ScalarT, int W>
+[[nodiscard]] constexpr packet_hits<1, ScalarT, W> intersection_parameter(ray_packet<D, ScalarT, W> const& rp, plane<D, ScalarT> const& p)
+{
+    packet_hits<1, ScalarT, W> r;
+    bool hit[W] = {};
+    for (auto l = 0; l < W; ++l)
+    {
+        auto dotND = ScalarT(0);
+        auto dotNO = ScalarT(0);
+        for (auto i = 0; i < D; ++i)
+        {
+            dotND += p.normal[i] * rp.dir[i][l];
+            dotNO += p.normal[i] * rp.origin[i][l];
+        }
+
+        // if plane normal and ray direction are orthogonal, there is no intersection
+        auto const t = (p.dis - dotNO) / (dotND == ScalarT(0) ? ScalarT(1) : dotND);
+        hit[l] = dotND != ScalarT(0) && t >= ScalarT(0);
+        r.t[0][l] = t;
+        r.count[l] = u8(hit[l]);
+    }
+    r.mask = detail::lane_mask<W>(hit);
+    return r;
+}
+
+// packet - sphere_boundary
+template <int D, class ScalarT, int W>
+[[nodiscard]] constexpr packet_hits<2, ScalarT, W> intersection_parameter(ray_packet<D, ScalarT, W> const& rp, sphere_boundary<D, ScalarT> const& s)
+{
+    packet_hits<2, ScalarT, W> r;
+    bool hit[W] = {};
+    auto const r_sqr = s.radius * s.radius;
+    for (auto l = 0; l < W; ++l)
+    {
+        auto t = ScalarT(0);
+        for (auto i = 0; i < D; ++i)
+            t += (s.center[i] - rp.origin[i][l]) * rp.dir[i][l];
+
+        auto d_sqr = ScalarT(0);
+        for (auto i = 0; i < D; ++i)
+            d_sqr += pow2(rp.origin[i][l] + rp.dir[i][l] * t - s.center[i]);
+
+        auto const inside = d_sqr <= r_sqr;
+        auto const dt = sqrt(inside ? r_sqr - d_sqr : ScalarT(0));
+        auto const t0 = t - dt;
+        auto const t1 = t + dt;
+
+        // hits behind the origin are dropped (same as the scalar ray version)
+        auto const cnt = !inside || t1 < ScalarT(0) ? 0 : t0 < ScalarT(0) ? 1 : 2;
+        r.t[0][l] = cnt == 1 ? t1 : t0;
+        r.t[1][l] = t1;
+        r.count[l] = u8(cnt);
+        hit[l] = cnt > 0;
+    }
+    r.mask = detail::lane_mask<W>(hit);
+    return r;
+}
+
+// packet - triangle3
+template <class ScalarT, int W>
+[[nodiscard]] constexpr packet_hits<1, ScalarT, W> intersection_parameter(ray_packet<3, ScalarT, W> const& rp,
+                                                                          triangle<3, ScalarT> const& tri,
+                                                                          dont_deduce<ScalarT> eps = 100 * tg::epsilon<ScalarT>)
+{
+    // two-sided Moeller-Trumbore, see intersection_parameter(line3, triangle3)
+    auto const e1 = tri.pos1 - tri.pos0;
+    auto const e2 = tri.pos2 - tri.pos0;
+
+    packet_hits<1, ScalarT, W> r;
+    bool hit[W] = {};
+    for (auto l = 0; l < W; ++l)
+    {
+        auto const dx = rp.dir[0][l];
+        auto const dy = rp.dir[1][l];
+        auto const dz = rp.dir[2][l];
+
+        // pvec = cross(dir, e2)
+        auto const px = dy * e2.z - dz * e2.y;
+        auto const py = dz * e2.x - dx * e2.z;
+        auto const pz = dx * e2.y - dy * e2.x;
+        auto const det = px * e1.x + py * e1.y + pz * e1.z;
+
+        auto const sgn = det < ScalarT(0) ? ScalarT(-1) : ScalarT(1);
+        auto const adet = det * sgn;
+
+        auto const tx = rp.origin[0][l] - tri.pos0.x;
+        auto const ty = rp.origin[1][l] - tri.pos0.y;
+        auto const tz = rp.origin[2][l] - tri.pos0.z;
+        auto const u = (tx * px + ty * py + tz * pz) * sgn;
+
+        // qvec = cross(tvec, e1)
+        auto const qx = ty * e1.z - tz * e1.y;
+        auto const qy = tz * e1.x - tx * e1.z;
+        auto const qz = tx * e1.y - ty * e1.x;
+        auto const v = (dx * qx + dy * qy + dz * qz) * sgn;
+
+        auto const t = (e2.x * qx + e2.y * qy + e2.z * qz) / (adet < eps ? ScalarT(1) : det);
+
+        hit[l] = adet >= eps && u >= ScalarT(0) && u <= adet && v >= ScalarT(0) && u + v <= adet && t >= ScalarT(0);
+        r.t[0][l] = t;
+        r.count[l] = u8(hit[l]);
+    }
+    r.mask = detail::lane_mask<W>(hit);
+    return r;
+}
+
+
+// ====================================== Derived Packet Functions ======================================
+
+// if hits intersection parameter is available, use the first hit of each lane
+template <int D, class ScalarT, int W, class Obj>
+[[nodiscard]] constexpr auto closest_intersection_parameter(ray_packet<D, ScalarT, W> const& rp, Obj const& obj)
+    -> decltype(intersection_parameter(rp, obj).count, packet_hits<1, ScalarT, W>())
+{
+    auto const hs = intersection_parameter(rp, obj);
+    packet_hits<1, ScalarT, W> r;
+    r.mask = hs.mask;
+    for (auto l = 0; l < W; ++l)
+    {
+        r.t[0][l] = hs.t[0][l];
+        r.count[l] = u8(hs.count[l] > 0);
+    }
+    return r;
+}
+
+// if hit intervals are available, use the start of each lane
+template <int D, class ScalarT, int W, class Obj>
+[[nodiscard]] constexpr auto closest_intersection_parameter(ray_packet<D, ScalarT, W> const& rp, Obj const& obj)
+    -> decltype(intersection_parameter(rp, obj).start, packet_hits<1, ScalarT, W>())
+{
+    auto const hs = intersection_parameter(rp, obj);
+    packet_hits<1, ScalarT, W> r;
+    r.mask = hs.mask;
+    for (auto l = 0; l < W; ++l)
+    {
+        r.t[0][l] = hs.start[l];
+        r.count[l] = u8((hs.mask >> l) & 1u);
+    }
+    return r;
+}
+
+template <int D, class ScalarT, int W, class Obj>
+[[nodiscard]] constexpr auto intersects(ray_packet<D, ScalarT, W> const& rp, Obj const& obj) -> decltype(intersection_parameter(rp, obj).mask)
+{
+    return intersection_parameter(rp, obj).mask;
+}
+} // namespace tg
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <clean-core/vector.hh>
+
 #include <typed-geometry/detail/operators/ops_pos.hh>
+#include <typed-geometry/feature/assert.hh>
 #include <typed-geometry/functions/basic/limits.hh>
+#include <typed-geometry/functions/basic/minmax.hh>
 #include <typed-geometry/functions/vector/math.hh>
 #include <typed-geometry/types/objects/triangle.hh>
 
@@ -13,6 +17,10 @@
  *
  * Enumerates all integer points (tg::ipos2, tg::ipos3, ...) that are contained in the objects
  * (e.g. contains(obj, pos) == true for all enumerated positions)
+ *
+ * rasterize_spans(obj, f) enumerates the same pixels as rasterize(obj, f) but as horizontal runs
+ * f(y, x_begin, x_end, ...) of pixels [x_begin, x_end) in row y, so that consumers can fill whole runs at once.
+ * Interpolants are passed as value at x_begin and change per pixel in +x.
  */
 
 namespace tg
@@ -320,4 +328,210 @@ constexpr void rasterize(triangle<2, ScalarT> const& t, F&& f, tg::vec<2, Scalar
         }
 }
 
+/// F: (int y, int x_begin, int x_end, ScalarT a, ScalarT da) -> void
+/// emits the pixels of rasterize(l, f) as horizontal runs (in segment order, every pixel once)
+/// pixel x of a run has segment parameter a + (x - x_begin) * da
+/// Note: a is linear in the pixel index along the major axis (0 at the first, 1 at the last pixel)
+///       instead of the distance-based parameter of the per-pixel version
+template <class ScalarT, class F>
+constexpr void rasterize_spans(segment<2, ScalarT> const& l, F&& f)
+{
+    // same bresenham as rasterize(segment), see there
+    auto x0 = iround(l.pos0.x);
+    auto x1 = iround(l.pos1.x);
+
+    auto y0 = iround(l.pos0.y);
+    auto y1 = iround(l.pos1.y);
+
+    auto delta_x = x1 - x0;
+    signed char const ix((delta_x > 0) - (delta_x < 0));
+    delta_x = std::abs(delta_x) << 1;
+
+    auto delta_y = y1 - y0;
+    signed char const iy((delta_y > 0) - (delta_y < 0));
+    delta_y = std::abs(delta_y) << 1;
+
+    if (delta_x >= delta_y)
+    {
+        if (x0 == x1)
+        {
+            f(y0, x0, x0 + 1, ScalarT(0), ScalarT(0));
+            return;
+        }
+
+        // x-major: consecutive pixels in the same row form a run
+        auto const xs = x0;
+        auto const da = ScalarT(1) / ScalarT(x1 - x0);
+        auto const emit = [&](int xa, int xb, int y) {
+            auto const lo = tg::min(xa, xb);
+            f(y, lo, tg::max(xa, xb) + 1, ScalarT(lo - xs) * da, da);
+        };
+
+        int error(delta_y - (delta_x >> 1));
+        auto run = x0;
+        while (x0 != x1)
+        {
+            if ((error > 0) || (!error && (ix > 0)))
+            {
+                error -= delta_x;
+                emit(run, x0, y0);
+                y0 += iy;
+                run = x0 + ix;
+            }
+
+            error += delta_y;
+            x0 += ix;
+        }
+        emit(run, x0, y0);
+    }
+    else
+    {
+        // y-major: every row contains a single pixel
+        auto const ys = y0;
+        auto const da = ScalarT(1) / ScalarT(y1 - y0);
+        f(y0, x0, x0 + 1, ScalarT(0), ScalarT(0));
+
+        int error(delta_x - (delta_y >> 1));
+        while (y1 != y0)
+        {
+            if ((error > 0) || (!error && (iy > 0)))
+            {
+                error -= delta_y;
+                x0 += ix;
+            }
+
+            error += delta_x;
+            y0 += iy;
+
+            f(y0, x0, x0 + 1, ScalarT(y0 - ys) * da, ScalarT(0));
+        }
+    }
+}
+
+/// F: (int y, int x_begin, int x_end) -> void
+/// emits the pixels of rasterize(circle, f) as disjoint horizontal runs ordered by y (every pixel once)
+template <class F>
+void rasterize_spans(tg::icircle2 const& circle, F&& f)
+{
+    auto const r = circle.radius;
+    TG_CONTRACT(r >= 0);
+
+    // outline extent [lo, hi] per row of the quadrant x >= 0, y >= 0
+    // (the midpoint circle covers a contiguous range per row)
+    cc::vector<int> lo;
+    cc::vector<int> hi;
+    lo.resize(r + 1);
+    hi.resize(r + 1);
+    for (auto i = 0; i <= r; ++i)
+    {
+        lo[i] = r + 1;
+        hi[i] = -1;
+    }
+    auto const add = [&](int x, int y) {
+        lo[y] = tg::min(lo[y], x);
+        hi[y] = tg::max(hi[y], x);
+    };
+
+    // same midpoint circle as rasterize(icircle2), see there
+    int error = 1 - r;
+    int x = 0;
+    int y = r;
+    int dx = 0;
+    int dy = -2 * r;
+
+    add(0, r);
+    add(r, 0);
+
+    while (x < y)
+    {
+        if (error >= 0)
+        {
+            --y;
+            dy += 2;
+            error += dy;
+        }
+        ++x;
+        dx += 2;
+        error += dx + 1;
+        add(x, y);
+        add(y, x);
+    }
+
+    auto const cx = circle.center.x;
+    auto const row = [&](int oy, int py) {
+        if (hi[oy] < 0)
+            return;
+        if (lo[oy] == 0)
+            f(py, cx - hi[oy], cx + hi[oy] + 1);
+        else
+        {
+            f(py, cx - hi[oy], cx - lo[oy] + 1);
+            f(py, cx + lo[oy], cx + hi[oy] + 1);
+        }
+    };
+    for (auto oy = r; oy > 0; --oy)
+        row(oy, circle.center.y - oy);
+    for (auto oy = 0; oy <= r; ++oy)
+        row(oy, circle.center.y + oy);
+}
+
+/// F: (int y, int x_begin, int x_end, ScalarT a, ScalarT b, ScalarT da, ScalarT db) -> void
+/// emits the pixels of rasterize(t, f, offset) as one horizontal run per row, ordered by y
+/// pixel x of a run has barycentric coordinates a + (x - x_begin) * da and b + (x - x_begin) * db
+/// offset is subpixel offset, e.g. 0.5f means sampling at pixel center
+template <class ScalarT, class F>
+constexpr void rasterize_spans(triangle<2, ScalarT> const& t, F&& f, tg::vec<2, ScalarT> const& offset = tg::vec<2, ScalarT>(0))
+{
+    auto const box = aabb_of(t);
+
+    auto const minPix = ifloor(box.min);
+    auto const maxPix = iceil(box.max);
+
+    // degenerate triangles have no pixel with valid barycentric coordinates
+    auto const area2 = cross(t.pos1 - t.pos0, t.pos2 - t.pos0);
+    if (area2 == ScalarT(0))
+        return;
+
+    auto const sample = [&](int x, int y) { return tg::pos<2, ScalarT>(ScalarT(x), ScalarT(y)) + offset; };
+    auto const inside = [&](int x, int y) {
+        auto const bary = coordinates(t, sample(x, y));
+        return bary[0] >= 0 && bary[1] >= 0 && bary[2] >= 0;
+    };
+
+    // barycentric coordinates are affine, their change per pixel in x is constant
+    ScalarT const d[3] = {(t.pos1.y - t.pos2.y) / area2, (t.pos2.y - t.pos0.y) / area2, (t.pos0.y - t.pos1.y) / area2};
+
+    for (auto y = minPix.y; y <= maxPix.y; ++y)
+    {
+        // analytic x range where all coordinates are >= 0 ...
+        auto const c = coordinates(t, sample(minPix.x, y));
+        auto x_lo = ScalarT(minPix.x);
+        auto x_hi = ScalarT(maxPix.x);
+        for (auto i = 0; i < 3; ++i)
+        {
+            if (d[i] > 0)
+                x_lo = tg::max(x_lo, ScalarT(minPix.x) - c[i] / d[i]);
+            else if (d[i] < 0)
+                x_hi = tg::min(x_hi, ScalarT(minPix.x) - c[i] / d[i]);
+        }
+
+        // ... padded by a pixel and then snapped to the exact per-pixel test
+        auto xb = tg::max(minPix.x, int(iceil(tg::min(x_lo, ScalarT(maxPix.x)))) - 1);
+        auto xe = tg::min(maxPix.x, int(ifloor(tg::max(x_hi, ScalarT(minPix.x)))) + 1);
+        while (xb <= xe && !inside(xb, y))
+            ++xb;
+        while (xe >= xb && !inside(xe, y))
+            --xe;
+        if (xb > xe)
+            continue;
+        while (xb > minPix.x && inside(xb - 1, y))
+            --xb;
+        while (xe < maxPix.x && inside(xe + 1, y))
+            ++xe;
+
+        auto const bary = coordinates(t, sample(xb, y));
+        f(y, xb, xe + 1, bary[0], bary[1], d[0], d[1]);
+    }
+}
+
 } // namespace tg
@@ -0,0 +1,358 @@
+#pragma once
+
+#include <clean-core/vector.hh>
+
+#include <typed-geometry/detail/simd.hh>
+#include <typed-geometry/detail/utility.hh>
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/feature/bezier.hh>
+#include <typed-geometry/functions/basic/minmax.hh>
+#include <typed-geometry/functions/basic/scalar_math.hh>
+#include <typed-geometry/functions/vector/cross.hh>
+#include <typed-geometry/functions/vector/length.hh>
+#include <typed-geometry/functions/vector/perpendicular.hh>
+#include <typed-geometry/types/objects/polygon.hh>
+#include <typed-geometry/types/pos.hh>
+#include <typed-geometry/types/size.hh>
+#include <typed-geometry/types/span.hh>
+
+/**
+ * Anti-aliased coverage rasterization of 2D paths with exact pixel areas (signed-area accumulation, as in font rasterizers)
+ *
+ * Usage:
+ *   tg::coverage_buffer buffer(tg::isize2(256, 256), tile_origin);
+ *   buffer.add_polygon(outer_ring);
+ *   buffer.add_polygon(hole);                // holes with opposite winding (nonzero) or any winding (even_odd)
+ *   buffer.add_bezier(tg::bezier<2, tg::pos2>(p0, p1, p2));
+ *   buffer.add_polyline(road, 3.5f);         // stroke of width 3.5
+ *   buffer.resolve(coverage);                // 8 bit coverage, width * height bytes, row-major
+ *   buffer.clear();                          // reuse for the next tile
+ *
+ *   // one-shot polygon (tg::polygon2 or a span of vertices)
+ *   tg::rasterize_coverage(polygon, coverage, tg::isize2(w, h));
+ *
+ * Algorithm:
+ *   - every line adds, per covered pixel, the signed area between the line and the right border of the tile
+ *     into an accumulation buffer (a line only touches the cells of the rows it crosses)
+ *   - resolve computes a prefix sum per row, the sum at a pixel is its winding-weighted covered area
+ *     (SSE4.1 4-wide prefix sums if available, see detail/simd.hh)
+ *   - curves are flattened into lines with a bound on the distance to the curve
+ *
+ * Notes:
+ *   - pixel (x, y) covers [origin + (x, y), origin + (x + 1, y + 1)], geometry outside of the tile is clipped exactly
+ *   - the geometry added between clear() calls must form closed contours (add_polygon closes its ring implicitly,
+ *     bezier paths must be closed by the caller)
+ *   - nonzero coverage is min(|sum|, 1), even_odd folds the sum into [0, 1] with period 2,
+ *     coverage is exact for non-overlapping contours
+ *   - strokes are unions of segment quads and bevel joins with equal winding, they must be resolved with nonzero
+ *     and are slightly over-covered in pixels where two pieces partially overlap
+ *   - the SIMD resolve sums pairwise and may differ from the scalar path by one coverage step
+ */
+
+namespace tg
+{
+enum class fill_rule
+{
+    nonzero,
+    even_odd
+};
+
+struct coverage_buffer
+{
+    coverage_buffer() = default;
+    explicit coverage_buffer(isize2 size, pos<2, f32> origin = pos<2, f32>::zero) { reset(size, origin); }
+
+    /// resizes the buffer and clears it
+    void reset(isize2 size, pos<2, f32> origin = pos<2, f32>::zero)
+    {
+        TG_CONTRACT(size.width > 0 && size.height > 0);
+        _width = size.width;
+        _height = size.height;
+        _origin = origin;
+        _cells.resize(size_t(_width + 2) * size_t(_height));
+        clear();
+    }
+
+    void clear()
+    {
+        for (auto& c : _cells)
+            c = 0;
+    }
+
+    [[nodiscard]] isize2 size() const { return {_width, _height}; }
+    [[nodiscard]] pos<2, f32> origin() const { return _origin; }
+
+    /// adds a directed line, only closed sets of lines have a meaningful coverage
+    void add_line(pos<2, f32> p0, pos<2, f32> p1)
+    {
+        auto const a = p0 - _origin;
+        auto const b = p1 - _origin;
+        auto const w = f32(_width);
+
+        // split at the left and right tile border, clamping x of the pieces is then exact
+        // (everything left of the tile covers the whole row, everything right of it covers nothing)
+        f32 ts[4] = {0, 0, 0, 0};
+        auto cnt = 1;
+        auto const dx = b.x - a.x;
+        if (dx != 0)
+        {
+            auto const t0 = (0 - a.x) / dx;
+            auto const t1 = (w - a.x) / dx;
+            if (0 < t0 && t0 < 1)
+                ts[cnt++] = t0;
+            if (0 < t1 && t1 < 1)
+                ts[cnt++] = t1;
+            if (cnt == 3 && ts[1] > ts[2])
+                detail::swap(ts[1], ts[2]);
+        }
+        ts[cnt++] = 1;
+
+        auto const at = [&](f32 t) {
+            if (t == 0)
+                return a;
+            if (t == 1)
+                return b;
+            return a + (b - a) * t;
+        };
+        for (auto i = 0; i + 1 < cnt; ++i)
+        {
+            auto const q0 = at(ts[i]);
+            auto const q1 = at(ts[i + 1]);
+            accumulate(tg::clamp(q0.x, 0.f, w), q0.y, tg::clamp(q1.x, 0.f, w), q1.y);
+        }
+    }
+
+    /// adds the closed ring v0, v1, ..., vn-1, v0
+    void add_polygon(span<pos<2, f32> const> vertices)
+    {
+        auto const n = vertices.size();
+        for (size_t i = 0; i < n; ++i)
+            add_line(vertices[i], vertices[i + 1 == n ? 0 : i + 1]);
+    }
+    void add_polygon(polygon<2, f32> const& p) { add_polygon(span<pos<2, f32> const>(p.vertices.data(), p.vertices.size())); }
+
+    /// adds the stroke of width w of the open polyline (butt caps, bevel joins), see notes
+    void add_polyline(span<pos<2, f32> const> vertices, f32 w)
+    {
+        TG_CONTRACT(w >= 0);
+        auto const h = w / 2;
+        auto has_prev = false;
+        vec<2, f32> prev_n;
+        for (size_t i = 0; i + 1 < vertices.size(); ++i)
+        {
+            auto const p = vertices[i];
+            auto const q = vertices[i + 1];
+            auto const l = length(q - p);
+            if (l == 0)
+                continue;
+
+            // all pieces have the same winding so that their overlaps do not cancel
+            auto const n = perpendicular((q - p) / l) * h;
+            add_line(p + n, q + n);
+            add_line(q + n, q - n);
+            add_line(q - n, p - n);
+            add_line(p - n, p + n);
+
+            // bevel on the outer side of the turn, with the same winding as the quads
+            if (has_prev)
+            {
+                auto const turn = cross(prev_n, n);
+                if (turn != 0)
+                {
+                    auto const s = turn > 0 ? -1.f : 1.f;
+                    auto const a = p + prev_n * s;
+                    auto const b = p + n * s;
+                    if (cross(a - p, b - p) < 0)
+                        add_triangle(p, a, b);
+                    else
+                        add_triangle(p, b, a);
+                }
+            }
+            prev_n = n;
+            has_prev = true;
+        }
+    }
+
+    /// adds the curve as lines with a distance of at most tolerance (in pixels) to the curve
+    template <int Degree>
+    void add_bezier(bezier<Degree, pos<2, f32>> const& c, f32 tolerance = 0.1f)
+    {
+        static_assert(Degree >= 1, "curve must have at least two control points");
+        TG_CONTRACT(tolerance > 0);
+
+        // with n uniform steps the chord error is at most max|c''| / (8 n^2) and max|c''| <= D (D - 1) max|second differences|
+        auto m = 0.f;
+        for (auto i = 0; i + 2 <= Degree; ++i)
+        {
+            auto const& cp = c.control_points;
+            m = tg::max(m, length(cp[i] - cp[i + 1] + (cp[i + 2] - cp[i + 1])));
+        }
+        auto const bound = f32(Degree * (Degree - 1)) * m / (8 * tolerance);
+        auto const n = bound <= 1 ? 1 : tg::min(1024, int(tg::iceil(tg::sqrt(bound))));
+
+        auto prev = c.control_points[0];
+        for (auto k = 1; k < n; ++k)
+        {
+            auto const p = c(f32(k) / f32(n));
+            add_line(prev, p);
+            prev = p;
+        }
+        add_line(prev, c.control_points[Degree]);
+    }
+
+    /// writes 8 bit coverage (0 = empty, 255 = covered) of all pixels, row-major with width * height entries
+    void resolve(span<u8> coverage, fill_rule rule = fill_rule::nonzero) const
+    {
+        TG_CONTRACT(coverage.size() >= size_t(_width) * size_t(_height));
+        auto const stride = _width + 2;
+        for (auto y = 0; y < _height; ++y)
+        {
+            auto const row = _cells.data() + size_t(stride) * size_t(y);
+            auto const out = coverage.data() + size_t(_width) * size_t(y);
+            auto x = 0;
+            auto sum = 0.f;
+
+#ifdef TG_SIMD_F32_WIDTH
+            using detail::f32x4;
+            auto carry = f32x4::zero();
+            auto const one = f32x4::broadcast(1.f);
+            for (; x + 4 <= _width; x += 4)
+            {
+                auto const s = simd_prefix_sum(f32x4::load(row + x)) + carry;
+                carry = simd_broadcast_last(s);
+
+                auto a = simd_abs(s);
+                if (rule == fill_rule::even_odd)
+                {
+                    auto const t = a - f32x4::broadcast(2.f) * simd_floor(a * f32x4::broadcast(0.5f));
+                    a = one - simd_abs(t - one);
+                }
+                simd_store_u8(simd_min(a, one) * f32x4::broadcast(255.f) + f32x4::broadcast(0.5f), out + x);
+            }
+            sum = row_sum(carry);
+#endif
+
+            for (; x < _width; ++x)
+            {
+                sum += row[x];
+                out[x] = u8(int(coverage_of(sum, rule) * 255.f + 0.5f));
+            }
+        }
+    }
+
+private:
+    /// adds the signed area of the line (x in [0, width]) right of it to the cells of the rows it crosses
+    void accumulate(f32 x0, f32 y0, f32 x1, f32 y1)
+    {
+        if (y0 == y1)
+            return;
+
+        auto dir = 1.f;
+        if (y0 > y1)
+        {
+            detail::swap(x0, x1);
+            detail::swap(y0, y1);
+            dir = -1.f;
+        }
+
+        auto const w = f32(_width);
+        auto const dxdy = (x1 - x0) / (y1 - y0);
+        auto const h = f32(_height);
+        auto const row_begin = int(tg::ifloor(tg::clamp(y0, 0.f, h)));
+        auto const row_end = int(tg::iceil(tg::clamp(y1, 0.f, h)));
+        auto x = x0 + dxdy * (tg::max(y0, f32(row_begin)) - y0);
+        for (auto y = row_begin; y < row_end; ++y)
+        {
+            auto const y_top = tg::max(f32(y), y0);
+            auto const y_bottom = tg::min(f32(y + 1), y1);
+            // recomputed from the start point so that rows do not drift
+            auto const x_next = y_bottom == y1 ? x1 : x0 + dxdy * (y_bottom - y0);
+            auto const d = (y_bottom - y_top) * dir;
+
+            auto const xa = tg::clamp(tg::min(x, x_next), 0.f, w);
+            auto const xb = tg::clamp(tg::max(x, x_next), 0.f, w);
+            auto const row = _cells.data() + size_t(_width + 2) * size_t(y);
+
+            auto const xa_floor = tg::floor(xa);
+            auto const ia = int(xa_floor);
+            auto const xb_ceil = tg::ceil(xb);
+            auto const ib = int(xb_ceil);
+            if (ib <= ia + 1)
+            {
+                // within one pixel: trapezoid with the mean x of the line
+                auto const xm = (xa + xb) / 2 - xa_floor;
+                row[ia] += d - d * xm;
+                row[ia + 1] += d * xm;
+            }
+            else
+            {
+                // triangle in the first and last pixel, equal steps in between
+                auto const s = 1 / (xb - xa);
+                auto const fa = xa - xa_floor;
+                auto const a0 = s * (1 - fa) * (1 - fa) / 2;
+                auto const fb = xb - xb_ceil + 1;
+                auto const am = s * fb * fb / 2;
+                row[ia] += d * a0;
+                if (ib == ia + 2)
+                    row[ia + 1] += d * (1 - a0 - am);
+                else
+                {
+                    auto const a1 = s * (1.5f - fa);
+                    row[ia + 1] += d * (a1 - a0);
+                    for (auto i = ia + 2; i < ib - 1; ++i)
+                        row[i] += d * s;
+                    auto const a2 = a1 + f32(ib - ia - 3) * s;
+                    row[ib - 1] += d * (1 - a2 - am);
+                }
+                row[ib] += d * am;
+            }
+
+            x = x_next;
+        }
+    }
+
+    void add_triangle(pos<2, f32> a, pos<2, f32> b, pos<2, f32> c)
+    {
+        add_line(a, b);
+        add_line(b, c);
+        add_line(c, a);
+    }
+
+    static f32 coverage_of(f32 sum, fill_rule rule)
+    {
+        auto const a = tg::abs(sum);
+        if (rule == fill_rule::nonzero)
+            return tg::min(a, 1.f);
+        auto const t = a - 2 * tg::floor(a / 2);
+        return tg::min(1 - tg::abs(t - 1), 1.f);
+    }
+
+#ifdef TG_SIMD_F32_WIDTH
+    static f32 row_sum(detail::f32x4 carry)
+    {
+        f32 t[4];
+        carry.store(t);
+        return t[0];
+    }
+#endif
+
+    int _width = 0;
+    int _height = 0;
+    pos<2, f32> _origin = pos<2, f32>::zero;
+    cc::vector<f32> _cells; ///< (width + 2) * height signed areas, the two extra cells catch lines on the right border
+};
+
+/// writes the 8 bit coverage of the closed polygon (pixel (x, y) covers [x, x + 1] x [y, y + 1]) into coverage
+inline void rasterize_coverage(span<pos<2, f32> const> vertices, span<u8> coverage, isize2 size, fill_rule rule = fill_rule::nonzero)
+{
+    coverage_buffer buffer(size);
+    buffer.add_polygon(vertices);
+    buffer.resolve(coverage, rule);
+}
+inline void rasterize_coverage(polygon<2, f32> const& p, span<u8> coverage, isize2 size, fill_rule rule = fill_rule::nonzero)
+{
+    coverage_buffer buffer(size);
+    buffer.add_polygon(p);
+    buffer.resolve(coverage, rule);
+}
+} // namespace tg
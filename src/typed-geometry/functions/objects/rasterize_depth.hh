@@ -0,0 +1,277 @@
+#pragma once
+
+#include <typed-geometry/detail/simd.hh>
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/functions/basic/constants.hh>
+#include <typed-geometry/functions/basic/minmax.hh>
+#include <typed-geometry/functions/basic/scalar_math.hh>
+#include <typed-geometry/types/objects/triangle.hh>
+#include <typed-geometry/types/pos.hh>
+#include <typed-geometry/types/size.hh>
+#include <typed-geometry/types/span.hh>
+
+/**
+ * Tiled half-space rasterization of triangle batches into a depth buffer (e.g. for software occlusion culling)
+ *
+ * Usage:
+ *   // triangles are given in screen space: x, y in pixels, z = depth (smaller is closer), w = clip-space w
+ *   tg::rasterize_depth(triangles, depth, tg::isize2(width, height));
+ *   tg::rasterize_depth(triangles, depth, tg::isize2(width, height), [&](tg::u32 tri, tg::ipos2 p, float z, float a, float b) { ... });
+ *
+ * Algorithm:
+ *   - the screen is traversed in 8x8 tiles, every tile is trivially rejected or accepted by evaluating
+ *     the three edge functions at its corners, only partially covered tiles test the edges per pixel
+ *   - each tile row is evaluated 8 pixels at a time (SSE4.1/AVX2 lanes if available, see detail/simd.hh)
+ *   - depth is interpolated linearly in screen space, a pixel passes if z < depth[x + width * y]
+ *     and the buffer is updated immediately (triangles are processed in order)
+ *
+ * Notes:
+ *   - depth is a caller-owned row-major buffer with at least width * height entries
+ *   - pixels are sampled at their centers (x + 0.5, y + 0.5), both windings are rasterized
+ *   - a top-left style fill rule guarantees that pixels on an edge shared by two triangles are covered exactly once
+ *   - the callback (if any) is invoked for every pixel that passes the depth test with the triangle index,
+ *     the new depth, and the perspective-correct barycentric coordinates a, b of pos0 and pos1
+ *   - all vertices must be in front of the camera (w > 0), clipping is up to the caller
+ *   - the SIMD and scalar paths produce bit-identical results
+ */
+
+namespace tg
+{
+namespace detail
+{
+static constexpr int raster_tile_size = 8;
+
+struct raster_setup
+{
+    // edge i goes from vertex i to vertex i + 1, E_i(x, y) = a_i * x + b_i * y + c_i is >= 0 inside
+    f32 a[3];
+    f32 b[3];
+    f32 c[3];
+    f32 margin[3];   ///< bound on the rounding error of E_i anywhere in the viewport
+    bool owned[3];   ///< if true, pixels with E_i == 0 are inside
+    f32 z[3];        ///< vertex depths
+    f32 inv_w[3];
+    f32 inv_area;
+    int x0, y0, x1, y1; ///< covered pixel range [x0, x1) x [y0, y1), clipped to the viewport
+
+    /// returns false if the triangle covers no pixel center
+    bool init(triangle<4, f32> const& t, int width, int height)
+    {
+        pos<4, f32> const v[3] = {t.pos0, t.pos1, t.pos2};
+        for (auto i = 0; i < 3; ++i)
+        {
+            TG_CONTRACT(v[i].w > 0 && "vertices behind the camera must be clipped");
+            auto const& p = v[i];
+            auto const& q = v[(i + 1) % 3];
+            a[i] = p.y - q.y;
+            b[i] = q.x - p.x;
+            c[i] = p.x * q.y - p.y * q.x;
+            z[i] = v[i].z;
+            inv_w[i] = 1 / v[i].w;
+        }
+
+        // twice the signed area, flipping a clockwise triangle negates every edge function exactly
+        auto area = a[0] * v[2].x + b[0] * v[2].y + c[0];
+        if (!(area != 0)) // also rejects NaN
+            return false;
+        if (area < 0)
+        {
+            area = -area;
+            for (auto i = 0; i < 3; ++i)
+            {
+                a[i] = -a[i];
+                b[i] = -b[i];
+                c[i] = -c[i];
+            }
+        }
+        inv_area = 1 / area;
+
+        for (auto i = 0; i < 3; ++i)
+        {
+            // the two triangles sharing an edge see exactly negated edge functions, so exactly one owns E == 0
+            owned[i] = a[i] > 0 || (a[i] == 0 && b[i] > 0);
+            margin[i] = 8 * tg::epsilon<f32> * (tg::abs(a[i]) * f32(width) + tg::abs(b[i]) * f32(height) + tg::abs(c[i]));
+        }
+
+        // pixel centers inside the bounding box
+        auto const minx = tg::min(v[0].x, tg::min(v[1].x, v[2].x));
+        auto const maxx = tg::max(v[0].x, tg::max(v[1].x, v[2].x));
+        auto const miny = tg::min(v[0].y, tg::min(v[1].y, v[2].y));
+        auto const maxy = tg::max(v[0].y, tg::max(v[1].y, v[2].y));
+        if (maxx < 0.5f || maxy < 0.5f || minx > f32(width) - 0.5f || miny > f32(height) - 0.5f)
+            return false;
+
+        x0 = tg::max(0, int(tg::iceil(minx - 0.5f)));
+        y0 = tg::max(0, int(tg::iceil(miny - 0.5f)));
+        x1 = tg::min(width, int(tg::ifloor(maxx - 0.5f)) + 1);
+        y1 = tg::min(height, int(tg::ifloor(maxy - 0.5f)) + 1);
+        return x0 < x1 && y0 < y1;
+    }
+
+    [[nodiscard]] bool inside(int i, f32 e) const { return owned[i] ? e >= 0 : e > 0; }
+
+    [[nodiscard]] f32 eval(int i, f32 x, f32 y) const { return a[i] * x + b[i] * y + c[i]; }
+
+    [[nodiscard]] f32 depth(f32 e0, f32 e1, f32 e2) const { return (e1 * z[0] + e2 * z[1] + e0 * z[2]) * inv_area; }
+
+    /// calls f with the perspective-correct barycentric coordinates of pos0 and pos1
+    template <class F>
+    void emit(F& f, u32 tri, int px, int py, f32 depth, f32 e0, f32 e1, f32 e2) const
+    {
+        auto const p0 = e1 * inv_area * inv_w[0];
+        auto const p1 = e2 * inv_area * inv_w[1];
+        auto const p2 = e0 * inv_area * inv_w[2];
+        auto const inv_sum = 1 / (p0 + p1 + p2);
+        f(tri, ipos2(px, py), depth, p0 * inv_sum, p1 * inv_sum);
+    }
+};
+
+template <bool Emit, class F>
+void raster_row_scalar(raster_setup const& s, u32 tri, int tx, int py, bool full, f32* row, F& f)
+{
+    auto const y = f32(py) + 0.5f;
+    auto const px0 = tg::max(tx, s.x0);
+    auto const px1 = tg::min(tx + raster_tile_size, s.x1);
+    for (auto px = px0; px < px1; ++px)
+    {
+        auto const x = f32(px) + 0.5f;
+        auto const e0 = s.eval(0, x, y);
+        auto const e1 = s.eval(1, x, y);
+        auto const e2 = s.eval(2, x, y);
+        if (!full && !(s.inside(0, e0) && s.inside(1, e1) && s.inside(2, e2)))
+            continue;
+
+        auto const z = s.depth(e0, e1, e2);
+        if (!(z < row[px]))
+            continue;
+
+        row[px] = z;
+        if constexpr (Emit)
+            s.emit(f, tri, px, py, z, e0, e1, e2);
+    }
+}
+
+#ifdef TG_SIMD_F32_WIDTH
+/// same as raster_row_scalar for a row of 8 pixels that lies completely inside the buffer
+template <bool Emit, class F>
+void raster_row_simd(raster_setup const& s, u32 tri, int tx, int py, bool full, f32* row, F& f)
+{
+    using L = simd_f32;
+    static constexpr f32 lane_centers[8] = {0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f};
+
+    auto const zero = L::zero();
+    auto const y = L::broadcast(f32(py) + 0.5f);
+    auto const lo = L::broadcast(f32(s.x0));
+    auto const hi = L::broadcast(f32(s.x1));
+
+    auto const edge = [&](int i, L x) { return L::broadcast(s.a[i]) * x + L::broadcast(s.b[i]) * y + L::broadcast(s.c[i]); };
+    auto const inside = [&](int i, L e) { return s.owned[i] ? e >= zero : e > zero; };
+
+    for (auto c = 0; c < raster_tile_size; c += L::width)
+    {
+        auto const px = tx + c;
+        auto const x = L::broadcast(f32(px)) + L::load(lane_centers);
+        auto const e0 = edge(0, x);
+        auto const e1 = edge(1, x);
+        auto const e2 = edge(2, x);
+
+        // px + 0.5 > x0 <=> px >= x0
+        auto mask = (x > lo) & (x < hi);
+        if (!full)
+            mask = mask & inside(0, e0) & inside(1, e1) & inside(2, e2);
+
+        auto const z = (e1 * L::broadcast(s.z[0]) + e2 * L::broadcast(s.z[1]) + e0 * L::broadcast(s.z[2])) * L::broadcast(s.inv_area);
+        auto const old = L::load(row + px);
+        auto const pass = mask & (z < old);
+        auto const bits = pass.movemask();
+        if (bits == 0)
+            continue;
+
+        ((pass & z) | and_not(old, pass)).store(row + px);
+
+        if constexpr (Emit)
+        {
+            f32 ze[L::width];
+            f32 ee[3][L::width];
+            z.store(ze);
+            e0.store(ee[0]);
+            e1.store(ee[1]);
+            e2.store(ee[2]);
+            for (auto l = 0; l < L::width; ++l)
+                if (bits & (1 << l))
+                    s.emit(f, tri, px + l, py, ze[l], ee[0][l], ee[1][l], ee[2][l]);
+        }
+    }
+}
+#endif
+
+template <bool Emit, class F>
+void rasterize_depth(span<triangle<4, f32> const> triangles, span<f32> depth, isize2 size, F& f)
+{
+    TG_CONTRACT(size.width >= 0 && size.height >= 0);
+    TG_CONTRACT(depth.size() >= size_t(size.width) * size_t(size.height));
+    TG_CONTRACT(triangles.size() < size_t(u32(-1)));
+
+    auto const ts = raster_tile_size;
+    for (size_t ti = 0; ti < triangles.size(); ++ti)
+    {
+        raster_setup s;
+        if (!s.init(triangles[ti], size.width, size.height))
+            continue;
+
+        for (auto ty = s.y0 - s.y0 % ts; ty < s.y1; ty += ts)
+            for (auto tx = s.x0 - s.x0 % ts; tx < s.x1; tx += ts)
+            {
+                // covered part of the tile, the edge functions are linear so their extremes are at the corners
+                auto const px0 = tg::max(tx, s.x0);
+                auto const px1 = tg::min(tx + ts, s.x1);
+                auto const py0 = tg::max(ty, s.y0);
+                auto const py1 = tg::min(ty + ts, s.y1);
+                auto const cx0 = f32(px0) + 0.5f;
+                auto const cx1 = f32(px1 - 1) + 0.5f;
+                auto const cy0 = f32(py0) + 0.5f;
+                auto const cy1 = f32(py1 - 1) + 0.5f;
+
+                auto reject = false;
+                auto full = true;
+                for (auto i = 0; i < 3; ++i)
+                {
+                    auto const emax = s.eval(i, s.a[i] >= 0 ? cx1 : cx0, s.b[i] >= 0 ? cy1 : cy0);
+                    auto const emin = s.eval(i, s.a[i] >= 0 ? cx0 : cx1, s.b[i] >= 0 ? cy0 : cy1);
+                    reject = reject || emax < -s.margin[i];
+                    full = full && emin > s.margin[i];
+                }
+                if (reject)
+                    continue;
+
+                for (auto py = py0; py < py1; ++py)
+                {
+                    auto const row = depth.data() + size_t(py) * size_t(size.width);
+#ifdef TG_SIMD_F32_WIDTH
+                    if (tx + ts <= size.width)
+                    {
+                        raster_row_simd<Emit>(s, u32(ti), tx, py, full, row, f);
+                        continue;
+                    }
+#endif
+                    raster_row_scalar<Emit>(s, u32(ti), tx, py, full, row, f);
+                }
+            }
+    }
+}
+}
+
+/// rasterizes the triangles (screen-space x, y, depth z, clip-space w) into the depth buffer
+template <class F>
+void rasterize_depth(span<triangle<4, f32> const> triangles, span<f32> depth, isize2 size, F&& f)
+{
+    detail::rasterize_depth<true>(triangles, depth, size, f);
+}
+
+/// depth-only version, e.g. for occlusion culling
+inline void rasterize_depth(span<triangle<4, f32> const> triangles, span<f32> depth, isize2 size)
+{
+    auto no_callback = [](u32, ipos2, f32, f32, f32) {};
+    detail::rasterize_depth<false>(triangles, depth, size, no_callback);
+}
+} // namespace tg
@@ -0,0 +1,527 @@
+#pragma once
+
+#include <utility>
+
+#include <clean-core/optional.hh>
+
+#include <typed-geometry/functions/basic/scalar_math.hh>
+#include <typed-geometry/functions/vector/cross.hh>
+#include <typed-geometry/functions/vector/dot.hh>
+#include <typed-geometry/functions/vector/length.hh>
+#include <typed-geometry/functions/vector/normalize.hh>
+#include <typed-geometry/functions/vector/perpendicular.hh>
+
+#include <typed-geometry/types/objects/aabb.hh>
+#include <typed-geometry/types/objects/box.hh>
+#include <typed-geometry/types/objects/capsule.hh>
+#include <typed-geometry/types/objects/cone.hh>
+#include <typed-geometry/types/objects/cylinder.hh>
+#include <typed-geometry/types/objects/ellipse.hh>
+#include <typed-geometry/types/objects/halfspace.hh>
+#include <typed-geometry/types/objects/hemisphere.hh>
+#include <typed-geometry/types/objects/inf_cone.hh>
+#include <typed-geometry/types/objects/inf_cylinder.hh>
+#include <typed-geometry/types/objects/line.hh>
+#include <typed-geometry/types/objects/plane.hh>
+#include <typed-geometry/types/objects/pyramid.hh>
+#include <typed-geometry/types/objects/ray.hh>
+#include <typed-geometry/types/objects/segment.hh>
+#include <typed-geometry/types/objects/sphere.hh>
+#include <typed-geometry/types/objects/triangle.hh>
+#include <typed-geometry/types/quadric.hh>
+
+#include "apex.hh"
+#include "boundary.hh"
+#include "edges.hh"
+#include "faces.hh"
+#include "intersection.hh"
+#include "normal.hh"
+#include "project.hh"
+
+// ray_cast(ray, obj) -> cc::optional<ray_hit<D, ScalarT>>
+//
+// computes everything a ray tracer typically needs for the closest hit in one go:
+//   - t (ray parameter), position (== ray[t])
+//   - normal: outward geometric surface normal (NOT flipped towards the ray, check dot(hit.normal, ray.dir) < 0 for front faces)
+//   - barycentrics: only for triangles (weights of pos0, pos1, pos2, same as coordinates(tri, hit.position))
+//
+// ray_cast always reports hits with the surface of an object:
+//   for solid objects, a ray starting inside reports the exit point (i.e. ray_cast(r, obj) == ray_cast(r, boundary_of(obj)))
+//
+// normals of objects without an inside (planes, triangles3, 2D lines, rays and segments) are not flipped either,
+// quadrics use the gradient direction of their implicit function (same convention as intersection_parameter)
+//
+// all objects with an intersection_parameter(line, obj) overload are supported
+//
+// Implementation guidelines:
+//   explicit ray_cast(ray, obj) for objects where t and normal can share computations (planes, triangles, spheres, boxes)
+//   otherwise, a detail::ray_cast_normal(obj_boundary, pos) gives ray_cast via closest_intersection_parameter
+//   (objects without boundary_of, e.g. triangle2 and quadric3, forward to it explicitly)
+
+namespace tg
+{
+/// result of a successful ray_cast
+template <int D, class ScalarT>
+struct ray_hit
+{
+    using scalar_t = ScalarT;
+    using pos_t = pos<D, ScalarT>;
+    using dir_t = dir<D, ScalarT>;
+
+    ScalarT t;
+    pos_t position;
+    dir_t normal;
+    cc::optional<comp<3, ScalarT>> barycentrics;
+};
+
+// ====================================== Explicit Ray Casts ======================================
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr cc::optional<ray_hit<D, ScalarT>> ray_cast(ray<D, ScalarT> const& r, plane<D, ScalarT> const& p)
+{
+    auto const denom = dot(p.normal, r.dir);
+    if (denom == ScalarT(0))
+        return {};
+
+    auto const t = (p.dis - dot(p.normal, vec<D, ScalarT>(r.origin))) / denom;
+    if (t < ScalarT(0))
+        return {};
+
+    return ray_hit<D, ScalarT>{t, r[t], p.normal, {}};
+}
+
+// two-sided, same tolerance as intersection_parameter(line3, triangle3)
+template <class ScalarT>
+[[nodiscard]] constexpr cc::optional<ray_hit<3, ScalarT>> ray_cast(ray<3, ScalarT> const& r,
+                                                                   triangle<3, ScalarT> const& tri,
+                                                                   dont_deduce<ScalarT> eps = 100 * tg::epsilon<ScalarT>)
+{
+    auto const e1 = tri.pos1 - tri.pos0;
+    auto const e2 = tri.pos2 - tri.pos0;
+
+    auto const pvec = cross(r.dir, e2);
+    auto const det = dot(pvec, e1);
+    if (abs(det) < eps)
+        return {};
+
+    auto const inv_det = ScalarT(1) / det;
+    auto const tvec = r.origin - tri.pos0;
+    auto const u = dot(tvec, pvec) * inv_det;
+    if (u < ScalarT(0) || u > ScalarT(1))
+        return {};
+
+    auto const qvec = cross(tvec, e1);
+    auto const v = dot(r.dir, qvec) * inv_det;
+    if (v < ScalarT(0) || u + v > ScalarT(1))
+        return {};
+
+    auto const t = dot(e2, qvec) * inv_det;
+    if (t < ScalarT(0))
+        return {};
+
+    return ray_hit<3, ScalarT>{t, r[t], normalize(cross(e1, e2)), comp<3, ScalarT>(ScalarT(1) - u - v, u, v)};
+}
+
+template <int D, class ScalarT, class TraitsT>
+[[nodiscard]] constexpr cc::optional<ray_hit<D, ScalarT>> ray_cast(ray<D, ScalarT> const& r, sphere<D, ScalarT, D, TraitsT> const& s)
+{
+    auto const oc = r.origin - s.center;
+    auto const b = dot(oc, r.dir);
+    auto const c = dot(oc, oc) - s.radius * s.radius;
+    auto const disc = b * b - c;
+    if (disc < ScalarT(0))
+        return {};
+
+    auto const sq = sqrt(disc);
+    auto t = -b - sq;
+    if (t < ScalarT(0))
+        t = -b + sq;
+    if (t < ScalarT(0))
+        return {};
+
+    auto const p = r[t];
+    return ray_hit<D, ScalarT>{t, p, normalize(p - s.center), {}};
+}
+
+namespace detail
+{
+/// slab test that tracks which face is hit
+/// axes[i] are the unit axes of the slabs, [-extents[i], extents[i]] their range relative to the origin
+/// NOTE: only works for mutually orthogonal axes
+template <int D, class ScalarT>
+constexpr cc::optional<ray_hit<D, ScalarT>> ray_cast_slabs(ray<D, ScalarT> const& r, pos<D, ScalarT> const& local_origin, vec<D, ScalarT> const& local_dir, ScalarT const* extents, dir<D, ScalarT> const* axes)
+{
+    auto tNear = tg::min<ScalarT>();
+    auto tFar = tg::max<ScalarT>();
+    auto nearAxis = 0;
+    auto farAxis = 0;
+
+    for (auto i = 0; i < D; ++i)
+    {
+        auto const o = local_origin[i];
+        auto const d = local_dir[i];
+        if (d == ScalarT(0))
+        {
+            if (o < -extents[i] || o > extents[i])
+                return {};
+            continue;
+        }
+
+        auto const inv = ScalarT(1) / d;
+        auto t0 = (-extents[i] - o) * inv;
+        auto t1 = (extents[i] - o) * inv;
+        if (t0 > t1)
+            std::swap(t0, t1);
+
+        if (t0 > tNear)
+        {
+            tNear = t0;
+            nearAxis = i;
+        }
+        if (t1 < tFar)
+        {
+            tFar = t1;
+            farAxis = i;
+        }
+    }
+
+    if (tNear > tFar || tFar < ScalarT(0))
+        return {};
+
+    // entering hit if in front of the origin, otherwise the exit hit
+    auto const entering = tNear >= ScalarT(0);
+    auto const t = entering ? tNear : tFar;
+    auto const axis = entering ? nearAxis : farAxis;
+    auto const toward_max = (local_dir[axis] > ScalarT(0)) != entering;
+
+    return ray_hit<D, ScalarT>{t, r[t], toward_max ? axes[axis] : -axes[axis], {}};
+}
+}
+
+template <int D, class ScalarT, class TraitsT>
+[[nodiscard]] constexpr cc::optional<ray_hit<D, ScalarT>> ray_cast(ray<D, ScalarT> const& r, aabb<D, ScalarT, TraitsT> const& b)
+{
+    auto const c = centroid_of(b);
+    ScalarT extents[D];
+    dir<D, ScalarT> axes[D];
+    for (auto i = 0; i < D; ++i)
+    {
+        extents[i] = (b.max[i] - b.min[i]) * ScalarT(0.5);
+        auto e = vec<D, ScalarT>::zero;
+        e[i] = ScalarT(1);
+        axes[i] = dir<D, ScalarT>(e);
+    }
+    return detail::ray_cast_slabs(r, pos<D, ScalarT>(r.origin - c), vec<D, ScalarT>(r.dir), extents, axes);
+}
+
+template <int D, class ScalarT, class TraitsT>
+[[nodiscard]] constexpr cc::optional<ray_hit<D, ScalarT>> ray_cast(ray<D, ScalarT> const& r, box<D, ScalarT, D, TraitsT> const& b)
+{
+    auto const oc = r.origin - b.center;
+    ScalarT extents[D];
+    dir<D, ScalarT> axes[D];
+    pos<D, ScalarT> local_origin;
+    vec<D, ScalarT> local_dir;
+    for (auto i = 0; i < D; ++i)
+    {
+        extents[i] = length(b.half_extents[i]);
+        axes[i] = normalize(b.half_extents[i]);
+        local_origin[i] = dot(oc, axes[i]);
+        local_dir[i] = dot(r.dir, axes[i]);
+    }
+    return detail::ray_cast_slabs(r, local_origin, local_dir, extents, axes);
+}
+
+// planar objects embedded in 3D have a constant normal
+template <class ScalarT>
+[[nodiscard]] constexpr cc::optional<ray_hit<3, ScalarT>> ray_cast(ray<3, ScalarT> const& r, sphere<2, ScalarT, 3> const& d)
+{
+    if (auto const t = closest_intersection_parameter(r, d); t.has_value())
+        return ray_hit<3, ScalarT>{t.value(), r[t.value()], normal_of(d), {}};
+    return {};
+}
+template <class ScalarT>
+[[nodiscard]] constexpr cc::optional<ray_hit<3, ScalarT>> ray_cast(ray<3, ScalarT> const& r, box<2, ScalarT, 3> const& b)
+{
+    if (auto const t = closest_intersection_parameter(r, b); t.has_value())
+        return ray_hit<3, ScalarT>{t.value(), r[t.value()], normal_of(b), {}};
+    return {};
+}
+template <class ScalarT>
+[[nodiscard]] constexpr cc::optional<ray_hit<3, ScalarT>> ray_cast(ray<3, ScalarT> const& r, ellipse<2, ScalarT, 3> const& e)
+{
+    if (auto const t = closest_intersection_parameter(r, e); t.has_value())
+        return ray_hit<3, ScalarT>{t.value(), r[t.value()], normal_of(e), {}};
+    return {};
+}
+
+// so do 2D lines, rays and segments
+template <class ScalarT>
+[[nodiscard]] constexpr cc::optional<ray_hit<2, ScalarT>> ray_cast(ray<2, ScalarT> const& r, line<2, ScalarT> const& l)
+{
+    if (auto const t = closest_intersection_parameter(r, l); t.has_value())
+        return ray_hit<2, ScalarT>{t.value(), r[t.value()], normal_of(l), {}};
+    return {};
+}
+template <class ScalarT>
+[[nodiscard]] constexpr cc::optional<ray_hit<2, ScalarT>> ray_cast(ray<2, ScalarT> const& r, ray<2, ScalarT> const& target)
+{
+    if (auto const t = closest_intersection_parameter(r, target); t.has_value())
+        return ray_hit<2, ScalarT>{t.value(), r[t.value()], normal_of(target), {}};
+    return {};
+}
+template <class ScalarT>
+[[nodiscard]] constexpr cc::optional<ray_hit<2, ScalarT>> ray_cast(ray<2, ScalarT> const& r, segment<2, ScalarT> const& s)
+{
+    if (auto const t = closest_intersection_parameter(r, s); t.has_value())
+        return ray_hit<2, ScalarT>{t.value(), r[t.value()], normal_of(s), {}};
+    return {};
+}
+
+// ====================================== Surface Normals ======================================
+
+namespace detail
+{
+// outward normal of the boundary at a position p that lies on the boundary (up to numerical precision)
+
+template <class ScalarT>
+[[nodiscard]] constexpr dir<3, ScalarT> ray_cast_normal(capsule_boundary<3, ScalarT> const& c, pos<3, ScalarT> const& p)
+{
+    return normalize(p - project(p, c.axis));
+}
+
+template <class ScalarT>
+[[nodiscard]] constexpr dir<3, ScalarT> ray_cast_normal(cylinder_boundary_no_caps<3, ScalarT> const& c, pos<3, ScalarT> const& p)
+{
+    return normalize(p - project(p, inf_of(c.axis)));
+}
+
+template <class ScalarT>
+[[nodiscard]] constexpr dir<3, ScalarT> ray_cast_normal(cylinder_boundary<3, ScalarT> const& c, pos<3, ScalarT> const& p)
+{
+    // pick the closest of the three surfaces (mantle, bottom cap, top cap)
+    auto const axis = c.axis.pos1 - c.axis.pos0;
+    auto const len = length(axis);
+    auto const a = axis / len;
+    auto const h = dot(p - c.axis.pos0, a);
+    auto const radial = (p - c.axis.pos0) - a * h;
+    auto const dMantle = abs(length(radial) - c.radius);
+    auto const dBottom = abs(h);
+    auto const dTop = abs(h - len);
+
+    if (dBottom < dMantle && dBottom <= dTop)
+        return dir<3, ScalarT>(-a);
+    if (dTop < dMantle)
+        return dir<3, ScalarT>(a);
+    return normalize(radial);
+}
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr dir<D, ScalarT> ray_cast_normal(inf_cylinder_boundary<D, ScalarT> const& c, pos<D, ScalarT> const& p)
+{
+    return normalize(p - project(p, c.axis));
+}
+
+/// mantle normal of the infinite cone with unit axis a and cos^2 of the half opening angle
+template <int D, class ScalarT>
+[[nodiscard]] constexpr dir<D, ScalarT> ray_cast_cone_normal(pos<D, ScalarT> const& apex, dir<D, ScalarT> const& a, ScalarT cos2, pos<D, ScalarT> const& p)
+{
+    // negative gradient of dot(v, a)^2 - cos2 * |v|^2 (positive inside)
+    auto const v = p - apex;
+    auto const n = v * cos2 - a * dot(v, a);
+    if (n == vec<D, ScalarT>::zero) // apex (or a degenerate cone)
+        return -a;
+    return normalize(n);
+}
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr dir<D, ScalarT> ray_cast_normal(inf_cone_boundary<D, ScalarT> const& c, pos<D, ScalarT> const& p)
+{
+    return ray_cast_cone_normal(c.apex, c.opening_dir, pow2(cos(c.opening_angle * ScalarT(0.5))), p);
+}
+
+template <class ScalarT>
+[[nodiscard]] constexpr dir<3, ScalarT> ray_cast_normal(cone_boundary_no_caps<3, ScalarT> const& c, pos<3, ScalarT> const& p)
+{
+    // same opening direction and angle as intersection_parameter(line3, cone_boundary_no_caps3)
+    auto const r2 = pow2(c.base.radius);
+    auto const h2 = pow2(c.height);
+    return ray_cast_cone_normal(apex_of(c), dir<3, ScalarT>(-normal_of(c.base)), h2 / (h2 + r2), p);
+}
+
+template <class ScalarT>
+[[nodiscard]] constexpr dir<3, ScalarT> ray_cast_normal(cone_boundary<3, ScalarT> const& c, pos<3, ScalarT> const& p)
+{
+    // pick the closer of base and mantle
+    auto const a = dir<3, ScalarT>(-normal_of(c.base));
+    auto const l = sqrt(pow2(c.base.radius) + pow2(c.height));
+    auto const sinA = c.base.radius / l;
+    auto const cosA = c.height / l;
+    auto const v = p - apex_of(c);
+    auto const h = dot(v, a);
+    auto const dMantle = abs(length(v - a * h) * cosA - h * sinA);
+    auto const dBase = abs(h - c.height);
+
+    if (dBase < dMantle)
+        return a;
+    return ray_cast_normal(boundary_no_caps_of(c), p);
+}
+
+/// normal of the mantle face of the pyramid closest to p (facing away from the base centroid), d is its distance to p
+template <class BaseT>
+[[nodiscard]] constexpr dir<3, typename BaseT::scalar_t> ray_cast_pyramid_mantle_normal(pyramid_boundary_no_caps<BaseT> const& py,
+                                                                                       pos<3, typename BaseT::scalar_t> const& p,
+                                                                                       typename BaseT::scalar_t& d)
+{
+    using ScalarT = typename BaseT::scalar_t;
+    auto const inner = centroid_of(py.base);
+    auto best = dir<3, ScalarT>();
+    d = tg::max<ScalarT>();
+    for (auto const& f : faces_of(py))
+    {
+        auto n = normal_of(f);
+        if (dot(n, inner - f.pos0) > ScalarT(0))
+            n = -n;
+        auto const df = abs(dot(p - f.pos0, n));
+        if (df < d)
+        {
+            d = df;
+            best = n;
+        }
+    }
+    return best;
+}
+
+template <class BaseT>
+[[nodiscard]] constexpr dir<3, typename BaseT::scalar_t> ray_cast_normal(pyramid_boundary_no_caps<BaseT> const& py, pos<3, typename BaseT::scalar_t> const& p)
+{
+    typename BaseT::scalar_t d;
+    return ray_cast_pyramid_mantle_normal(py, p, d);
+}
+
+template <class BaseT>
+[[nodiscard]] constexpr dir<3, typename BaseT::scalar_t> ray_cast_normal(pyramid_boundary<BaseT> const& py, pos<3, typename BaseT::scalar_t> const& p)
+{
+    using ScalarT = typename BaseT::scalar_t;
+
+    // the base faces away from the apex
+    auto const c = centroid_of(py.base);
+    auto n = normal_of(py.base);
+    if (dot(n, apex_of(py) - c) > ScalarT(0))
+        n = -n;
+
+    ScalarT dMantle;
+    auto const nMantle = ray_cast_pyramid_mantle_normal(boundary_no_caps_of(py), p, dMantle);
+    return abs(dot(p - c, n)) < dMantle ? n : nMantle;
+}
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr dir<D, ScalarT> ray_cast_normal(hemisphere_boundary_no_caps<D, ScalarT> const& h, pos<D, ScalarT> const& p)
+{
+    return normalize(p - h.center);
+}
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr dir<D, ScalarT> ray_cast_normal(hemisphere_boundary<D, ScalarT> const& h, pos<D, ScalarT> const& p)
+{
+    auto const pc = p - h.center;
+    auto const dCap = abs(dot(pc, h.normal));
+    auto const dDome = abs(length(pc) - h.radius);
+    return dCap < dDome ? -h.normal : normalize(pc);
+}
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr dir<D, ScalarT> ray_cast_normal(ellipse_boundary<D, ScalarT> const& e, pos<D, ScalarT> const& p)
+{
+    // gradient of sum_i (dot(p - c, a_i) / |a_i|^2)^2
+    auto const pc = p - e.center;
+    auto g = vec<D, ScalarT>::zero;
+    for (auto i = 0; i < D; ++i)
+    {
+        auto const axis2 = dot(e.semi_axes[i], e.semi_axes[i]);
+        g += e.semi_axes[i] * (dot(pc, e.semi_axes[i]) / (axis2 * axis2));
+    }
+    return normalize(g);
+}
+
+template <class ScalarT>
+[[nodiscard]] constexpr dir<2, ScalarT> ray_cast_normal(triangle<2, ScalarT> const& t, pos<2, ScalarT> const& p)
+{
+    // closest edge, perpendicular facing away from the opposite vertex
+    pos<2, ScalarT> const opposite[3] = {t.pos2, t.pos0, t.pos1};
+    auto const edges = edges_of(t);
+    auto best = dir<2, ScalarT>();
+    auto bestDist = tg::max<ScalarT>();
+    for (auto i = 0; i < 3; ++i)
+    {
+        auto n = perpendicular(normalize(edges[i].pos1 - edges[i].pos0));
+        if (dot(n, opposite[i] - edges[i].pos0) > ScalarT(0))
+            n = -n;
+        auto const d = abs(dot(p - edges[i].pos0, n));
+        if (d < bestDist)
+        {
+            bestDist = d;
+            best = n;
+        }
+    }
+    return best;
+}
+
+template <class ScalarT>
+[[nodiscard]] constexpr dir<3, ScalarT> ray_cast_normal(quadric<3, ScalarT> const& q, pos<3, ScalarT> const& p)
+{
+    // gradient of x^T A x + 2 b^T x + c, the form used by intersection_parameter(line3, quadric3)
+    return normalize(q.A() * vec<3, ScalarT>(p) + q.b());
+}
+}
+
+// ====================================== Ray Casts without boundary_of ======================================
+
+// triangle2 is solid: rays starting inside report the exit point
+template <class ScalarT>
+[[nodiscard]] constexpr cc::optional<ray_hit<2, ScalarT>> ray_cast(ray<2, ScalarT> const& r, triangle<2, ScalarT> const& tri)
+{
+    auto const inter = intersection_parameter(inf_of(r), tri);
+    if (!inter.has_value() || inter.value().end < ScalarT(0))
+        return {};
+
+    auto const t = inter.value().start >= ScalarT(0) ? inter.value().start : inter.value().end;
+    auto const p = r[t];
+    return ray_hit<2, ScalarT>{t, p, detail::ray_cast_normal(tri, p), {}};
+}
+
+template <class ScalarT>
+[[nodiscard]] constexpr cc::optional<ray_hit<3, ScalarT>> ray_cast(ray<3, ScalarT> const& r, quadric<3, ScalarT> const& q)
+{
+    auto const t = closest_intersection_parameter(r, q);
+    if (!t.has_value())
+        return {};
+
+    auto const p = r[t.value()];
+    return ray_hit<3, ScalarT>{t.value(), p, detail::ray_cast_normal(q, p), {}};
+}
+
+// ====================================== Ray Casts from Intersections ======================================
+
+// boundary objects with a surface normal: closest intersection + normal
+template <int D, class ScalarT, class Obj>
+[[nodiscard]] constexpr auto ray_cast(ray<D, ScalarT> const& r, Obj const& obj)
+    -> enable_if<std::is_same_v<Obj, decltype(boundary_of(obj))>,
+                 decltype(detail::ray_cast_normal(obj, r.origin), closest_intersection_parameter(r, obj), cc::optional<ray_hit<D, ScalarT>>())>
+{
+    auto const t = closest_intersection_parameter(r, obj);
+    if (!t.has_value())
+        return {};
+
+    auto const p = r[t.value()];
+    return ray_hit<D, ScalarT>{t.value(), p, detail::ray_cast_normal(obj, p), {}};
+}
+
+// solid objects are ray cast against their boundary
+// (the enable_if is a template parameter so that boundaries do not recurse into the return type)
+template <int D, class ScalarT, class Obj, std::enable_if_t<!std::is_same_v<Obj, decltype(boundary_of(std::declval<Obj const&>()))>, int> = 0>
+[[nodiscard]] constexpr auto ray_cast(ray<D, ScalarT> const& r, Obj const& obj) -> decltype(ray_cast(r, boundary_of(obj)))
+{
+    return ray_cast(r, boundary_of(obj));
+}
+} // namespace tg
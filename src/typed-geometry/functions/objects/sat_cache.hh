@@ -0,0 +1,133 @@
+#pragma once
+
+#include <typed-geometry/functions/vector/cross.hh>
+#include <typed-geometry/types/objects/box.hh>
+#include <typed-geometry/types/objects/triangle.hh>
+#include <typed-geometry/types/vec.hh>
+
+#include "intersection.hh"
+
+// sat_cache<A, B> is a stateful separating axis test for pairs that are tested repeatedly under small motions
+// (e.g. the same two rigid bodies every frame)
+//
+//   tg::sat_cache<tg::box3, tg::box3> cache; // one per persistent pair
+//   ...
+//   if (cache.intersects(a, b)) ...
+//
+// the last separating axis is remembered (as index into the candidate axes) and tested first
+// if it still separates the objects, the query costs a single projection
+// otherwise all candidate axes are tested (starting after the cached one) and the first separating axis is cached
+// the result is always that of the full separating axis test
+//
+// supported pairs:
+//   (box3, box3)      -> 15 candidate axes: 3 + 3 face normals, 9 edge-edge cross products
+//   (box3, triangle3) -> 13 candidate axes: 3 box face normals, triangle normal, 9 edge-edge cross products
+//   (triangle3, box3) -> same as (box3, triangle3)
+
+namespace tg
+{
+template <class A, class B>
+struct sat_cache
+{
+    /// same result as the full separating axis sweep over all candidate axes, but tests the last separating axis first
+    /// (tg::intersects(a, b) may use a different algorithm, e.g. an edge-based test for (box3, triangle3))
+    [[nodiscard]] constexpr bool intersects(A const& a, B const& b);
+
+    /// index of the cached separating axis, -1 if the last query found an intersection (or no query was made yet)
+    [[nodiscard]] constexpr int cached_axis() const { return _axis; }
+
+    /// forgets the cached axis (e.g. if the pair was teleported)
+    constexpr void reset() { _axis = -1; }
+
+private:
+    int _axis = -1;
+};
+
+// ======== IMPLEMENTATION ========
+
+namespace detail
+{
+/// candidate separating axes of a pair of objects, axis(a, b, i) for 0 <= i < count (axes do not need to be normalized)
+template <class A, class B>
+struct sat_axes;
+
+template <class ScalarT>
+struct sat_axes<box<3, ScalarT>, box<3, ScalarT>>
+{
+    static constexpr int count = 15;
+
+    static constexpr vec<3, ScalarT> axis(box<3, ScalarT> const& a, box<3, ScalarT> const& b, int i)
+    {
+        if (i < 3)
+            return a.half_extents[i];
+        if (i < 6)
+            return b.half_extents[i - 3];
+        i -= 6;
+        return cross(a.half_extents[i / 3], b.half_extents[i % 3]);
+    }
+};
+
+template <class ScalarT>
+struct sat_axes<box<3, ScalarT>, triangle<3, ScalarT>>
+{
+    static constexpr int count = 13;
+
+    static constexpr vec<3, ScalarT> axis(box<3, ScalarT> const& b, triangle<3, ScalarT> const& t, int i)
+    {
+        if (i < 3)
+            return b.half_extents[i];
+        if (i == 3)
+            return cross(t.pos1 - t.pos0, t.pos2 - t.pos0);
+        i -= 4;
+        auto const e = i % 3;
+        auto const edge = e == 0 ? t.pos1 - t.pos0 : e == 1 ? t.pos2 - t.pos1 : t.pos0 - t.pos2;
+        return cross(b.half_extents[i / 3], edge);
+    }
+};
+
+template <class ScalarT>
+struct sat_axes<triangle<3, ScalarT>, box<3, ScalarT>>
+{
+    static constexpr int count = 13;
+
+    static constexpr vec<3, ScalarT> axis(triangle<3, ScalarT> const& t, box<3, ScalarT> const& b, int i)
+    {
+        return sat_axes<box<3, ScalarT>, triangle<3, ScalarT>>::axis(b, t, i);
+    }
+};
+
+template <class A, class B>
+[[nodiscard]] constexpr bool sat_separates(A const& a, B const& b, int i)
+{
+    auto const axis = sat_axes<A, B>::axis(a, b, i);
+    return are_separate(shadow(a, axis), shadow(b, axis));
+}
+}
+
+template <class A, class B>
+constexpr bool sat_cache<A, B>::intersects(A const& a, B const& b)
+{
+    constexpr auto count = detail::sat_axes<A, B>::count;
+
+    // temporal coherence: the last separating axis most likely still separates
+    if (_axis >= 0 && detail::sat_separates(a, b, _axis))
+        return false;
+
+    // full sweep, starting after the cached axis (neighbouring axes are often similar)
+    auto const start = _axis + 1;
+    for (auto k = 0; k < count; ++k)
+    {
+        auto const i = (start + k) % count;
+        if (i == _axis)
+            continue;
+        if (detail::sat_separates(a, b, i))
+        {
+            _axis = i;
+            return false;
+        }
+    }
+
+    _axis = -1;
+    return true;
+}
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <typed-geometry/detail/operators/common.hh>
+#include <typed-geometry/detail/operators/ops_pos.hh>
+#include <typed-geometry/detail/operators/ops_vec.hh>
+#include <typed-geometry/functions/basic/scalar_math.hh>
+#include <typed-geometry/functions/vector/dot.hh>
+#include <typed-geometry/functions/vector/length.hh>
+
+#include <typed-geometry/types/objects/aabb.hh>
+#include <typed-geometry/types/objects/box.hh>
+#include <typed-geometry/types/objects/capsule.hh>
+#include <typed-geometry/types/objects/cylinder.hh>
+#include <typed-geometry/types/objects/ellipse.hh>
+#include <typed-geometry/types/objects/hemisphere.hh>
+#include <typed-geometry/types/objects/pyramid.hh>
+#include <typed-geometry/types/objects/quad.hh>
+#include <typed-geometry/types/objects/segment.hh>
+#include <typed-geometry/types/objects/sphere.hh>
+#include <typed-geometry/types/objects/tetrahedron.hh>
+#include <typed-geometry/types/objects/triangle.hh>
+#include <typed-geometry/types/pos.hh>
+#include <typed-geometry/types/vec.hh>
+
+#include "apex.hh"
+#include "centroid.hh"
+#include "normal.hh"
+
+// support_point(obj, d) returns a point p with contains(obj, p) and dot(p, d) maximal
+// (i.e. the farthest point of obj in direction d, d does not have to be normalized)
+//
+// support_point is the customization point for convex objects used by GJK and EPA (see gjk.hh)
+// it is defined for solid objects only (boundaries have the same support point but are not convex)
+//
+// if several points are farthest, any of them may be returned (e.g. for d == 0)
+
+namespace tg
+{
+template <int D, class ScalarT>
+[[nodiscard]] constexpr pos<D, ScalarT> support_point(pos<D, ScalarT> const& p, vec<D, ScalarT> const&)
+{
+    return p;
+}
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr pos<D, ScalarT> support_point(segment<D, ScalarT> const& s, vec<D, ScalarT> const& d)
+{
+    return dot(s.pos1 - s.pos0, d) > ScalarT(0) ? s.pos1 : s.pos0;
+}
+
+namespace detail
+{
+template <int D, class ScalarT, size_t N>
+[[nodiscard]] constexpr pos<D, ScalarT> support_point_of_vertices(pos<D, ScalarT> const (&vertices)[N], vec<D, ScalarT> const& d)
+{
+    auto r = vertices[0];
+    auto rd = dot(vertices[0] - pos<D, ScalarT>::zero, d);
+    for (size_t i = 1; i < N; ++i)
+        if (auto const pd = dot(vertices[i] - pos<D, ScalarT>::zero, d); pd > rd)
+        {
+            r = vertices[i];
+            rd = pd;
+        }
+    return r;
+}
+}
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr pos<D, ScalarT> support_point(triangle<D, ScalarT> const& t, vec<D, ScalarT> const& d)
+{
+    pos<D, ScalarT> const vertices[] = {t.pos0, t.pos1, t.pos2};
+    return detail::support_point_of_vertices(vertices, d);
+}
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr pos<D, ScalarT> support_point(quad<D, ScalarT> const& q, vec<D, ScalarT> const& d)
+{
+    pos<D, ScalarT> const vertices[] = {q.pos00, q.pos10, q.pos11, q.pos01};
+    return detail::support_point_of_vertices(vertices, d);
+}
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr pos<D, ScalarT> support_point(tetrahedron<D, ScalarT> const& t, vec<D, ScalarT> const& d)
+{
+    pos<D, ScalarT> const vertices[] = {t.pos0, t.pos1, t.pos2, t.pos3};
+    return detail::support_point_of_vertices(vertices, d);
+}
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr pos<D, ScalarT> support_point(aabb<D, ScalarT> const& b, vec<D, ScalarT> const& d)
+{
+    auto r = b.min;
+    for (auto i = 0; i < D; ++i)
+        if (d[i] > ScalarT(0))
+            r[i] = b.max[i];
+    return r;
+}
+
+template <int ObjectD, class ScalarT, int DomainD>
+[[nodiscard]] constexpr pos<DomainD, ScalarT> support_point(box<ObjectD, ScalarT, DomainD> const& b, vec<DomainD, ScalarT> const& d)
+{
+    auto r = b.center;
+    for (auto i = 0; i < ObjectD; ++i)
+        r += dot(b.half_extents[i], d) < ScalarT(0) ? -b.half_extents[i] : b.half_extents[i];
+    return r;
+}
+
+template <int ObjectD, class ScalarT, int DomainD>
+[[nodiscard]] constexpr pos<DomainD, ScalarT> support_point(ellipse<ObjectD, ScalarT, DomainD> const& e, vec<DomainD, ScalarT> const& d)
+{
+    // e = { center + semi_axes * u | |u| <= 1 } -> u = normalize(transpose(semi_axes) * d)
+    vec<ObjectD, ScalarT> u;
+    for (auto i = 0; i < ObjectD; ++i)
+        u[i] = dot(e.semi_axes[i], d);
+
+    auto const l = length(u);
+    if (l == ScalarT(0))
+        return e.center;
+
+    auto r = e.center;
+    for (auto i = 0; i < ObjectD; ++i)
+        r += e.semi_axes[i] * (u[i] / l);
+    return r;
+}
+
+namespace detail
+{
+// farthest point of the disk (center, radius, normal) in direction d, also works for 1D disks in 2D
+template <int D, class ScalarT>
+[[nodiscard]] constexpr pos<D, ScalarT> support_point_disk(pos<D, ScalarT> const& center, ScalarT radius, dir<D, ScalarT> const& normal, vec<D, ScalarT> const& d)
+{
+    auto const t = d - normal * dot(d, normal);
+    auto const l = length(t);
+    if (l == ScalarT(0))
+        return center;
+    return center + t * (radius / l);
+}
+}
+
+template <int ObjectD, class ScalarT, int DomainD>
+[[nodiscard]] constexpr pos<DomainD, ScalarT> support_point(sphere<ObjectD, ScalarT, DomainD> const& s, vec<DomainD, ScalarT> const& d)
+{
+    if constexpr (ObjectD == DomainD)
+    {
+        auto const l = length(d);
+        if (l == ScalarT(0))
+            return s.center;
+        return s.center + d * (s.radius / l);
+    }
+    else
+    {
+        static_assert(ObjectD + 1 == DomainD, "only spheres and disks are supported");
+        return detail::support_point_disk(s.center, s.radius, s.normal, d);
+    }
+}
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr pos<D, ScalarT> support_point(hemisphere<D, ScalarT> const& h, vec<D, ScalarT> const& d)
+{
+    // either the sphere support point (if it is on the curved side) or a point on the rim
+    auto const l = length(d);
+    if (l == ScalarT(0))
+        return h.center;
+    if (dot(d, h.normal) >= ScalarT(0))
+        return h.center + d * (h.radius / l);
+    return detail::support_point_disk(h.center, h.radius, h.normal, d);
+}
+
+template <class ScalarT>
+[[nodiscard]] constexpr pos<3, ScalarT> support_point(capsule<3, ScalarT> const& c, vec<3, ScalarT> const& d)
+{
+    auto const p = support_point(c.axis, d);
+    auto const l = length(d);
+    if (l == ScalarT(0))
+        return p;
+    return p + d * (c.radius / l);
+}
+
+template <class ScalarT>
+[[nodiscard]] constexpr pos<3, ScalarT> support_point(cylinder<3, ScalarT> const& c, vec<3, ScalarT> const& d)
+{
+    auto const a = c.axis.pos1 - c.axis.pos0;
+    auto const al = length(a);
+    if (al == ScalarT(0))
+        return c.axis.pos0;
+    return detail::support_point_disk(support_point(c.axis, d), c.radius, dir<3, ScalarT>(a / al), d);
+}
+
+template <class BaseT>
+[[nodiscard]] constexpr pos<3, typename BaseT::scalar_t> support_point(pyramid<BaseT> const& p, vec<3, typename BaseT::scalar_t> const& d)
+{
+    // convex hull of base and apex
+    auto const b = support_point(p.base, d);
+    auto const a = apex_of(p);
+    return dot(a - b, d) > typename BaseT::scalar_t(0) ? a : b;
+}
+}
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <type_traits>
+
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/functions/basic/limits.hh>
+#include <typed-geometry/functions/basic/minmax.hh>
+#include <typed-geometry/functions/basic/scalar_math.hh>
+#include <typed-geometry/types/objects/aabb.hh>
+#include <typed-geometry/types/objects/ray.hh>
+#include <typed-geometry/types/objects/ray_packet.hh>
+#include <typed-geometry/types/objects/segment.hh>
+#include <typed-geometry/types/pos.hh>
+#include <typed-geometry/types/size.hh>
+
+/**
+ * 3D grid traversal (3D DDA, Amanatides & Woo 1987)
+ *
+ * Enumerates every cell of a regular grid that is pierced by a ray or segment, in order along the ray,
+ * together with the ray parameters where the ray enters and leaves the cell.
+ *
+ * Usage:
+ *   // grid with res cells covering grid_bounds, cells are ipos3 in [0, res)
+ *   tg::traverse_grid(ray, grid_bounds, res, [&](tg::ipos3 cell, float t_enter, float t_exit) { ... });
+ *
+ *   // line of sight: returning false stops the traversal, traverse_grid returns false if it was stopped
+ *   auto const visible = tg::traverse_grid(segment, grid_bounds, res, [&](tg::ipos3 c, float, float) { return !occupied(c); });
+ *
+ *   // unbounded grid with cell c = ifloor(p / cell_size), e.g. for hashed grids
+ *   tg::traverse_grid(segment, cell_size, f);
+ *
+ *   // W coherent rays in lockstep, f(lane, cell, t_enter, t_exit)
+ *   tg::traverse_grid(packet, grid_bounds, res, [&](int lane, tg::ipos3 cell, float t_enter, float t_exit) { ... });
+ *
+ * Notes:
+ *   - F may return void (visit all cells) or bool (false stops the traversal, per lane for packets)
+ *   - rays are traversed for t in [0, t_max], segments for t in [0, 1] (t = 0 at pos0)
+ *   - boundaries between cells are computed from the cell index (not accumulated), so long traversals do not drift
+ *   - if the ray passes exactly through an edge or corner of the grid, the cells are entered one axis at a time
+ *     and the intermediate cells are reported with t_enter == t_exit
+ *   - the packet version yields the same cells and parameters per lane as the scalar version
+ */
+
+namespace tg
+{
+namespace detail
+{
+/// calls f(args...), void callbacks never stop the traversal
+template <class F, class... Args>
+bool grid_visit(F& f, Args&&... args)
+{
+    if constexpr (std::is_same_v<decltype(f(args...)), void>)
+    {
+        f(args...);
+        return true;
+    }
+    else
+        return bool(f(args...));
+}
+
+/// traversal state of a single ray
+template <class ScalarT>
+struct grid_dda
+{
+    ipos3 cell;
+    int step[3];
+    ScalarT t_next[3]; ///< ray parameter of the next cell boundary per axis
+    ScalarT t;         ///< entry parameter of the current cell
+    ScalarT t_end;
+
+    ScalarT origin[3];
+    ScalarT inv_dir[3];
+    ScalarT grid_min[3];
+    ScalarT cell_size[3];
+    int res[3]; ///< <= 0 means unbounded
+
+    /// returns false if [t_begin, t_end] misses the grid
+    bool init(pos<3, ScalarT> const& o, vec<3, ScalarT> const& d, pos<3, ScalarT> const& gmin, vec<3, ScalarT> const& cs, isize3 const& r, ScalarT t_begin, ScalarT t_max)
+    {
+        auto const bounded = r.width > 0;
+        int const rs[3] = {r.width, r.height, r.depth};
+        auto t0 = t_begin;
+        auto t1 = t_max;
+        for (auto i = 0; i < 3; ++i)
+        {
+            origin[i] = o[i];
+            grid_min[i] = gmin[i];
+            cell_size[i] = cs[i];
+            res[i] = rs[i];
+            step[i] = d[i] > 0 ? 1 : d[i] < 0 ? -1 : 0;
+            inv_dir[i] = d[i] != 0 ? ScalarT(1) / d[i] : ScalarT(0);
+
+            if (!bounded)
+                continue;
+
+            // slab clipping against the grid bounds
+            auto const lo = gmin[i];
+            auto const hi = gmin[i] + cs[i] * ScalarT(rs[i]);
+            if (d[i] == 0)
+            {
+                if (o[i] < lo || o[i] > hi)
+                    return false;
+                continue;
+            }
+            auto ta = (lo - o[i]) * inv_dir[i];
+            auto tb = (hi - o[i]) * inv_dir[i];
+            if (ta > tb)
+            {
+                auto const tt = ta;
+                ta = tb;
+                tb = tt;
+            }
+            t0 = tg::max(t0, ta);
+            t1 = tg::min(t1, tb);
+        }
+        if (!(t0 <= t1))
+            return false;
+
+        t = t0;
+        t_end = t1;
+        for (auto i = 0; i < 3; ++i)
+        {
+            auto c = int(tg::ifloor((o[i] + d[i] * t0 - gmin[i]) / cs[i]));
+            if (bounded)
+                c = tg::clamp(c, 0, rs[i] - 1);
+            cell[i] = c;
+            t_next[i] = step[i] == 0 ? tg::max<ScalarT>() : boundary(i);
+        }
+        return true;
+    }
+
+    /// ray parameter where the ray leaves the current cell along axis i
+    [[nodiscard]] ScalarT boundary(int i) const
+    {
+        auto const b = grid_min[i] + ScalarT(cell[i] + (step[i] > 0 ? 1 : 0)) * cell_size[i];
+        return (b - origin[i]) * inv_dir[i];
+    }
+
+    [[nodiscard]] int next_axis() const
+    {
+        auto a = t_next[0] < t_next[1] ? 0 : 1;
+        return t_next[2] < t_next[a] ? 2 : a;
+    }
+
+    /// exit parameter of the current cell
+    [[nodiscard]] ScalarT t_exit() const { return tg::max(t, tg::min(t_next[next_axis()], t_end)); }
+
+    /// moves to the next cell, returns false if the ray left the grid or reached t_end
+    bool advance()
+    {
+        auto const a = next_axis();
+        if (t_next[a] >= t_end)
+            return false;
+
+        t = tg::max(t, t_next[a]);
+        cell[a] += step[a];
+        if (res[a] > 0 && (cell[a] < 0 || cell[a] >= res[a]))
+            return false;
+
+        t_next[a] = boundary(a);
+        return true;
+    }
+};
+
+template <class ScalarT, class F>
+bool traverse_grid(grid_dda<ScalarT>& s, F& f)
+{
+    do
+    {
+        if (!grid_visit(f, ipos3(s.cell), s.t, s.t_exit()))
+            return false;
+    } while (s.advance());
+    return true;
+}
+
+template <class ScalarT>
+vec<3, ScalarT> grid_cell_size(aabb<3, ScalarT> const& grid_bounds, isize3 const& res)
+{
+    TG_CONTRACT(res.width > 0 && res.height > 0 && res.depth > 0);
+    auto const ext = grid_bounds.max - grid_bounds.min;
+    return {ext.x / ScalarT(res.width), ext.y / ScalarT(res.height), ext.z / ScalarT(res.depth)};
+}
+}
+
+/// calls f(cell, t_enter, t_exit) for every cell of the grid hit by the ray for t in [0, t_max]
+/// returns false iff f stopped the traversal
+template <class ScalarT, class F>
+bool traverse_grid(ray<3, ScalarT> const& r, aabb<3, ScalarT> const& grid_bounds, isize3 const& res, F&& f, ScalarT t_max = tg::max<ScalarT>())
+{
+    detail::grid_dda<ScalarT> s;
+    if (!s.init(r.origin, vec<3, ScalarT>(r.dir), grid_bounds.min, detail::grid_cell_size(grid_bounds, res), res, ScalarT(0), t_max))
+        return true;
+    return detail::traverse_grid(s, f);
+}
+
+/// calls f(cell, t_enter, t_exit) for every cell of the grid hit by the segment (t = 0 at pos0, t = 1 at pos1)
+/// returns false iff f stopped the traversal
+template <class ScalarT, class F>
+bool traverse_grid(segment<3, ScalarT> const& seg, aabb<3, ScalarT> const& grid_bounds, isize3 const& res, F&& f)
+{
+    detail::grid_dda<ScalarT> s;
+    if (!s.init(seg.pos0, seg.pos1 - seg.pos0, grid_bounds.min, detail::grid_cell_size(grid_bounds, res), res, ScalarT(0), ScalarT(1)))
+        return true;
+    return detail::traverse_grid(s, f);
+}
+
+/// calls f(cell, t_enter, t_exit) for every cell ifloor(p / cell_size) of the unbounded grid hit by the segment
+/// returns false iff f stopped the traversal
+template <class ScalarT, class F>
+bool traverse_grid(segment<3, ScalarT> const& seg, ScalarT cell_size, F&& f)
+{
+    TG_CONTRACT(cell_size > ScalarT(0));
+    detail::grid_dda<ScalarT> s;
+    s.init(seg.pos0, seg.pos1 - seg.pos0, pos<3, ScalarT>::zero, vec<3, ScalarT>(cell_size), isize3(0, 0, 0), ScalarT(0), ScalarT(1));
+    return detail::traverse_grid(s, f);
+}
+
+/// traverses the grid with all lanes of the packet in lockstep (one cell per active lane and step)
+/// calls f(lane, cell, t_enter, t_exit), a lane stops when it leaves the grid, reaches t_max, or f returns false
+/// returns the bitmask of lanes that were stopped by f
+template <class ScalarT, int W, class F>
+u32 traverse_grid(ray_packet<3, ScalarT, W> const& p, aabb<3, ScalarT> const& grid_bounds, isize3 const& res, F&& f, ScalarT t_max = tg::max<ScalarT>())
+{
+    auto const cs = detail::grid_cell_size(grid_bounds, res);
+    int const rs[3] = {res.width, res.height, res.depth};
+
+    // structure-of-arrays state so that the per-step updates are plain loops over the lanes
+    int cell[3][W] = {};
+    int step[3][W] = {};
+    ScalarT t_next[3][W] = {};
+    ScalarT inv_dir[3][W] = {};
+    ScalarT t[W] = {};
+    ScalarT t_end[W] = {};
+
+    u32 active = 0;
+    for (auto l = 0; l < W; ++l)
+    {
+        detail::grid_dda<ScalarT> s;
+        if (!s.init(p.lane(l).origin, vec<3, ScalarT>(p.lane(l).dir), grid_bounds.min, cs, res, ScalarT(0), t_max))
+            continue;
+
+        active |= u32(1) << l;
+        for (auto i = 0; i < 3; ++i)
+        {
+            cell[i][l] = s.cell[i];
+            step[i][l] = s.step[i];
+            t_next[i][l] = s.t_next[i];
+            inv_dir[i][l] = s.inv_dir[i];
+        }
+        t[l] = s.t;
+        t_end[l] = s.t_end;
+    }
+
+    u32 stopped = 0;
+    while (active)
+    {
+        int axis[W];
+        ScalarT t_exit[W];
+        for (auto l = 0; l < W; ++l)
+        {
+            auto const a01 = t_next[0][l] < t_next[1][l] ? 0 : 1;
+            axis[l] = t_next[2][l] < t_next[a01][l] ? 2 : a01;
+            t_exit[l] = tg::max(t[l], tg::min(t_next[axis[l]][l], t_end[l]));
+        }
+
+        for (auto l = 0; l < W; ++l)
+            if ((active >> l) & 1)
+                if (!detail::grid_visit(f, l, ipos3(cell[0][l], cell[1][l], cell[2][l]), t[l], t_exit[l]))
+                {
+                    active &= ~(u32(1) << l);
+                    stopped |= u32(1) << l;
+                }
+
+        for (auto l = 0; l < W; ++l)
+        {
+            auto const a = axis[l];
+            auto const tn = t_next[a][l];
+            auto const c = cell[a][l] + step[a][l];
+            auto const done = tn >= t_end[l] || c < 0 || c >= rs[a];
+            if (done)
+            {
+                active &= ~(u32(1) << l);
+                continue;
+            }
+
+            t[l] = tg::max(t[l], tn);
+            cell[a][l] = c;
+            auto const b = grid_bounds.min[a] + ScalarT(c + (step[a][l] > 0 ? 1 : 0)) * cs[a];
+            t_next[a][l] = (b - p.origin[a][l]) * inv_dir[a][l];
+        }
+    }
+    return stopped;
+}
+} // namespace tg
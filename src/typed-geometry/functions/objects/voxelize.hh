@@ -0,0 +1,223 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include <clean-core/vector.hh>
+
+#include <typed-geometry/detail/parallel.hh>
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/functions/basic/minmax.hh>
+#include <typed-geometry/functions/basic/scalar_math.hh>
+#include <typed-geometry/types/objects/aabb.hh>
+#include <typed-geometry/types/pos.hh>
+#include <typed-geometry/types/size.hh>
+
+#include "aabb.hh"
+#include "contains.hh"
+#include "intersection.hh"
+
+/**
+ * Hierarchical voxelization of arbitrary objects
+ *
+ * Usage:
+ *   // grid with res voxels covering grid_bounds, voxels are ipos3 in [0, res)
+ *   tg::voxelize(obj, grid_bounds, res, [&](tg::ipos3 begin, tg::ipos3 end) {
+ *       // all voxels in [begin, end) overlap obj
+ *       for (auto z = begin.z; z < end.z; ++z)
+ *           for (auto y = begin.y; y < end.y; ++y)
+ *               for (auto x = begin.x; x < end.x; ++x)
+ *                   ...;
+ *   });
+ *
+ * A voxel is reported iff intersects(obj, voxel_aabb) (voxels are closed boxes).
+ *
+ * Algorithm:
+ *   - octree-style subdivision of the voxel block covering aabb_of(obj) (or the whole grid if aabb_of is not available)
+ *   - blocks with !intersects(obj, block) are pruned, blocks with contains(obj, block) are reported as a whole,
+ *     so the cost is proportional to the surface of obj (in voxels) instead of its volume
+ *   - the first levels are expanded breadth-first until there are enough blocks for all threads,
+ *     the remaining subtrees are traversed in parallel
+ *
+ * Notes:
+ *   - requires intersects(obj, aabb3), contains(obj, aabb3) is optional (without it, every voxel is reported individually)
+ *   - the reported blocks are disjoint, f is called from the calling thread after the parallel traversal,
+ *     in a deterministic order
+ */
+
+namespace tg
+{
+namespace detail
+{
+template <class Obj, class ScalarT, class = void>
+struct voxelize_has_contains : std::false_type
+{
+};
+template <class Obj, class ScalarT>
+struct voxelize_has_contains<Obj, ScalarT, std::void_t<decltype(bool(contains(std::declval<Obj const&>(), std::declval<aabb<3, ScalarT> const&>())))>>
+  : std::true_type
+{
+};
+
+template <class Obj, class = void>
+struct voxelize_has_aabb_of : std::false_type
+{
+};
+template <class Obj>
+struct voxelize_has_aabb_of<Obj, std::void_t<decltype(aabb_of(std::declval<Obj const&>()))>> : std::true_type
+{
+};
+
+/// half-open block [begin, end) of voxels
+struct voxel_block
+{
+    ipos3 begin;
+    ipos3 end;
+};
+
+template <class Obj, class ScalarT>
+struct voxelize_octree
+{
+    Obj const& obj;
+    pos<3, ScalarT> grid_min;
+    vec<3, ScalarT> cell_size;
+
+    [[nodiscard]] aabb<3, ScalarT> bounds_of(voxel_block const& b) const
+    {
+        pos<3, ScalarT> lo, hi;
+        for (auto i = 0; i < 3; ++i)
+        {
+            lo[i] = grid_min[i] + ScalarT(b.begin[i]) * cell_size[i];
+            hi[i] = grid_min[i] + ScalarT(b.end[i]) * cell_size[i];
+        }
+        return {lo, hi};
+    }
+
+    /// 0: outside, 1: must be reported as a whole, 2: must be subdivided
+    [[nodiscard]] int classify(voxel_block const& b) const
+    {
+        auto const box = bounds_of(b);
+        if (!intersects(obj, box))
+            return 0;
+
+        auto const single = b.end.x - b.begin.x == 1 && b.end.y - b.begin.y == 1 && b.end.z - b.begin.z == 1;
+        if (single)
+            return 1;
+
+        if constexpr (voxelize_has_contains<Obj, ScalarT>::value)
+            if (contains(obj, box))
+                return 1;
+
+        return 2;
+    }
+
+    /// splits every axis with more than one voxel in half, returns the number of children
+    static int split(voxel_block const& b, voxel_block (&children)[8])
+    {
+        int cuts[3][3];
+        int parts[3];
+        for (auto i = 0; i < 3; ++i)
+        {
+            cuts[i][0] = b.begin[i];
+            if (b.end[i] - b.begin[i] > 1)
+            {
+                cuts[i][1] = b.begin[i] + (b.end[i] - b.begin[i]) / 2;
+                cuts[i][2] = b.end[i];
+                parts[i] = 2;
+            }
+            else
+            {
+                cuts[i][1] = b.end[i];
+                parts[i] = 1;
+            }
+        }
+
+        auto cnt = 0;
+        for (auto z = 0; z < parts[2]; ++z)
+            for (auto y = 0; y < parts[1]; ++y)
+                for (auto x = 0; x < parts[0]; ++x)
+                    children[cnt++] = {{cuts[0][x], cuts[1][y], cuts[2][z]}, {cuts[0][x + 1], cuts[1][y + 1], cuts[2][z + 1]}};
+        return cnt;
+    }
+
+    void traverse(voxel_block const& b, cc::vector<voxel_block>& out) const
+    {
+        auto const c = classify(b);
+        if (c == 0)
+            return;
+        if (c == 1)
+        {
+            out.push_back(b);
+            return;
+        }
+
+        voxel_block children[8];
+        auto const cnt = split(b, children);
+        for (auto i = 0; i < cnt; ++i)
+            traverse(children[i], out);
+    }
+};
+}
+
+/// calls f(begin, end) for disjoint blocks of voxels [begin, end) that cover exactly the voxels overlapping obj
+template <class Obj, class ScalarT, class F>
+void voxelize(Obj const& obj, aabb<3, ScalarT> const& grid_bounds, isize3 const& res, F&& f)
+{
+    TG_CONTRACT(res.width > 0 && res.height > 0 && res.depth > 0);
+
+    auto const ext = grid_bounds.max - grid_bounds.min;
+    auto const cell_size = vec<3, ScalarT>(ext.x / ScalarT(res.width), ext.y / ScalarT(res.height), ext.z / ScalarT(res.depth));
+    auto const tree = detail::voxelize_octree<Obj, ScalarT>{obj, grid_bounds.min, cell_size};
+
+    auto root = detail::voxel_block{ipos3(0, 0, 0), ipos3(res.width, res.height, res.depth)};
+    if constexpr (detail::voxelize_has_aabb_of<Obj>::value)
+    {
+        auto const ob = aabb_of(obj);
+        for (auto i = 0; i < 3; ++i)
+        {
+            auto const n = root.end[i];
+            // voxel j touches [min, max] iff (j + 1) * cell_size >= min and j * cell_size <= max
+            root.begin[i] = tg::clamp(int(tg::iceil((ob.min[i] - grid_bounds.min[i]) / cell_size[i] - ScalarT(1))), 0, n);
+            root.end[i] = tg::clamp(int(tg::ifloor((ob.max[i] - grid_bounds.min[i]) / cell_size[i])) + 1, 0, n);
+            if (root.begin[i] >= root.end[i])
+                return;
+        }
+    }
+
+    // breadth-first until there are enough subtrees for all threads
+    auto const target = size_t(detail::parallel_thread_count()) * 8;
+    cc::vector<detail::voxel_block> blocks;
+    cc::vector<detail::voxel_block> frontier;
+    cc::vector<detail::voxel_block> next;
+    frontier.push_back(root);
+    while (!frontier.empty() && frontier.size() < target)
+    {
+        next.clear();
+        for (auto const& b : frontier)
+        {
+            auto const c = tree.classify(b);
+            if (c == 1)
+                blocks.push_back(b);
+            else if (c == 2)
+            {
+                detail::voxel_block children[8];
+                auto const cnt = tree.split(b, children);
+                for (auto i = 0; i < cnt; ++i)
+                    next.push_back(children[i]);
+            }
+        }
+        std::swap(frontier, next);
+    }
+
+    cc::vector<cc::vector<detail::voxel_block>> subtree_blocks;
+    subtree_blocks.resize(frontier.size());
+    detail::parallel_for(
+        frontier.size(), [&](size_t i) { tree.traverse(frontier[i], subtree_blocks[i]); }, 1);
+
+    for (auto const& b : blocks)
+        f(b.begin, b.end);
+    for (auto const& sb : subtree_blocks)
+        for (auto const& b : sb)
+            f(b.begin, b.end);
+}
+} // namespace tg
@@ -0,0 +1,586 @@
+#pragma once
+
+#include <algorithm>
+
+#include <clean-core/optional.hh>
+#include <clean-core/vector.hh>
+
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/functions/basic/limits.hh>
+#include <typed-geometry/functions/basic/scalar_math.hh>
+#include <typed-geometry/functions/objects/aabb.hh>
+#include <typed-geometry/functions/objects/centroid.hh>
+#include <typed-geometry/functions/objects/intersection.hh>
+#include <typed-geometry/types/objects/aabb.hh>
+#include <typed-geometry/types/objects/ray.hh>
+#include <typed-geometry/types/span.hh>
+
+/**
+ * Bounding volume hierarchy over arbitrary objects
+ *
+ * tg::bvh<ObjT> works for every ObjT that has an aabb_of(obj)
+ * (e.g. triangles, spheres, boxes, segments, or other aabbs)
+ *
+ * Build:
+ *   auto tree = tg::bvh<tg::triangle3>(triangles); // binned SAH build
+ *
+ * Queries:
+ *   tree.closest_hit(ray)                   -> cc::optional<bvh_hit>, requires closest_intersection_parameter(ray, obj)
+ *   tree.any_hit(ray, t_max)                -> bool, same requirement
+ *   tree.for_each_intersecting(obj, f)      -> calls f(idx) for each object with intersects(object, obj), requires intersects(obj, aabb)
+ *
+ * Free functions:
+ *   closest_intersection_parameter(ray, tree), closest_intersection(ray, tree), intersects(ray, tree), intersects(obj, tree), aabb_of(tree)
+ *
+ * Notes:
+ *   - nodes are stored in a flat array, children of an inner node are adjacent (left = first, right = first + 1)
+ *   - objects are copied into leaf order, indices returned by queries refer to the input span
+ *   - the tree is static, rebuild it when objects change
+ */
+
+namespace tg
+{
+template <class ObjT>
+struct bvh;
+
+/// result of a closest-hit ray query
+/// index refers to the span the bvh was built from
+template <class ScalarT>
+struct bvh_hit
+{
+    ScalarT t;
+    u32 index;
+};
+
+/// a single bvh node, padded to (a multiple of) 32 byte
+template <int D, class ScalarT>
+struct alignas(32) bvh_node
+{
+    aabb<D, ScalarT> bounds;
+    u32 first = 0; ///< leaf: index of the first object, inner node: index of the left child (right child is first + 1)
+    u32 count = 0; ///< leaf: number of objects (> 0), inner node: 0
+
+    [[nodiscard]] constexpr bool is_leaf() const { return count > 0; }
+};
+
+
+// ======== IMPLEMENTATION ========
+
+namespace detail
+{
+/// half the surface area (3D), half the perimeter (2D), or the length (1D), which is all that SAH needs
+template <int D, class ScalarT>
+[[nodiscard]] constexpr ScalarT bvh_half_area(aabb<D, ScalarT> const& b)
+{
+    auto const e = b.max - b.min;
+    if constexpr (D == 1)
+        return e.x;
+    else if constexpr (D == 2)
+        return e.x + e.y;
+    else if constexpr (D == 3)
+        return e.x * e.y + e.y * e.z + e.z * e.x;
+    else
+    {
+        auto a = ScalarT(0);
+        for (auto i = 0; i < D; ++i)
+            for (auto j = i + 1; j < D; ++j)
+                a += e[i] * e[j];
+        return a;
+    }
+}
+
+/// aabb that contains nothing and can be extended via bvh_extend
+template <int D, class ScalarT>
+[[nodiscard]] constexpr aabb<D, ScalarT> bvh_empty_aabb()
+{
+    aabb<D, ScalarT> b;
+    b.min = pos<D, ScalarT>(tg::max<ScalarT>());
+    b.max = pos<D, ScalarT>(tg::min<ScalarT>());
+    return b;
+}
+template <int D, class ScalarT>
+constexpr void bvh_extend(aabb<D, ScalarT>& b, aabb<D, ScalarT> const& o)
+{
+    b.min = min(b.min, o.min);
+    b.max = max(b.max, o.max);
+}
+template <int D, class ScalarT>
+constexpr void bvh_extend(aabb<D, ScalarT>& b, pos<D, ScalarT> const& p)
+{
+    b.min = min(b.min, p);
+    b.max = max(b.max, p);
+}
+
+/// precomputed ray data for fast slab tests against node bounds
+template <int D, class ScalarT>
+struct bvh_ray
+{
+    pos<D, ScalarT> origin;
+    vec<D, ScalarT> inv_dir;
+
+    explicit bvh_ray(ray<D, ScalarT> const& r) : origin(r.origin)
+    {
+        // avoid 0 * inf = nan for axis-parallel rays
+        for (auto i = 0; i < D; ++i)
+        {
+            auto const d = r.dir[i];
+            auto const tiny = ScalarT(1e-20);
+            inv_dir[i] = ScalarT(1) / (abs(d) < tiny ? (d < ScalarT(0) ? -tiny : tiny) : d);
+        }
+    }
+
+    /// returns the entry parameter into b or tg::max if b is missed (or entered behind t_max)
+    [[nodiscard]] ScalarT entry(aabb<D, ScalarT> const& b, ScalarT t_max) const
+    {
+        auto tNear = ScalarT(0);
+        auto tFar = t_max;
+        for (auto i = 0; i < D; ++i)
+        {
+            auto const t0 = (b.min[i] - origin[i]) * inv_dir[i];
+            auto const t1 = (b.max[i] - origin[i]) * inv_dir[i];
+            tNear = tg::max(tNear, tg::min(t0, t1));
+            tFar = tg::min(tFar, tg::max(t0, t1));
+        }
+        return tNear <= tFar ? tNear : tg::max<ScalarT>();
+    }
+};
+
+/// maximum traversal stack size, the builder limits the tree depth accordingly
+static constexpr int bvh_max_stack_size = 128;
+static constexpr int bvh_max_sah_depth = 64;
+static constexpr int bvh_bin_count = 16;
+}
+
+template <class ObjT>
+struct bvh
+{
+    using object_t = ObjT;
+    using aabb_t = decltype(aabb_of(std::declval<ObjT const&>()));
+    using scalar_t = typename aabb_t::scalar_t;
+    using pos_t = typename aabb_t::pos_t;
+
+    static constexpr int dimension = object_traits<aabb_t>::domain_dimension;
+
+    using node_t = bvh_node<dimension, scalar_t>;
+    using hit_t = bvh_hit<scalar_t>;
+
+    // ctors
+public:
+    bvh() = default;
+
+    /// builds the hierarchy using a binned SAH (surface area heuristic) build
+    /// leaves contain at most max_leaf_size objects (unless objects cannot be separated)
+    explicit bvh(span<ObjT const> objects, int max_leaf_size = 4) { build(objects, max_leaf_size); }
+
+    void build(span<ObjT const> objects, int max_leaf_size = 4);
+
+    // accessors
+public:
+    [[nodiscard]] bool empty() const { return _objects.empty(); }
+    [[nodiscard]] size_t size() const { return _objects.size(); }
+
+    [[nodiscard]] span<node_t const> nodes() const { return {_nodes.data(), _nodes.size()}; }
+    /// objects in leaf order
+    [[nodiscard]] span<ObjT const> objects() const { return {_objects.data(), _objects.size()}; }
+    /// indices()[i] is the input index of objects()[i]
+    [[nodiscard]] span<u32 const> indices() const { return {_indices.data(), _indices.size()}; }
+
+    [[nodiscard]] aabb_t bounds() const
+    {
+        TG_CONTRACT(!empty());
+        return _nodes[0].bounds;
+    }
+
+    // queries
+public:
+    /// closest intersection of the ray with any object
+    [[nodiscard]] cc::optional<hit_t> closest_hit(ray<dimension, scalar_t> const& r, scalar_t t_max = tg::max<scalar_t>()) const;
+
+    /// true iff the ray intersects any object with 0 <= t <= t_max (e.g. for shadow rays)
+    [[nodiscard]] bool any_hit(ray<dimension, scalar_t> const& r, scalar_t t_max = tg::max<scalar_t>()) const;
+
+    /// calls f(idx) for every object that intersects obj (idx refers to the input span)
+    /// F may return bool, in which case returning false stops the traversal
+    template <class Obj, class F>
+    void for_each_intersecting(Obj const& obj, F&& f) const;
+
+    /// true iff any object intersects obj
+    template <class Obj>
+    [[nodiscard]] bool intersects_any(Obj const& obj) const
+    {
+        auto found = false;
+        for_each_intersecting(obj, [&found](u32) {
+            found = true;
+            return false;
+        });
+        return found;
+    }
+
+private:
+    cc::vector<node_t> _nodes;
+    cc::vector<ObjT> _objects;
+    cc::vector<u32> _indices;
+};
+
+template <class ObjT>
+void bvh<ObjT>::build(span<ObjT const> objects, int max_leaf_size)
+{
+    TG_CONTRACT(max_leaf_size >= 1);
+    TG_CONTRACT(objects.size() < size_t(tg::max<u32>()));
+
+    _nodes.clear();
+    _objects.clear();
+    _indices.clear();
+
+    auto const n = u32(objects.size());
+    if (n == 0)
+        return;
+
+    constexpr int D = dimension;
+    using ScalarT = scalar_t;
+
+    // per-object bounds and centroids
+    cc::vector<aabb_t> boxes;
+    cc::vector<pos_t> centers;
+    boxes.reserve(n);
+    centers.reserve(n);
+    _indices.reserve(n);
+    auto rootBounds = detail::bvh_empty_aabb<D, ScalarT>();
+    for (u32 i = 0; i < n; ++i)
+    {
+        auto const bb = aabb_of(objects[i]);
+        boxes.push_back(bb);
+        centers.push_back(centroid_of(bb));
+        _indices.push_back(i);
+        detail::bvh_extend(rootBounds, bb);
+    }
+
+    _nodes.reserve(2 * (n / u32(max_leaf_size) + 1));
+    _nodes.push_back(node_t{rootBounds, 0, n});
+
+    struct task
+    {
+        u32 node;
+        int depth;
+    };
+    cc::vector<task> tasks;
+    tasks.push_back({0, 0});
+
+    struct bin
+    {
+        aabb_t bounds;
+        u32 count;
+    };
+
+    while (!tasks.empty())
+    {
+        auto const tsk = tasks.back();
+        tasks.pop_back();
+
+        auto const first = _nodes[tsk.node].first;
+        auto const count = _nodes[tsk.node].count;
+        if (count <= u32(max_leaf_size))
+            continue; // stays a leaf
+
+        auto const begin = _indices.data() + first;
+        auto const end = begin + count;
+
+        auto centerBounds = detail::bvh_empty_aabb<D, ScalarT>();
+        for (auto it = begin; it != end; ++it)
+            detail::bvh_extend(centerBounds, centers[*it]);
+
+        // find best split via binned SAH
+        auto bestCost = tg::max<ScalarT>();
+        auto bestAxis = -1;
+        auto bestSplit = 0;
+        if (tsk.depth < detail::bvh_max_sah_depth)
+        {
+            for (auto axis = 0; axis < D; ++axis)
+            {
+                auto const cmin = centerBounds.min[axis];
+                auto const extent = centerBounds.max[axis] - cmin;
+                if (!(extent > ScalarT(0)))
+                    continue;
+
+                bin bins[detail::bvh_bin_count];
+                for (auto& b : bins)
+                    b = {detail::bvh_empty_aabb<D, ScalarT>(), 0};
+
+                auto const scale = ScalarT(detail::bvh_bin_count) / extent;
+                for (auto it = begin; it != end; ++it)
+                {
+                    auto const bi = tg::min(int((centers[*it][axis] - cmin) * scale), detail::bvh_bin_count - 1);
+                    bins[bi].count++;
+                    detail::bvh_extend(bins[bi].bounds, boxes[*it]);
+                }
+
+                // sweep from the right to get suffix costs, then from the left
+                ScalarT rightCost[detail::bvh_bin_count] = {};
+                auto acc = detail::bvh_empty_aabb<D, ScalarT>();
+                u32 accCount = 0;
+                for (auto i = detail::bvh_bin_count - 1; i > 0; --i)
+                {
+                    detail::bvh_extend(acc, bins[i].bounds);
+                    accCount += bins[i].count;
+                    rightCost[i] = accCount == 0 ? ScalarT(0) : detail::bvh_half_area(acc) * ScalarT(accCount);
+                }
+
+                acc = detail::bvh_empty_aabb<D, ScalarT>();
+                accCount = 0;
+                for (auto i = 0; i < detail::bvh_bin_count - 1; ++i)
+                {
+                    detail::bvh_extend(acc, bins[i].bounds);
+                    accCount += bins[i].count;
+                    if (accCount == 0 || accCount == count)
+                        continue;
+
+                    auto const cost = detail::bvh_half_area(acc) * ScalarT(accCount) + rightCost[i + 1];
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = i + 1;
+                    }
+                }
+            }
+        }
+
+        u32* mid;
+        if (bestAxis >= 0)
+        {
+            auto const cmin = centerBounds.min[bestAxis];
+            auto const scale = ScalarT(detail::bvh_bin_count) / (centerBounds.max[bestAxis] - cmin);
+            mid = std::partition(begin, end, [&](u32 i) {
+                return tg::min(int((centers[i][bestAxis] - cmin) * scale), detail::bvh_bin_count - 1) < bestSplit;
+            });
+        }
+        else
+        {
+            // degenerate centroids or too deep: median split along the largest extent
+            auto axis = 0;
+            for (auto i = 1; i < D; ++i)
+                if (centerBounds.max[i] - centerBounds.min[i] > centerBounds.max[axis] - centerBounds.min[axis])
+                    axis = i;
+
+            mid = begin + count / 2;
+            std::nth_element(begin, mid, end, [&](u32 a, u32 b) { return centers[a][axis] < centers[b][axis]; });
+        }
+
+        TG_INTERNAL_ASSERT(begin < mid && mid < end);
+
+        auto leftBounds = detail::bvh_empty_aabb<D, ScalarT>();
+        auto rightBounds = detail::bvh_empty_aabb<D, ScalarT>();
+        for (auto it = begin; it != mid; ++it)
+            detail::bvh_extend(leftBounds, boxes[*it]);
+        for (auto it = mid; it != end; ++it)
+            detail::bvh_extend(rightBounds, boxes[*it]);
+
+        auto const leftCount = u32(mid - begin);
+        auto const left = u32(_nodes.size());
+        _nodes.push_back(node_t{leftBounds, first, leftCount});
+        _nodes.push_back(node_t{rightBounds, first + leftCount, count - leftCount});
+
+        _nodes[tsk.node].first = left;
+        _nodes[tsk.node].count = 0;
+
+        tasks.push_back({left, tsk.depth + 1});
+        tasks.push_back({left + 1, tsk.depth + 1});
+    }
+
+    // store objects in leaf order for cache-friendly traversal
+    _objects.reserve(n);
+    for (auto i : _indices)
+        _objects.push_back(objects[i]);
+}
+
+template <class ObjT>
+cc::optional<typename bvh<ObjT>::hit_t> bvh<ObjT>::closest_hit(ray<dimension, scalar_t> const& r, scalar_t t_max) const
+{
+    if (_nodes.empty())
+        return {};
+
+    auto const dr = detail::bvh_ray<dimension, scalar_t>(r);
+    auto bestT = t_max;
+    auto bestIdx = u32(-1);
+
+    u32 stack[detail::bvh_max_stack_size];
+    scalar_t stackT[detail::bvh_max_stack_size];
+    auto stackSize = 0;
+
+    auto const rootT = dr.entry(_nodes[0].bounds, bestT);
+    if (rootT == tg::max<scalar_t>())
+        return {};
+    stack[stackSize] = 0;
+    stackT[stackSize++] = rootT;
+
+    while (stackSize > 0)
+    {
+        --stackSize;
+        if (stackT[stackSize] > bestT)
+            continue;
+
+        auto const& node = _nodes[stack[stackSize]];
+        if (node.is_leaf())
+        {
+            for (auto i = node.first; i < node.first + node.count; ++i)
+            {
+                auto const t = closest_intersection_parameter(r, _objects[i]);
+                if (t.has_value() && t.value() <= bestT)
+                {
+                    bestT = t.value();
+                    bestIdx = i;
+                }
+            }
+        }
+        else
+        {
+            auto const tl = dr.entry(_nodes[node.first].bounds, bestT);
+            auto const tr = dr.entry(_nodes[node.first + 1].bounds, bestT);
+            auto const hitL = tl != tg::max<scalar_t>();
+            auto const hitR = tr != tg::max<scalar_t>();
+
+            TG_ASSERT(stackSize + 2 <= detail::bvh_max_stack_size);
+
+            // push the farther child first so that the nearer one is visited first
+            if (hitL && hitR)
+            {
+                auto const nearL = tl <= tr;
+                stack[stackSize] = nearL ? node.first + 1 : node.first;
+                stackT[stackSize++] = nearL ? tr : tl;
+                stack[stackSize] = nearL ? node.first : node.first + 1;
+                stackT[stackSize++] = nearL ? tl : tr;
+            }
+            else if (hitL)
+            {
+                stack[stackSize] = node.first;
+                stackT[stackSize++] = tl;
+            }
+            else if (hitR)
+            {
+                stack[stackSize] = node.first + 1;
+                stackT[stackSize++] = tr;
+            }
+        }
+    }
+
+    if (bestIdx == u32(-1))
+        return {};
+
+    return hit_t{bestT, _indices[bestIdx]};
+}
+
+template <class ObjT>
+bool bvh<ObjT>::any_hit(ray<dimension, scalar_t> const& r, scalar_t t_max) const
+{
+    if (_nodes.empty())
+        return false;
+
+    auto const dr = detail::bvh_ray<dimension, scalar_t>(r);
+
+    u32 stack[detail::bvh_max_stack_size];
+    auto stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        auto const& node = _nodes[stack[--stackSize]];
+        if (dr.entry(node.bounds, t_max) == tg::max<scalar_t>())
+            continue;
+
+        if (node.is_leaf())
+        {
+            for (auto i = node.first; i < node.first + node.count; ++i)
+            {
+                auto const t = closest_intersection_parameter(r, _objects[i]);
+                if (t.has_value() && t.value() <= t_max)
+                    return true;
+            }
+        }
+        else
+        {
+            TG_ASSERT(stackSize + 2 <= detail::bvh_max_stack_size);
+            stack[stackSize++] = node.first + 1;
+            stack[stackSize++] = node.first;
+        }
+    }
+
+    return false;
+}
+
+template <class ObjT>
+template <class Obj, class F>
+void bvh<ObjT>::for_each_intersecting(Obj const& obj, F&& f) const
+{
+    if (_nodes.empty())
+        return;
+
+    u32 stack[detail::bvh_max_stack_size];
+    auto stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        auto const& node = _nodes[stack[--stackSize]];
+        if (!intersects(obj, node.bounds))
+            continue;
+
+        if (node.is_leaf())
+        {
+            for (auto i = node.first; i < node.first + node.count; ++i)
+            {
+                if (!intersects(_objects[i], obj))
+                    continue;
+
+                if constexpr (std::is_same_v<decltype(f(_indices[i])), bool>)
+                {
+                    if (!f(_indices[i]))
+                        return;
+                }
+                else
+                    f(_indices[i]);
+            }
+        }
+        else
+        {
+            TG_ASSERT(stackSize + 2 <= detail::bvh_max_stack_size);
+            stack[stackSize++] = node.first + 1;
+            stack[stackSize++] = node.first;
+        }
+    }
+}
+
+
+// ====================================== Free Functions ======================================
+
+template <class ObjT>
+[[nodiscard]] typename bvh<ObjT>::aabb_t aabb_of(bvh<ObjT> const& b)
+{
+    return b.bounds();
+}
+
+// gives closest_intersection(ray, bvh) via the default implementation
+template <int D, class ScalarT, class ObjT>
+[[nodiscard]] cc::optional<ScalarT> closest_intersection_parameter(ray<D, ScalarT> const& r, bvh<ObjT> const& b)
+{
+    if (auto const hit = b.closest_hit(r); hit.has_value())
+        return hit.value().t;
+    return {};
+}
+
+template <int D, class ScalarT, class ObjT>
+[[nodiscard]] bool intersects(ray<D, ScalarT> const& r, bvh<ObjT> const& b)
+{
+    return b.any_hit(r);
+}
+
+template <class Obj, class ObjT>
+[[nodiscard]] bool intersects(Obj const& obj, bvh<ObjT> const& b)
+{
+    return b.intersects_any(obj);
+}
+template <int D, class ScalarT, class ObjT>
+[[nodiscard]] bool intersects(aabb<D, ScalarT> const& bb, bvh<ObjT> const& b)
+{
+    return b.intersects_any(bb);
+}
+} // namespace tg
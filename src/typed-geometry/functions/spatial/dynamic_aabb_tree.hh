@@ -0,0 +1,667 @@
+#pragma once
+
+#include <type_traits>
+
+#include <clean-core/vector.hh>
+
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/functions/basic/limits.hh>
+#include <typed-geometry/functions/basic/scalar_math.hh>
+#include <typed-geometry/functions/objects/aabb.hh>
+#include <typed-geometry/functions/objects/intersection.hh>
+#include <typed-geometry/types/objects/aabb.hh>
+#include <typed-geometry/types/objects/ray.hh>
+#include <typed-geometry/types/span.hh>
+
+#include "bvh.hh"
+
+/**
+ * Incrementally updated AABB tree for moving objects (broadphase)
+ *
+ * In contrast to tg::bvh and tg::lbvh, objects can be inserted, moved and removed individually:
+ *   - every leaf stores a fat aabb (the object bounds enlarged by a margin and the predicted displacement)
+ *   - moving an object only touches the tree if its bounds leave the fat aabb
+ *   - insertion picks the sibling with the cheapest surface area increase (Catto, Box2D b2DynamicTree)
+ *   - tree rotations after every insert/remove keep the tree height-balanced (AVL)
+ *
+ * Usage:
+ *   auto tree = tg::dynamic_aabb_tree<3, float>(0.1f);   // fat margin
+ *   auto id = tree.insert(obj);                          // any obj with aabb_of(obj)
+ *   tree.move(id, obj, velocity * dt);                   // true if the leaf was reinserted
+ *   tree.update_pairs([](u32 a, u32 b) { ... });         // new candidate pairs (fat bounds) involving moved objects
+ *   tree.remove(id);
+ *
+ * Queries:
+ *   tree.for_each_intersecting(obj, f)  -> calls f(id) for each object whose bounds intersect obj, requires intersects(obj, aabb)
+ *   tree.raycast(ray, f, t_max)         -> calls f(id, t) for each object whose bounds are entered by the ray at t <= t_max
+ *   tree.for_each_pair(f)               -> calls f(a, b) once for every pair of objects with overlapping bounds
+ *   tree.update_pairs(f)                -> calls f(a, b) for every pair with overlapping fat aabbs that involves an object
+ *                                          inserted or reinserted since the last call
+ *
+ * Notes:
+ *   - ids are stable until the object is removed and are reused afterwards
+ *   - queries use the fat aabbs for inner nodes and the tight object bounds for leaves,
+ *     except update_pairs, which compares fat aabbs (see below)
+ *   - update_pairs is conservative: fat aabbs only change on reinsertion, so any two objects whose tight bounds
+ *     overlap at some point have been reported by an update_pairs call since the later of their (re)insertions
+ *     (keep the pairs and drop them once their tight bounds or fat aabbs no longer overlap, as in Box2D)
+ *   - F may return bool (for_each_intersecting: false stops the traversal) or ScalarT (raycast: new t_max)
+ */
+
+namespace tg
+{
+template <int D, class ScalarT>
+struct dynamic_aabb_tree;
+
+/// ids of free nodes, missing parents or children
+static constexpr u32 dynamic_aabb_tree_null = u32(-1);
+
+template <int D, class ScalarT>
+struct dynamic_aabb_tree_node
+{
+    aabb<D, ScalarT> bounds;                  ///< fat bounds (leaf) or union of the children (inner node)
+    u32 parent = dynamic_aabb_tree_null;      ///< free node: next free node
+    u32 child1 = dynamic_aabb_tree_null;      ///< leaf: dynamic_aabb_tree_null
+    u32 child2 = dynamic_aabb_tree_null;      ///< leaf: dynamic_aabb_tree_null
+    i32 height = -1;                          ///< leaf: 0, free node: -1
+
+    [[nodiscard]] constexpr bool is_leaf() const { return child1 == dynamic_aabb_tree_null; }
+};
+
+template <int D, class ScalarT>
+struct dynamic_aabb_tree
+{
+    using scalar_t = ScalarT;
+    using aabb_t = aabb<D, ScalarT>;
+    using vec_t = vec<D, ScalarT>;
+    using ray_t = ray<D, ScalarT>;
+    using node_t = dynamic_aabb_tree_node<D, ScalarT>;
+
+    // ctors
+public:
+    /// margin is added on every side of the object bounds to form the fat aabb
+    explicit dynamic_aabb_tree(ScalarT margin = ScalarT(0.1)) : _margin(margin) { TG_CONTRACT(margin >= ScalarT(0)); }
+
+    // modification
+public:
+    /// inserts an object and returns its id
+    template <class Obj>
+    u32 insert(Obj const& obj)
+    {
+        return insert_bounds(aabb_of(obj), vec_t::zero);
+    }
+
+    /// removes the object with the given id (the id may be reused by later inserts)
+    void remove(u32 id);
+
+    /// updates the bounds of an object, displacement is the expected motion until the next update (enlarges the fat aabb)
+    /// returns true if the object left its fat aabb and was reinserted
+    template <class Obj>
+    bool move(u32 id, Obj const& obj, vec_t const& displacement = vec_t::zero)
+    {
+        return move_bounds(id, aabb_of(obj), displacement);
+    }
+
+    void clear();
+
+    // accessors
+public:
+    [[nodiscard]] bool empty() const { return _leaf_count == 0; }
+    [[nodiscard]] size_t size() const { return _leaf_count; }
+
+    /// height of the root (0 for a single object, -1 if empty)
+    [[nodiscard]] int height() const { return _root == dynamic_aabb_tree_null ? -1 : _nodes[_root].height; }
+
+    [[nodiscard]] ScalarT margin() const { return _margin; }
+
+    /// all nodes including free ones (height -1), leaf nodes are indexed by object id
+    [[nodiscard]] span<node_t const> nodes() const { return {_nodes.data(), _nodes.size()}; }
+    [[nodiscard]] u32 root() const { return _root; }
+
+    /// tight bounds of the object as given to insert/move
+    [[nodiscard]] aabb_t const& bounds_of(u32 id) const
+    {
+        TG_CONTRACT(is_valid_id(id));
+        return _tight[id];
+    }
+    /// fat bounds of the object as stored in the tree
+    [[nodiscard]] aabb_t const& fat_bounds_of(u32 id) const
+    {
+        TG_CONTRACT(is_valid_id(id));
+        return _nodes[id].bounds;
+    }
+
+    [[nodiscard]] aabb_t bounds() const
+    {
+        TG_CONTRACT(!empty());
+        return _nodes[_root].bounds;
+    }
+
+    // queries
+public:
+    /// calls f(id) for every object whose bounds intersect obj
+    template <class Obj, class F>
+    void for_each_intersecting(Obj const& obj, F&& f) const;
+
+    template <class Obj>
+    [[nodiscard]] bool intersects_any(Obj const& obj) const
+    {
+        auto found = false;
+        for_each_intersecting(obj, [&found](u32) {
+            found = true;
+            return false;
+        });
+        return found;
+    }
+
+    /// calls f(id, t) for every object whose bounds are entered by the ray at 0 <= t <= t_max (in no particular order)
+    /// if F returns ScalarT, the result is used as the new t_max (e.g. the exact hit parameter of the object)
+    template <class F>
+    void raycast(ray_t const& r, F&& f, ScalarT t_max = tg::max<ScalarT>()) const;
+
+    /// calls f(a, b) with a < b for every pair of objects whose bounds intersect
+    template <class F>
+    void for_each_pair(F&& f) const;
+
+    /// calls f(a, b) with a < b for every pair of objects whose fat aabbs intersect and where a or b
+    /// was inserted or reinserted (see move) since the last call, then resets the moved state
+    template <class F>
+    void update_pairs(F&& f);
+
+private:
+    [[nodiscard]] bool is_valid_id(u32 id) const { return id < _nodes.size() && _nodes[id].height == 0; }
+
+    u32 insert_bounds(aabb_t const& b, vec_t const& displacement);
+    bool move_bounds(u32 id, aabb_t const& b, vec_t const& displacement);
+
+    [[nodiscard]] aabb_t fatten(aabb_t const& b, vec_t const& displacement) const;
+
+    u32 allocate_node();
+    void free_node(u32 n);
+
+    void insert_leaf(u32 leaf);
+    void remove_leaf(u32 leaf);
+
+    /// recomputes bounds and heights from n up to the root, rebalancing on the way
+    void refit_upwards(u32 n);
+
+    /// performs a rotation if the children of n differ in height by more than 1, returns the new root of the subtree
+    u32 balance(u32 n);
+
+    /// FatLeaves: leaves are tested with their fat aabb instead of the tight object bounds
+    template <bool FatLeaves = false, class Obj, class F>
+    void query(Obj const& obj, F& f) const;
+
+    ScalarT _margin;
+    u32 _root = dynamic_aabb_tree_null;
+    u32 _free = dynamic_aabb_tree_null;
+    size_t _leaf_count = 0;
+    cc::vector<node_t> _nodes;
+    cc::vector<aabb_t> _tight; ///< tight bounds per leaf node
+    cc::vector<u8> _moved;     ///< per leaf node: 1 if (re)inserted since the last update_pairs, 2 while update_pairs is running
+    cc::vector<u32> _move_buffer;
+};
+
+
+// ======== IMPLEMENTATION ========
+
+template <int D, class ScalarT>
+void dynamic_aabb_tree<D, ScalarT>::clear()
+{
+    _root = dynamic_aabb_tree_null;
+    _free = dynamic_aabb_tree_null;
+    _leaf_count = 0;
+    _nodes.clear();
+    _tight.clear();
+    _moved.clear();
+    _move_buffer.clear();
+}
+
+template <int D, class ScalarT>
+typename dynamic_aabb_tree<D, ScalarT>::aabb_t dynamic_aabb_tree<D, ScalarT>::fatten(aabb_t const& b, vec_t const& displacement) const
+{
+    auto r = b;
+    for (auto i = 0; i < D; ++i)
+    {
+        r.min[i] -= _margin;
+        r.max[i] += _margin;
+
+        // predictive enlargement in the direction of motion
+        if (displacement[i] < ScalarT(0))
+            r.min[i] += displacement[i];
+        else
+            r.max[i] += displacement[i];
+    }
+    return r;
+}
+
+template <int D, class ScalarT>
+u32 dynamic_aabb_tree<D, ScalarT>::allocate_node()
+{
+    if (_free == dynamic_aabb_tree_null)
+    {
+        _nodes.emplace_back();
+        _tight.emplace_back();
+        _moved.push_back(0);
+        return u32(_nodes.size() - 1);
+    }
+
+    auto const n = _free;
+    _free = _nodes[n].parent;
+    _nodes[n] = node_t{};
+    return n;
+}
+
+template <int D, class ScalarT>
+void dynamic_aabb_tree<D, ScalarT>::free_node(u32 n)
+{
+    _nodes[n].parent = _free;
+    _nodes[n].child1 = dynamic_aabb_tree_null;
+    _nodes[n].child2 = dynamic_aabb_tree_null;
+    _nodes[n].height = -1;
+    _moved[n] = 0;
+    _free = n;
+}
+
+template <int D, class ScalarT>
+u32 dynamic_aabb_tree<D, ScalarT>::insert_bounds(aabb_t const& b, vec_t const& displacement)
+{
+    TG_CONTRACT(_nodes.size() < size_t(dynamic_aabb_tree_null));
+
+    auto const leaf = allocate_node();
+    _nodes[leaf].bounds = fatten(b, displacement);
+    _nodes[leaf].height = 0;
+    _tight[leaf] = b;
+    ++_leaf_count;
+
+    insert_leaf(leaf);
+
+    _moved[leaf] = 1;
+    _move_buffer.push_back(leaf);
+    return leaf;
+}
+
+template <int D, class ScalarT>
+void dynamic_aabb_tree<D, ScalarT>::remove(u32 id)
+{
+    TG_CONTRACT(is_valid_id(id));
+
+    remove_leaf(id);
+    free_node(id);
+    --_leaf_count;
+}
+
+template <int D, class ScalarT>
+bool dynamic_aabb_tree<D, ScalarT>::move_bounds(u32 id, aabb_t const& b, vec_t const& displacement)
+{
+    TG_CONTRACT(is_valid_id(id));
+
+    _tight[id] = b;
+
+    auto const& fat = _nodes[id].bounds;
+    auto inside = true;
+    for (auto i = 0; i < D; ++i)
+        inside = inside && fat.min[i] <= b.min[i] && b.max[i] <= fat.max[i];
+    if (inside)
+        return false;
+
+    remove_leaf(id);
+    _nodes[id].bounds = fatten(b, displacement);
+    insert_leaf(id);
+
+    if (!_moved[id])
+    {
+        _moved[id] = 1;
+        _move_buffer.push_back(id);
+    }
+    return true;
+}
+
+template <int D, class ScalarT>
+void dynamic_aabb_tree<D, ScalarT>::insert_leaf(u32 leaf)
+{
+    if (_root == dynamic_aabb_tree_null)
+    {
+        _root = leaf;
+        _nodes[leaf].parent = dynamic_aabb_tree_null;
+        return;
+    }
+
+    // descend towards the sibling with the smallest surface area increase (branch and bound on the inherited cost)
+    auto const leaf_bounds = _nodes[leaf].bounds;
+    auto idx = _root;
+    while (!_nodes[idx].is_leaf())
+    {
+        auto const& nd = _nodes[idx];
+
+        auto combined = nd.bounds;
+        detail::bvh_extend(combined, leaf_bounds);
+        auto const area = detail::bvh_half_area(nd.bounds);
+        auto const combined_area = detail::bvh_half_area(combined);
+
+        // cost of making a new parent for this node and the leaf, and the minimum cost of pushing the leaf further down
+        auto const cost = ScalarT(2) * combined_area;
+        auto const inheritance_cost = ScalarT(2) * (combined_area - area);
+
+        auto const child_cost = [&](u32 c) {
+            auto b = _nodes[c].bounds;
+            detail::bvh_extend(b, leaf_bounds);
+            auto const a = detail::bvh_half_area(b);
+            return (_nodes[c].is_leaf() ? a : a - detail::bvh_half_area(_nodes[c].bounds)) + inheritance_cost;
+        };
+        auto const cost1 = child_cost(nd.child1);
+        auto const cost2 = child_cost(nd.child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+
+        idx = cost1 < cost2 ? nd.child1 : nd.child2;
+    }
+
+    auto const sibling = idx;
+
+    // new parent for sibling and leaf (allocation may invalidate node references)
+    auto const old_parent = _nodes[sibling].parent;
+    auto const new_parent = allocate_node();
+    auto& np = _nodes[new_parent];
+    np.parent = old_parent;
+    np.bounds = _nodes[sibling].bounds;
+    detail::bvh_extend(np.bounds, leaf_bounds);
+    np.height = _nodes[sibling].height + 1;
+    np.child1 = sibling;
+    np.child2 = leaf;
+
+    if (old_parent == dynamic_aabb_tree_null)
+        _root = new_parent;
+    else if (_nodes[old_parent].child1 == sibling)
+        _nodes[old_parent].child1 = new_parent;
+    else
+        _nodes[old_parent].child2 = new_parent;
+
+    _nodes[sibling].parent = new_parent;
+    _nodes[leaf].parent = new_parent;
+
+    refit_upwards(_nodes[leaf].parent);
+}
+
+template <int D, class ScalarT>
+void dynamic_aabb_tree<D, ScalarT>::remove_leaf(u32 leaf)
+{
+    if (leaf == _root)
+    {
+        _root = dynamic_aabb_tree_null;
+        return;
+    }
+
+    auto const parent = _nodes[leaf].parent;
+    auto const grand_parent = _nodes[parent].parent;
+    auto const sibling = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+
+    // the sibling takes the place of the parent
+    _nodes[sibling].parent = grand_parent;
+    if (grand_parent == dynamic_aabb_tree_null)
+        _root = sibling;
+    else
+    {
+        if (_nodes[grand_parent].child1 == parent)
+            _nodes[grand_parent].child1 = sibling;
+        else
+            _nodes[grand_parent].child2 = sibling;
+    }
+
+    free_node(parent);
+    _nodes[leaf].parent = dynamic_aabb_tree_null;
+
+    refit_upwards(grand_parent);
+}
+
+template <int D, class ScalarT>
+void dynamic_aabb_tree<D, ScalarT>::refit_upwards(u32 n)
+{
+    while (n != dynamic_aabb_tree_null)
+    {
+        n = balance(n);
+
+        auto& nd = _nodes[n];
+        auto const& c1 = _nodes[nd.child1];
+        auto const& c2 = _nodes[nd.child2];
+        nd.height = 1 + tg::max(c1.height, c2.height);
+        nd.bounds = c1.bounds;
+        detail::bvh_extend(nd.bounds, c2.bounds);
+
+        n = nd.parent;
+    }
+}
+
+template <int D, class ScalarT>
+u32 dynamic_aabb_tree<D, ScalarT>::balance(u32 ia)
+{
+    auto& a = _nodes[ia];
+    if (a.is_leaf() || a.height < 2)
+        return ia;
+
+    auto const ib = a.child1;
+    auto const ic = a.child2;
+    auto& b = _nodes[ib];
+    auto& c = _nodes[ic];
+
+    auto const union_of = [this](u32 x, u32 y) {
+        auto r = _nodes[x].bounds;
+        detail::bvh_extend(r, _nodes[y].bounds);
+        return r;
+    };
+
+    // replaces a by its child x (x becomes the parent of a), returns x
+    auto const rotate_up = [&](u32 ix) {
+        auto& x = _nodes[ix];
+        x.parent = a.parent;
+        a.parent = ix;
+        if (x.parent == dynamic_aabb_tree_null)
+            _root = ix;
+        else if (_nodes[x.parent].child1 == ia)
+            _nodes[x.parent].child1 = ix;
+        else
+            _nodes[x.parent].child2 = ix;
+    };
+
+    auto const delta = c.height - b.height;
+
+    if (delta > 1)
+    {
+        // c moves up, a keeps b and the lower child of c, c keeps a and its higher child
+        auto const i_f = c.child1;
+        auto const i_g = c.child2;
+        auto const& f = _nodes[i_f];
+        auto const& g = _nodes[i_g];
+
+        rotate_up(ic);
+        c.child1 = ia;
+
+        auto const keep = f.height > g.height ? i_f : i_g;
+        auto const give = f.height > g.height ? i_g : i_f;
+        c.child2 = keep;
+        a.child2 = give;
+        _nodes[give].parent = ia;
+
+        a.bounds = union_of(ib, give);
+        a.height = 1 + tg::max(b.height, _nodes[give].height);
+        c.bounds = union_of(ia, keep);
+        c.height = 1 + tg::max(a.height, _nodes[keep].height);
+        return ic;
+    }
+
+    if (delta < -1)
+    {
+        // symmetric: b moves up
+        auto const i_d = b.child1;
+        auto const i_e = b.child2;
+        auto const& d = _nodes[i_d];
+        auto const& e = _nodes[i_e];
+
+        rotate_up(ib);
+        b.child1 = ia;
+
+        auto const keep = d.height > e.height ? i_d : i_e;
+        auto const give = d.height > e.height ? i_e : i_d;
+        b.child2 = keep;
+        a.child1 = give;
+        _nodes[give].parent = ia;
+
+        a.bounds = union_of(ic, give);
+        a.height = 1 + tg::max(c.height, _nodes[give].height);
+        b.bounds = union_of(ia, keep);
+        b.height = 1 + tg::max(a.height, _nodes[keep].height);
+        return ib;
+    }
+
+    return ia;
+}
+
+template <int D, class ScalarT>
+template <bool FatLeaves, class Obj, class F>
+void dynamic_aabb_tree<D, ScalarT>::query(Obj const& obj, F& f) const
+{
+    if (_root == dynamic_aabb_tree_null)
+        return;
+
+    // the tree is height-balanced, so the stack never grows beyond its height + 1
+    u32 stack[detail::bvh_max_stack_size];
+    auto stackSize = 0;
+    stack[stackSize++] = _root;
+
+    while (stackSize > 0)
+    {
+        auto const n = stack[--stackSize];
+        auto const& node = _nodes[n];
+        if (!intersects(obj, node.bounds))
+            continue;
+
+        if (node.is_leaf())
+        {
+            if constexpr (!FatLeaves)
+                if (!intersects(obj, _tight[n]))
+                    continue;
+
+            if constexpr (std::is_same_v<decltype(f(n)), bool>)
+            {
+                if (!f(n))
+                    return;
+            }
+            else
+                f(n);
+        }
+        else
+        {
+            TG_ASSERT(stackSize + 2 <= detail::bvh_max_stack_size);
+            stack[stackSize++] = node.child2;
+            stack[stackSize++] = node.child1;
+        }
+    }
+}
+
+template <int D, class ScalarT>
+template <class Obj, class F>
+void dynamic_aabb_tree<D, ScalarT>::for_each_intersecting(Obj const& obj, F&& f) const
+{
+    query(obj, f);
+}
+
+template <int D, class ScalarT>
+template <class F>
+void dynamic_aabb_tree<D, ScalarT>::raycast(ray_t const& r, F&& f, ScalarT t_max) const
+{
+    if (_root == dynamic_aabb_tree_null)
+        return;
+
+    auto const dr = detail::bvh_ray<D, ScalarT>(r);
+
+    u32 stack[detail::bvh_max_stack_size];
+    auto stackSize = 0;
+    stack[stackSize++] = _root;
+
+    while (stackSize > 0)
+    {
+        auto const n = stack[--stackSize];
+        auto const& node = _nodes[n];
+        if (dr.entry(node.bounds, t_max) == tg::max<ScalarT>())
+            continue;
+
+        if (node.is_leaf())
+        {
+            auto const t = dr.entry(_tight[n], t_max);
+            if (t == tg::max<ScalarT>())
+                continue;
+
+            if constexpr (std::is_same_v<decltype(f(n, t)), ScalarT>)
+                t_max = tg::min(t_max, f(n, t));
+            else
+                f(n, t);
+        }
+        else
+        {
+            TG_ASSERT(stackSize + 2 <= detail::bvh_max_stack_size);
+            stack[stackSize++] = node.child2;
+            stack[stackSize++] = node.child1;
+        }
+    }
+}
+
+template <int D, class ScalarT>
+template <class F>
+void dynamic_aabb_tree<D, ScalarT>::for_each_pair(F&& f) const
+{
+    for (u32 a = 0; a < u32(_nodes.size()); ++a)
+    {
+        if (_nodes[a].height != 0)
+            continue;
+
+        // every pair is found from both sides, only report it from the smaller id
+        auto visit = [&](u32 b) {
+            if (b > a)
+                f(a, b);
+        };
+        query(_tight[a], visit);
+    }
+}
+
+template <int D, class ScalarT>
+template <class F>
+void dynamic_aabb_tree<D, ScalarT>::update_pairs(F&& f)
+{
+    for (auto a : _move_buffer)
+    {
+        // removed ids are skipped, reused ids can appear twice and are only handled once (state 2)
+        if (_moved[a] != 1 || _nodes[a].height != 0)
+            continue;
+
+        // pairs of two moved objects are reported from the smaller id
+        auto visit = [&](u32 b) {
+            if (b == a || (_moved[b] != 0 && b < a))
+                return;
+            f(tg::min(a, b), tg::max(a, b));
+        };
+        query<true>(_nodes[a].bounds, visit);
+        _moved[a] = 2;
+    }
+
+    // reset after all queries, the moved state decides which side reports a pair
+    for (auto a : _move_buffer)
+        _moved[a] = 0;
+    _move_buffer.clear();
+}
+
+
+// ====================================== Free Functions ======================================
+
+template <int D, class ScalarT>
+[[nodiscard]] aabb<D, ScalarT> aabb_of(dynamic_aabb_tree<D, ScalarT> const& t)
+{
+    return t.bounds();
+}
+
+template <class Obj, int D, class ScalarT>
+[[nodiscard]] bool intersects(Obj const& obj, dynamic_aabb_tree<D, ScalarT> const& t)
+{
+    return t.intersects_any(obj);
+}
+} // namespace tg
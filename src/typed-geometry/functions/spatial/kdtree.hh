@@ -0,0 +1,488 @@
+#pragma once
+
+#include <algorithm>
+
+#include <clean-core/vector.hh>
+
+#include <typed-geometry/detail/parallel.hh>
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/functions/basic/limits.hh>
+#include <typed-geometry/functions/vector/distance.hh>
+#include <typed-geometry/types/objects/aabb.hh>
+#include <typed-geometry/types/pos.hh>
+#include <typed-geometry/types/span.hh>
+
+#include "bvh.hh"
+
+/**
+ * k-d tree over points for nearest neighbor queries
+ *
+ * Build:
+ *   auto tree = tg::kdtree<3, float>(points); // parallel median split build
+ *
+ * Queries:
+ *   tree.nearest(q)                       -> kdtree_neighbor (closest point, requires !empty())
+ *   tree.nearest_point(q)                 -> the closest point itself
+ *   tree.knn(q, k)                        -> cc::vector<kdtree_neighbor> of the k closest points, sorted by distance
+ *   tree.knn(q, out)                      -> same with k = out.size(), returns the number of found neighbors
+ *   tree.radius_search(q, r)              -> cc::vector<kdtree_neighbor> of all points with distance <= r, sorted by distance
+ *   tree.for_each_in_radius(q, r, f)      -> calls f(idx, distance_sqr) for all points with distance <= r (unsorted)
+ *   tree.knn_batch(queries, k, out)       -> knn for many queries in parallel, out[i * k + j] is the j-th neighbor of queries[i]
+ *
+ * Free functions:
+ *   project(p, tree), closest_points(p, tree), closest_points(tree, p), distance_sqr(p, tree), aabb_of(tree)
+ *
+ * Notes:
+ *   - the tree is balanced (median splits along the axis of largest extent), leaves contain at most kdtree_leaf_size points
+ *   - nodes are stored in a flat array in depth-first order (left child = node + 1)
+ *   - points are copied into leaf order, indices returned by queries refer to the input span
+ *   - knn_batch processes queries in leaf order of the tree so that neighboring queries touch the same memory
+ *   - the tree is static, rebuild it when points change
+ */
+
+namespace tg
+{
+template <int D, class ScalarT>
+struct kdtree;
+
+namespace detail
+{
+template <int D, class ScalarT>
+struct kdtree_build_item;
+}
+
+/// maximum number of points per leaf
+static constexpr size_t kdtree_leaf_size = 16;
+
+/// result of a kdtree neighbor query
+/// index refers to the span the kdtree was built from (u32(-1) for missing neighbors in knn_batch)
+template <class ScalarT>
+struct kdtree_neighbor
+{
+    u32 index;
+    ScalarT distance_sqr;
+};
+
+template <class ScalarT>
+struct kdtree_node
+{
+    ScalarT split = ScalarT(0); ///< inner node: points in the left child have coordinate <= split, in the right one >= split
+    u32 axis = 0;               ///< inner node: split axis
+    u32 first = 0;              ///< leaf: index of the first point, inner node: index of the right child (left child is node + 1)
+    u32 count = 0;              ///< leaf: number of points (> 0), inner node: 0
+
+    [[nodiscard]] constexpr bool is_leaf() const { return count > 0; }
+};
+
+template <int D, class ScalarT>
+struct kdtree
+{
+    using scalar_t = ScalarT;
+    using pos_t = pos<D, ScalarT>;
+    using aabb_t = aabb<D, ScalarT>;
+    using node_t = kdtree_node<ScalarT>;
+    using neighbor_t = kdtree_neighbor<ScalarT>;
+
+    // ctors
+public:
+    kdtree() = default;
+
+    explicit kdtree(span<pos_t const> points) { build(points); }
+
+    /// builds a new tree (top levels are split in parallel)
+    void build(span<pos_t const> points);
+
+    // accessors
+public:
+    [[nodiscard]] bool empty() const { return _points.empty(); }
+    [[nodiscard]] size_t size() const { return _points.size(); }
+
+    /// nodes()[0] is the root (if !empty())
+    [[nodiscard]] span<node_t const> nodes() const { return {_nodes.data(), _nodes.size()}; }
+    /// points in leaf order
+    [[nodiscard]] span<pos_t const> points() const { return {_points.data(), _points.size()}; }
+    /// indices()[i] is the input index of points()[i]
+    [[nodiscard]] span<u32 const> indices() const { return {_indices.data(), _indices.size()}; }
+
+    [[nodiscard]] aabb_t const& bounds() const
+    {
+        TG_CONTRACT(!empty());
+        return _bounds;
+    }
+
+    // queries
+public:
+    [[nodiscard]] neighbor_t nearest(pos_t const& q) const
+    {
+        auto n = nearest_slot(q);
+        n.index = _indices[n.index];
+        return n;
+    }
+
+    /// the closest point itself
+    [[nodiscard]] pos_t const& nearest_point(pos_t const& q) const { return _points[nearest_slot(q).index]; }
+
+    /// writes the min(out.size(), size()) closest points to out (sorted by distance) and returns their number
+    size_t knn(pos_t const& q, span<neighbor_t> out) const;
+
+    [[nodiscard]] cc::vector<neighbor_t> knn(pos_t const& q, size_t k) const
+    {
+        cc::vector<neighbor_t> r;
+        r.resize(tg::min(k, size()));
+        knn(q, span<neighbor_t>(r.data(), r.size()));
+        return r;
+    }
+
+    /// calls f(idx, distance_sqr) for every point with distance(point, q) <= radius (idx refers to the input span)
+    template <class F>
+    void for_each_in_radius(pos_t const& q, ScalarT radius, F&& f) const;
+
+    [[nodiscard]] cc::vector<neighbor_t> radius_search(pos_t const& q, ScalarT radius) const
+    {
+        cc::vector<neighbor_t> r;
+        for_each_in_radius(q, radius, [&r](u32 idx, ScalarT d2) { r.push_back({idx, d2}); });
+        std::sort(r.begin(), r.end(), [](neighbor_t const& a, neighbor_t const& b) { return a.distance_sqr < b.distance_sqr; });
+        return r;
+    }
+
+    /// knn for every query, out must have queries.size() * k entries
+    /// neighbors of queries[i] are written (sorted by distance) to out[i * k, (i + 1) * k), missing ones have index u32(-1)
+    void knn_batch(span<pos_t const> queries, size_t k, span<neighbor_t> out) const;
+
+private:
+    void build_node(detail::kdtree_build_item<D, ScalarT>* items, u32 node, size_t begin, size_t end, aabb_t const& bounds, int parallel_depth);
+
+    /// calls visit(point_idx, distance_sqr) for all points that might be within bound (visit may decrease bound)
+    template <class VisitF>
+    void search(u32 node, pos_t const& q, ScalarT rd, ScalarT (&dists)[D], ScalarT const& bound, VisitF& visit) const;
+
+    template <class VisitF>
+    void search(pos_t const& q, ScalarT const& bound, VisitF& visit) const;
+
+    /// nearest with index into _points
+    [[nodiscard]] neighbor_t nearest_slot(pos_t const& q) const;
+
+    /// index of the leaf containing q
+    [[nodiscard]] u32 leaf_of(pos_t const& q) const;
+
+    cc::vector<node_t> _nodes;
+    cc::vector<pos_t> _points;
+    cc::vector<u32> _indices;
+    aabb_t _bounds;
+};
+
+
+// ======== IMPLEMENTATION ========
+
+namespace detail
+{
+/// number of leaves of a kdtree over n points (median splits until at most leaf_size points remain)
+/// all ranges on one level have size a or a + 1, so only their counts need to be tracked
+constexpr size_t kdtree_leaf_count(size_t n, size_t leaf_size)
+{
+    if (n <= leaf_size)
+        return 1;
+
+    size_t leaves = 0;
+    size_t a = n;
+    size_t ca = 1; // number of ranges of size a
+    size_t cb = 0; // number of ranges of size a + 1
+    while (true)
+    {
+        if (a + 1 <= leaf_size)
+            return leaves + ca + cb;
+        if (a <= leaf_size)
+        {
+            leaves += ca;
+            ca = 0;
+        }
+
+        // a splits into a/2 and a - a/2, a + 1 into (a + 1)/2 and a + 1 - (a + 1)/2
+        if (a % 2 == 0)
+            ca = 2 * ca + cb;
+        else
+            cb = ca + 2 * cb;
+        a /= 2;
+    }
+}
+
+template <int D, class ScalarT>
+struct kdtree_build_item
+{
+    pos<D, ScalarT> p;
+    u32 index;
+
+    // hidden friend, otherwise std::nth_element finds both std::swap and detail::swap
+    friend void swap(kdtree_build_item& a, kdtree_build_item& b)
+    {
+        auto const t = a;
+        a = b;
+        b = t;
+    }
+};
+
+/// inserts (idx, d2) into the sorted neighbor list r with capacity k, returns the new distance bound
+template <class ScalarT>
+ScalarT kdtree_insert(kdtree_neighbor<ScalarT>* r, size_t& count, size_t k, u32 idx, ScalarT d2)
+{
+    auto i = count < k ? count++ : k - 1;
+    while (i > 0 && r[i - 1].distance_sqr > d2)
+    {
+        r[i] = r[i - 1];
+        --i;
+    }
+    r[i] = {idx, d2};
+    return count < k ? tg::max<ScalarT>() : r[k - 1].distance_sqr;
+}
+}
+
+
+template <int D, class ScalarT>
+void kdtree<D, ScalarT>::build(span<pos_t const> points)
+{
+    TG_CONTRACT(points.size() < size_t(u32(-1)));
+
+    auto const n = points.size();
+    _nodes.clear();
+    _points.clear();
+    _indices.clear();
+    if (n == 0)
+        return;
+
+    // points and indices are permuted together so that nth_element works on contiguous memory
+    cc::vector<detail::kdtree_build_item<D, ScalarT>> items;
+    items.resize(n);
+    detail::parallel_for(n, [&](size_t i) { items[i] = {points[i], u32(i)}; });
+
+    // bounds via parallel block reduction
+    constexpr size_t block_size = 1 << 14;
+    auto const block_count = (n + block_size - 1) / block_size;
+    cc::vector<aabb_t> block_bounds;
+    block_bounds.resize(block_count);
+    detail::parallel_for(
+        block_count,
+        [&](size_t b) {
+            auto const end = tg::min(n, (b + 1) * block_size);
+            auto bb = detail::bvh_empty_aabb<D, ScalarT>();
+            for (auto i = b * block_size; i < end; ++i)
+                detail::bvh_extend(bb, points[i]);
+            block_bounds[b] = bb;
+        },
+        1);
+    _bounds = block_bounds[0];
+    for (auto const& bb : block_bounds)
+        detail::bvh_extend(_bounds, bb);
+
+    // the node layout is fully determined by n, so subtrees can be built independently
+    _nodes.resize(2 * detail::kdtree_leaf_count(n, kdtree_leaf_size) - 1);
+
+    // fork until every thread has a subtree
+    auto parallel_depth = 0;
+    while ((1 << parallel_depth) < detail::parallel_thread_count())
+        ++parallel_depth;
+
+    build_node(items.data(), 0, 0, n, _bounds, parallel_depth);
+
+    _points.resize(n);
+    _indices.resize(n);
+    detail::parallel_for(n, [&](size_t i) {
+        _points[i] = items[i].p;
+        _indices[i] = items[i].index;
+    });
+}
+
+template <int D, class ScalarT>
+void kdtree<D, ScalarT>::build_node(detail::kdtree_build_item<D, ScalarT>* items, u32 node, size_t begin, size_t end, aabb_t const& bounds, int parallel_depth)
+{
+    auto& nd = _nodes[node];
+    if (end - begin <= kdtree_leaf_size)
+    {
+        nd.first = u32(begin);
+        nd.count = u32(end - begin);
+        return;
+    }
+
+    // median split along the axis of largest extent
+    auto axis = 0;
+    for (auto i = 1; i < D; ++i)
+        if (bounds.max[i] - bounds.min[i] > bounds.max[axis] - bounds.min[axis])
+            axis = i;
+
+    auto const mid = begin + (end - begin) / 2;
+    std::nth_element(items + begin, items + mid, items + end, [axis](auto const& a, auto const& b) { return a.p[axis] < b.p[axis]; });
+
+    auto const right = node + 1 + u32(2 * detail::kdtree_leaf_count(mid - begin, kdtree_leaf_size) - 1);
+    nd.split = items[mid].p[axis];
+    nd.axis = u32(axis);
+    nd.first = right;
+
+    auto const range_bounds = [items](size_t b, size_t e) {
+        auto bb = detail::bvh_empty_aabb<D, ScalarT>();
+        for (auto i = b; i < e; ++i)
+            detail::bvh_extend(bb, items[i].p);
+        return bb;
+    };
+
+    detail::parallel_invoke([&] { build_node(items, node + 1, begin, mid, range_bounds(begin, mid), parallel_depth - 1); },
+                            [&] { build_node(items, right, mid, end, range_bounds(mid, end), parallel_depth - 1); },
+                            parallel_depth > 0 && end - begin >= (1 << 16));
+}
+
+template <int D, class ScalarT>
+template <class VisitF>
+void kdtree<D, ScalarT>::search(u32 node, pos_t const& q, ScalarT rd, ScalarT (&dists)[D], ScalarT const& bound, VisitF& visit) const
+{
+    auto const& nd = _nodes[node];
+    if (nd.is_leaf())
+    {
+        for (auto i = nd.first; i < nd.first + nd.count; ++i)
+            if (auto const d2 = distance_sqr(_points[i], q); d2 <= bound)
+                visit(i, d2);
+        return;
+    }
+
+    auto const axis = int(nd.axis);
+    auto const diff = q[axis] - nd.split;
+    auto const near_child = diff < ScalarT(0) ? node + 1 : nd.first;
+    auto const far_child = diff < ScalarT(0) ? nd.first : node + 1;
+
+    search(near_child, q, rd, dists, bound, visit);
+
+    // incremental distance to the far cell: only the component along the split axis changes (Arya & Mount 1993)
+    auto const cut = diff * diff;
+    auto const far_rd = rd - dists[axis] + cut;
+    if (far_rd <= bound)
+    {
+        auto const old = dists[axis];
+        dists[axis] = cut;
+        search(far_child, q, far_rd, dists, bound, visit);
+        dists[axis] = old;
+    }
+}
+
+template <int D, class ScalarT>
+template <class VisitF>
+void kdtree<D, ScalarT>::search(pos_t const& q, ScalarT const& bound, VisitF& visit) const
+{
+    if (empty())
+        return;
+
+    ScalarT dists[D];
+    auto rd = ScalarT(0);
+    for (auto i = 0; i < D; ++i)
+    {
+        auto const d = q[i] < _bounds.min[i] ? _bounds.min[i] - q[i] : q[i] > _bounds.max[i] ? q[i] - _bounds.max[i] : ScalarT(0);
+        dists[i] = d * d;
+        rd += dists[i];
+    }
+
+    if (rd <= bound)
+        search(0, q, rd, dists, bound, visit);
+}
+
+template <int D, class ScalarT>
+u32 kdtree<D, ScalarT>::leaf_of(pos_t const& q) const
+{
+    TG_CONTRACT(!empty());
+    auto node = u32(0);
+    while (!_nodes[node].is_leaf())
+        node = q[int(_nodes[node].axis)] < _nodes[node].split ? node + 1 : _nodes[node].first;
+    return node;
+}
+
+template <int D, class ScalarT>
+typename kdtree<D, ScalarT>::neighbor_t kdtree<D, ScalarT>::nearest_slot(pos_t const& q) const
+{
+    TG_CONTRACT(!empty());
+
+    auto best = neighbor_t{u32(-1), tg::max<ScalarT>()};
+    auto bound = tg::max<ScalarT>();
+    auto visit = [&](u32 i, ScalarT d2) {
+        if (d2 < best.distance_sqr)
+        {
+            best = {i, d2};
+            bound = d2;
+        }
+    };
+    search(q, bound, visit);
+    return best;
+}
+
+template <int D, class ScalarT>
+size_t kdtree<D, ScalarT>::knn(pos_t const& q, span<neighbor_t> out) const
+{
+    auto const k = out.size();
+    if (k == 0)
+        return 0;
+
+    size_t count = 0;
+    auto bound = tg::max<ScalarT>();
+    auto visit = [&](u32 i, ScalarT d2) { bound = detail::kdtree_insert(out.data(), count, k, i, d2); };
+    search(q, bound, visit);
+
+    for (size_t i = 0; i < count; ++i)
+        out[i].index = _indices[out[i].index];
+    return count;
+}
+
+template <int D, class ScalarT>
+template <class F>
+void kdtree<D, ScalarT>::for_each_in_radius(pos_t const& q, ScalarT radius, F&& f) const
+{
+    auto const bound = radius * radius;
+    auto visit = [&](u32 i, ScalarT d2) { f(_indices[i], d2); };
+    search(q, bound, visit);
+}
+
+template <int D, class ScalarT>
+void kdtree<D, ScalarT>::knn_batch(span<pos_t const> queries, size_t k, span<neighbor_t> out) const
+{
+    TG_CONTRACT(out.size() == queries.size() * k);
+
+    auto const m = queries.size();
+    if (m == 0 || k == 0)
+        return;
+
+    if (empty())
+    {
+        for (auto& r : out)
+            r = {u32(-1), tg::max<ScalarT>()};
+        return;
+    }
+
+    // process queries in leaf order: consecutive queries then traverse mostly the same nodes and points
+    cc::vector<u64> order;
+    order.resize(m);
+    detail::parallel_for(m, [&](size_t i) { order[i] = (u64(leaf_of(queries[i])) << 32) | u64(i); });
+    std::sort(order.begin(), order.end());
+
+    detail::parallel_for_chunks(
+        m,
+        [&](size_t b, size_t e) {
+            for (auto i = b; i < e; ++i)
+            {
+                auto const qi = size_t(u32(order[i]));
+                auto const r = out.subspan(qi * k, k);
+                for (auto j = knn(queries[qi], r); j < k; ++j)
+                    r[j] = {u32(-1), tg::max<ScalarT>()};
+            }
+        },
+        256);
+}
+
+
+// ====================================== Free Functions ======================================
+
+template <int D, class ScalarT>
+[[nodiscard]] aabb<D, ScalarT> aabb_of(kdtree<D, ScalarT> const& t)
+{
+    return t.bounds();
+}
+
+/// closest point of the tree
+template <int D, class ScalarT>
+[[nodiscard]] pos<D, ScalarT> project(pos<D, ScalarT> const& p, kdtree<D, ScalarT> const& t)
+{
+    return t.nearest_point(p);
+}
+} // namespace tg
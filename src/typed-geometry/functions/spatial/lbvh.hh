@@ -0,0 +1,550 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include <clean-core/optional.hh>
+#include <clean-core/vector.hh>
+
+#include <typed-geometry/detail/macros.hh>
+#include <typed-geometry/detail/parallel.hh>
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/functions/basic/limits.hh>
+#include <typed-geometry/functions/objects/aabb.hh>
+#include <typed-geometry/functions/objects/centroid.hh>
+#include <typed-geometry/functions/objects/intersection.hh>
+#include <typed-geometry/types/objects/aabb.hh>
+#include <typed-geometry/types/objects/ray.hh>
+#include <typed-geometry/types/objects/triangle.hh>
+#include <typed-geometry/types/span.hh>
+
+#include "bvh.hh"
+
+#ifdef TG_COMPILER_MSVC
+#include <intrin.h>
+#endif
+
+/**
+ * Linear bounding volume hierarchy for deforming triangle meshes
+ *
+ * In contrast to tg::bvh, the lbvh is optimized for build and update speed instead of query speed:
+ *   - build() sorts triangles along a 30 bit Morton curve of their centroids and
+ *     emits the hierarchy in parallel (Karras 2012, "Maximizing Parallelism in the Construction of BVHs, Octrees, and k-d Trees")
+ *   - refit() keeps the topology and recomputes all bounds bottom-up in parallel,
+ *     which is all that is needed when only vertex positions change (skinning, cloth)
+ *
+ * Usage:
+ *   auto tree = tg::lbvh<float>(triangles);
+ *   // ... deform triangles (same number and order)
+ *   tree.refit(triangles);
+ *   auto hit = tree.closest_hit(ray);
+ *
+ * Notes:
+ *   - tree quality degrades with large deformations, call build() again in that case
+ *   - internal nodes are stored in a flat array, children are encoded with lbvh_leaf_bit
+ *   - indices returned by queries refer to the input span
+ */
+
+namespace tg
+{
+template <class ScalarT>
+struct lbvh;
+
+/// child references with this bit set are leaves (i.e. triangle indices in Morton order)
+static constexpr u32 lbvh_leaf_bit = u32(1) << 31;
+
+template <class ScalarT>
+struct alignas(32) lbvh_node
+{
+    aabb<3, ScalarT> bounds;
+    u32 left = 0;
+    u32 right = 0;
+};
+
+
+// ======== IMPLEMENTATION ========
+
+namespace detail
+{
+inline int lbvh_clz(u32 v)
+{
+    TG_INTERNAL_ASSERT(v != 0);
+#ifdef TG_COMPILER_MSVC
+    unsigned long idx;
+    _BitScanReverse(&idx, v);
+    return 31 - int(idx);
+#else
+    return __builtin_clz(v);
+#endif
+}
+
+/// spreads the lower 10 bits of v so that there are two 0 bits between each
+constexpr u32 lbvh_expand_bits(u32 v)
+{
+    v = (v * 0x00010001u) & 0xFF0000FFu;
+    v = (v * 0x00000101u) & 0x0F00F00Fu;
+    v = (v * 0x00000011u) & 0xC30C30C3u;
+    v = (v * 0x00000005u) & 0x49249249u;
+    return v;
+}
+
+/// 30 bit Morton code of a point in [0,1]^3
+template <class ScalarT>
+constexpr u32 lbvh_morton_code(pos<3, ScalarT> const& p)
+{
+    auto const quantize = [](ScalarT v) {
+        auto const q = v * ScalarT(1024);
+        return q <= ScalarT(0) ? u32(0) : q >= ScalarT(1023) ? u32(1023) : u32(q);
+    };
+    return (lbvh_expand_bits(quantize(p.x)) << 2) | (lbvh_expand_bits(quantize(p.y)) << 1) | lbvh_expand_bits(quantize(p.z));
+}
+
+/// stable LSD radix sort of (code << 32 | index) keys by their 30 bit code
+inline void lbvh_radix_sort(cc::vector<u64>& keys)
+{
+    cc::vector<u64> tmp;
+    tmp.resize(keys.size());
+
+    for (auto shift = 32; shift < 62; shift += 8)
+    {
+        size_t offsets[257] = {};
+        for (auto k : keys)
+            ++offsets[((k >> shift) & 0xFF) + 1];
+        for (auto i = 1; i < 257; ++i)
+            offsets[i] += offsets[i - 1];
+        for (auto k : keys)
+            tmp[offsets[(k >> shift) & 0xFF]++] = k;
+        std::swap(keys, tmp);
+    }
+}
+}
+
+template <class ScalarT>
+struct lbvh
+{
+    using scalar_t = ScalarT;
+    using triangle_t = triangle<3, ScalarT>;
+    using aabb_t = aabb<3, ScalarT>;
+    using ray_t = ray<3, ScalarT>;
+    using node_t = lbvh_node<ScalarT>;
+    using hit_t = bvh_hit<ScalarT>;
+
+    // ctors
+public:
+    lbvh() = default;
+
+    explicit lbvh(span<triangle_t const> triangles) { build(triangles); }
+
+    /// builds a new hierarchy (parallel Morton code computation and node emission)
+    void build(span<triangle_t const> triangles);
+
+    /// recomputes all bounds for moved vertices
+    /// triangles must have the same size and order as in the last build()
+    void refit(span<triangle_t const> triangles);
+
+    // accessors
+public:
+    [[nodiscard]] bool empty() const { return _triangles.empty(); }
+    [[nodiscard]] size_t size() const { return _triangles.size(); }
+
+    /// internal nodes, nodes()[0] is the root (if size() > 1)
+    [[nodiscard]] span<node_t const> nodes() const { return {_nodes.data(), _nodes.size()}; }
+    /// triangles in Morton order
+    [[nodiscard]] span<triangle_t const> triangles() const { return {_triangles.data(), _triangles.size()}; }
+    /// indices()[i] is the input index of triangles()[i]
+    [[nodiscard]] span<u32 const> indices() const { return {_indices.data(), _indices.size()}; }
+
+    [[nodiscard]] aabb_t bounds() const
+    {
+        TG_CONTRACT(!empty());
+        return _nodes.empty() ? _leaf_bounds[0] : _nodes[0].bounds;
+    }
+
+    // queries
+public:
+    [[nodiscard]] cc::optional<hit_t> closest_hit(ray_t const& r, ScalarT t_max = tg::max<ScalarT>()) const;
+
+    [[nodiscard]] bool any_hit(ray_t const& r, ScalarT t_max = tg::max<ScalarT>()) const;
+
+    /// calls f(idx) for every triangle that intersects the box (idx refers to the input span)
+    /// F may return bool, in which case returning false stops the traversal
+    template <class F>
+    void for_each_intersecting(aabb_t const& box, F&& f) const;
+
+    [[nodiscard]] bool intersects_any(aabb_t const& box) const
+    {
+        auto found = false;
+        for_each_intersecting(box, [&found](u32) {
+            found = true;
+            return false;
+        });
+        return found;
+    }
+
+private:
+    [[nodiscard]] aabb_t const& child_bounds(u32 c) const { return (c & lbvh_leaf_bit) ? _leaf_bounds[c & ~lbvh_leaf_bit] : _nodes[c].bounds; }
+
+    /// length of the common prefix of the (code, index) keys i and j, -1 if j is out of range
+    [[nodiscard]] int delta(int i, int j) const
+    {
+        if (j < 0 || j >= int(_codes.size()))
+            return -1;
+        auto const ci = _codes[size_t(i)];
+        auto const cj = _codes[size_t(j)];
+        return ci == cj ? 32 + detail::lbvh_clz(u32(i) ^ u32(j)) : detail::lbvh_clz(ci ^ cj);
+    }
+
+    void update_bounds(size_t leaf_begin, size_t leaf_end, std::atomic<u32>* visits);
+
+    cc::vector<node_t> _nodes;
+    cc::vector<u32> _parents;      ///< parents of internal nodes followed by parents of leaves
+    cc::vector<aabb_t> _leaf_bounds; ///< in Morton order
+    cc::vector<triangle_t> _triangles;
+    cc::vector<u32> _indices;
+    cc::vector<u32> _codes;
+};
+
+template <class ScalarT>
+void lbvh<ScalarT>::build(span<triangle_t const> triangles)
+{
+    TG_CONTRACT(triangles.size() < size_t(lbvh_leaf_bit));
+
+    auto const n = triangles.size();
+    _nodes.clear();
+    _parents.clear();
+    _leaf_bounds.clear();
+    _triangles.clear();
+    _indices.clear();
+    _codes.clear();
+    if (n == 0)
+        return;
+
+    // centroid bounds via parallel block reduction
+    constexpr size_t block_size = 1 << 14;
+    auto const block_count = (n + block_size - 1) / block_size;
+    cc::vector<aabb_t> block_bounds;
+    block_bounds.resize(block_count);
+    detail::parallel_for(
+        block_count,
+        [&](size_t b) {
+            auto const end = tg::min(n, (b + 1) * block_size);
+            auto const c0 = centroid_of(triangles[b * block_size]);
+            auto bb = aabb_t(c0, c0);
+            for (auto i = b * block_size + 1; i < end; ++i)
+                detail::bvh_extend(bb, centroid_of(triangles[i]));
+            block_bounds[b] = bb;
+        },
+        1);
+    auto cbounds = block_bounds[0];
+    for (auto const& bb : block_bounds)
+        detail::bvh_extend(cbounds, bb);
+
+    // Morton codes
+    auto const extent = cbounds.max - cbounds.min;
+    auto inv_extent = vec<3, ScalarT>();
+    for (auto i = 0; i < 3; ++i)
+        inv_extent[i] = extent[i] > ScalarT(0) ? ScalarT(1) / extent[i] : ScalarT(0);
+
+    cc::vector<u64> keys;
+    keys.resize(n);
+    detail::parallel_for(n, [&](size_t i) {
+        auto const c = centroid_of(triangles[i]);
+        pos<3, ScalarT> p;
+        for (auto k = 0; k < 3; ++k)
+            p[k] = (c[k] - cbounds.min[k]) * inv_extent[k];
+        keys[i] = (u64(detail::lbvh_morton_code(p)) << 32) | u64(i);
+    });
+
+    detail::lbvh_radix_sort(keys);
+
+    _codes.resize(n);
+    _indices.resize(n);
+    _triangles.resize(n);
+    _leaf_bounds.resize(n);
+    detail::parallel_for(n, [&](size_t i) {
+        _codes[i] = u32(keys[i] >> 32);
+        _indices[i] = u32(keys[i]);
+    });
+
+    // emit internal nodes, each one independently
+    _nodes.resize(n - 1);
+    _parents.resize(2 * n - 1);
+    _parents[0] = u32(-1);
+    detail::parallel_for(n - 1, [&](size_t idx) {
+        auto const i = int(idx);
+
+        // direction of the node range
+        auto const d = delta(i, i + 1) - delta(i, i - 1) >= 0 ? 1 : -1;
+
+        // upper bound for the range length
+        auto const dmin = delta(i, i - d);
+        auto lmax = 2;
+        while (delta(i, i + lmax * d) > dmin)
+            lmax *= 2;
+
+        // exact range end via binary search
+        auto l = 0;
+        for (auto t = lmax / 2; t >= 1; t /= 2)
+            if (delta(i, i + (l + t) * d) > dmin)
+                l += t;
+        auto const j = i + l * d;
+
+        // split position via binary search
+        auto const dnode = delta(i, j);
+        auto s = 0;
+        auto t = l;
+        do
+        {
+            t = (t + 1) / 2;
+            if (delta(i, i + (s + t) * d) > dnode)
+                s += t;
+        } while (t > 1);
+        auto const split = i + s * d + (d < 0 ? -1 : 0);
+
+        auto& node = _nodes[idx];
+        node.left = tg::min(i, j) == split ? u32(split) | lbvh_leaf_bit : u32(split);
+        node.right = tg::max(i, j) == split + 1 ? u32(split + 1) | lbvh_leaf_bit : u32(split + 1);
+
+        _parents[(node.left & lbvh_leaf_bit) ? n - 1 + (node.left & ~lbvh_leaf_bit) : node.left] = u32(idx);
+        _parents[(node.right & lbvh_leaf_bit) ? n - 1 + (node.right & ~lbvh_leaf_bit) : node.right] = u32(idx);
+    });
+
+    _codes.clear(); // only needed during build
+
+    refit(triangles);
+}
+
+template <class ScalarT>
+void lbvh<ScalarT>::refit(span<triangle_t const> triangles)
+{
+    TG_CONTRACT(triangles.size() == _triangles.size() && "refit requires the same triangles as the last build");
+
+    auto const n = _triangles.size();
+    if (n == 0)
+        return;
+
+    // visit counters of the internal nodes (value-initialized to 0)
+    auto const visits = std::unique_ptr<std::atomic<u32>[]>(n > 1 ? new std::atomic<u32>[n - 1]() : nullptr);
+
+    detail::parallel_for_chunks(n, [&](size_t b, size_t e) {
+        for (auto i = b; i < e; ++i)
+        {
+            _triangles[i] = triangles[_indices[i]];
+            _leaf_bounds[i] = aabb_of(_triangles[i]);
+        }
+        if (n > 1)
+            update_bounds(b, e, visits.get());
+    });
+}
+
+template <class ScalarT>
+void lbvh<ScalarT>::update_bounds(size_t leaf_begin, size_t leaf_end, std::atomic<u32>* visits)
+{
+    auto const n = _triangles.size();
+    for (auto i = leaf_begin; i < leaf_end; ++i)
+    {
+        // walk up until the first visit of a node, the second visitor has both children ready
+        auto node = _parents[n - 1 + i];
+        while (node != u32(-1))
+        {
+            if (visits[node].fetch_add(1, std::memory_order_acq_rel) == 0)
+                break;
+
+            auto& nd = _nodes[node];
+            nd.bounds = child_bounds(nd.left);
+            detail::bvh_extend(nd.bounds, child_bounds(nd.right));
+
+            node = _parents[node];
+        }
+    }
+}
+
+template <class ScalarT>
+cc::optional<typename lbvh<ScalarT>::hit_t> lbvh<ScalarT>::closest_hit(ray_t const& r, ScalarT t_max) const
+{
+    if (empty())
+        return {};
+
+    auto const dr = detail::bvh_ray<3, ScalarT>(r);
+    auto bestT = t_max;
+    auto bestIdx = u32(-1);
+
+    auto const test_leaf = [&](u32 c) {
+        auto const i = c & ~lbvh_leaf_bit;
+        auto const t = closest_intersection_parameter(r, _triangles[i]);
+        if (t.has_value() && t.value() <= bestT)
+        {
+            bestT = t.value();
+            bestIdx = i;
+        }
+    };
+
+    if (_nodes.empty())
+        test_leaf(lbvh_leaf_bit);
+    else
+    {
+        u32 stack[detail::bvh_max_stack_size];
+        ScalarT stackT[detail::bvh_max_stack_size];
+        auto stackSize = 0;
+
+        auto const rootT = dr.entry(_nodes[0].bounds, bestT);
+        if (rootT != tg::max<ScalarT>())
+        {
+            stack[stackSize] = 0;
+            stackT[stackSize++] = rootT;
+        }
+
+        while (stackSize > 0)
+        {
+            --stackSize;
+            if (stackT[stackSize] > bestT)
+                continue;
+
+            auto const& node = _nodes[stack[stackSize]];
+            auto const tl = dr.entry(child_bounds(node.left), bestT);
+            auto const tr = dr.entry(child_bounds(node.right), bestT);
+
+            // leaves are tested immediately, inner nodes are pushed far-to-near
+            u32 push[2];
+            ScalarT pushT[2];
+            auto pushCount = 0;
+            auto const handle = [&](u32 c, ScalarT t) {
+                if (t == tg::max<ScalarT>())
+                    return;
+                if (c & lbvh_leaf_bit)
+                    test_leaf(c);
+                else
+                {
+                    push[pushCount] = c;
+                    pushT[pushCount++] = t;
+                }
+            };
+            handle(node.left, tl);
+            handle(node.right, tr);
+
+            if (pushCount == 2 && pushT[0] < pushT[1])
+            {
+                std::swap(push[0], push[1]);
+                std::swap(pushT[0], pushT[1]);
+            }
+
+            TG_ASSERT(stackSize + pushCount <= detail::bvh_max_stack_size);
+            for (auto i = 0; i < pushCount; ++i)
+            {
+                stack[stackSize] = push[i];
+                stackT[stackSize++] = pushT[i];
+            }
+        }
+    }
+
+    if (bestIdx == u32(-1))
+        return {};
+
+    return hit_t{bestT, _indices[bestIdx]};
+}
+
+template <class ScalarT>
+bool lbvh<ScalarT>::any_hit(ray_t const& r, ScalarT t_max) const
+{
+    if (empty())
+        return false;
+
+    auto const dr = detail::bvh_ray<3, ScalarT>(r);
+
+    u32 stack[detail::bvh_max_stack_size];
+    auto stackSize = 0;
+    stack[stackSize++] = _nodes.empty() ? lbvh_leaf_bit : 0;
+
+    while (stackSize > 0)
+    {
+        auto const c = stack[--stackSize];
+        if (dr.entry(child_bounds(c), t_max) == tg::max<ScalarT>())
+            continue;
+
+        if (c & lbvh_leaf_bit)
+        {
+            auto const t = closest_intersection_parameter(r, _triangles[c & ~lbvh_leaf_bit]);
+            if (t.has_value() && t.value() <= t_max)
+                return true;
+        }
+        else
+        {
+            TG_ASSERT(stackSize + 2 <= detail::bvh_max_stack_size);
+            stack[stackSize++] = _nodes[c].right;
+            stack[stackSize++] = _nodes[c].left;
+        }
+    }
+
+    return false;
+}
+
+template <class ScalarT>
+template <class F>
+void lbvh<ScalarT>::for_each_intersecting(aabb_t const& box, F&& f) const
+{
+    if (empty())
+        return;
+
+    u32 stack[detail::bvh_max_stack_size];
+    auto stackSize = 0;
+    stack[stackSize++] = _nodes.empty() ? lbvh_leaf_bit : 0;
+
+    while (stackSize > 0)
+    {
+        auto const c = stack[--stackSize];
+        if (!intersects(box, child_bounds(c)))
+            continue;
+
+        if (c & lbvh_leaf_bit)
+        {
+            auto const i = c & ~lbvh_leaf_bit;
+            if (!intersects(_triangles[i], box))
+                continue;
+
+            if constexpr (std::is_same_v<decltype(f(_indices[i])), bool>)
+            {
+                if (!f(_indices[i]))
+                    return;
+            }
+            else
+                f(_indices[i]);
+        }
+        else
+        {
+            TG_ASSERT(stackSize + 2 <= detail::bvh_max_stack_size);
+            stack[stackSize++] = _nodes[c].right;
+            stack[stackSize++] = _nodes[c].left;
+        }
+    }
+}
+
+
+// ====================================== Free Functions ======================================
+
+template <class ScalarT>
+[[nodiscard]] aabb<3, ScalarT> aabb_of(lbvh<ScalarT> const& b)
+{
+    return b.bounds();
+}
+
+template <class ScalarT>
+[[nodiscard]] cc::optional<ScalarT> closest_intersection_parameter(ray<3, ScalarT> const& r, lbvh<ScalarT> const& b)
+{
+    if (auto const hit = b.closest_hit(r); hit.has_value())
+        return hit.value().t;
+    return {};
+}
+
+template <class ScalarT>
+[[nodiscard]] bool intersects(ray<3, ScalarT> const& r, lbvh<ScalarT> const& b)
+{
+    return b.any_hit(r);
+}
+
+template <class ScalarT>
+[[nodiscard]] bool intersects(aabb<3, ScalarT> const& bb, lbvh<ScalarT> const& b)
+{
+    return b.intersects_any(bb);
+}
+} // namespace tg
@@ -0,0 +1,464 @@
+#pragma once
+
+#include <algorithm>
+
+#include <clean-core/vector.hh>
+
+#include <typed-geometry/detail/parallel.hh>
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/functions/basic/limits.hh>
+#include <typed-geometry/functions/basic/scalar_math.hh>
+#include <typed-geometry/functions/vector/cross.hh>
+#include <typed-geometry/functions/vector/distance.hh>
+#include <typed-geometry/functions/vector/dot.hh>
+#include <typed-geometry/functions/vector/length.hh>
+#include <typed-geometry/types/objects/aabb.hh>
+#include <typed-geometry/types/objects/triangle.hh>
+#include <typed-geometry/types/pos.hh>
+#include <typed-geometry/types/span.hh>
+
+#include "bvh.hh"
+
+/**
+ * Closest point and (signed) distance queries against indexed triangle meshes
+ *
+ * Build:
+ *   auto md = tg::mesh_distance<float>(vertices, indices); // 3 indices per triangle, builds a tg::bvh over the triangles
+ *
+ * Queries:
+ *   md.closest(p)                          -> mesh_closest_point (closest point, triangle index, squared distance, pseudo-normal)
+ *   md.project(p)                          -> closest point on the mesh
+ *   md.distance(p)                         -> unsigned distance
+ *   md.signed_distance(p)                  -> distance, negative inside (requires a closed, consistently oriented mesh)
+ *   md.closest_batch / distance_batch / signed_distance_batch(queries, out) -> same for many points in parallel
+ *
+ * Free functions:
+ *   project(p, md), closest_points(p, md), distance_sqr(p, md), signed_distance(p, md), aabb_of(md)
+ *   hausdorff_distance(a, b, subdivisions)  -> two-sided Hausdorff distance between two meshes
+ *
+ * Notes:
+ *   - the sign uses angle-weighted pseudo-normals (Baerentzen & Aanaes 2005): the normal of the closest face,
+ *     edge or vertex, so it is also correct when the closest point lies on an edge or a vertex
+ *   - triangles are oriented counter-clockwise when seen from the outside
+ *   - the mesh is static, rebuild when vertices change
+ */
+
+namespace tg
+{
+template <class ScalarT>
+struct mesh_distance;
+
+/// result of a closest point query
+/// triangle refers to the index buffer the mesh_distance was built from (triangle i uses indices[3i .. 3i+2])
+template <class ScalarT>
+struct mesh_closest_point
+{
+    pos<3, ScalarT> point;
+    u32 triangle;
+    ScalarT distance_sqr;
+    vec<3, ScalarT> normal; ///< pseudo-normal of the closest face, edge or vertex (not normalized), q is inside iff dot(q - point, normal) < 0
+};
+
+
+// ======== IMPLEMENTATION ========
+
+namespace detail
+{
+/// closest point on a triangle and the feature it lies on
+/// feature: 0 = face, 1 + i = vertex i, 4 + i = edge from vertex i to vertex (i + 1) % 3
+template <class ScalarT>
+struct triangle_closest_feature
+{
+    pos<3, ScalarT> point;
+    int feature;
+};
+
+/// Ericson, "Real-Time Collision Detection", 5.1.5 (no normalization, robust for degenerate triangles)
+template <class ScalarT>
+[[nodiscard]] constexpr triangle_closest_feature<ScalarT> closest_feature_on_triangle(pos<3, ScalarT> const& p, triangle<3, ScalarT> const& t)
+{
+    auto const& a = t.pos0;
+    auto const& b = t.pos1;
+    auto const& c = t.pos2;
+
+    auto const ab = b - a;
+    auto const ac = c - a;
+    auto const ap = p - a;
+    auto const d1 = dot(ab, ap);
+    auto const d2 = dot(ac, ap);
+    if (d1 <= ScalarT(0) && d2 <= ScalarT(0))
+        return {a, 1};
+
+    auto const bp = p - b;
+    auto const d3 = dot(ab, bp);
+    auto const d4 = dot(ac, bp);
+    if (d3 >= ScalarT(0) && d4 <= d3)
+        return {b, 2};
+
+    auto const vc = d1 * d4 - d3 * d2;
+    if (vc <= ScalarT(0) && d1 >= ScalarT(0) && d3 <= ScalarT(0))
+        return {a + ab * (d1 / (d1 - d3)), 4};
+
+    auto const cp = p - c;
+    auto const d5 = dot(ab, cp);
+    auto const d6 = dot(ac, cp);
+    if (d6 >= ScalarT(0) && d5 <= d6)
+        return {c, 3};
+
+    auto const vb = d5 * d2 - d1 * d6;
+    if (vb <= ScalarT(0) && d2 >= ScalarT(0) && d6 <= ScalarT(0))
+        return {a + ac * (d2 / (d2 - d6)), 6};
+
+    auto const va = d3 * d6 - d5 * d4;
+    if (va <= ScalarT(0) && d4 - d3 >= ScalarT(0) && d5 - d6 >= ScalarT(0))
+        return {b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))), 5};
+
+    auto const denom = ScalarT(1) / (va + vb + vc);
+    return {a + ab * (vb * denom) + ac * (vc * denom), 0};
+}
+
+template <class ScalarT>
+[[nodiscard]] constexpr ScalarT mesh_distance_sqr_to_box(pos<3, ScalarT> const& p, aabb<3, ScalarT> const& b)
+{
+    auto d2 = ScalarT(0);
+    for (auto i = 0; i < 3; ++i)
+    {
+        auto const d = p[i] < b.min[i] ? b.min[i] - p[i] : p[i] > b.max[i] ? p[i] - b.max[i] : ScalarT(0);
+        d2 += d * d;
+    }
+    return d2;
+}
+}
+
+template <class ScalarT>
+struct mesh_distance
+{
+    using scalar_t = ScalarT;
+    using pos_t = pos<3, ScalarT>;
+    using vec_t = vec<3, ScalarT>;
+    using triangle_t = triangle<3, ScalarT>;
+    using aabb_t = aabb<3, ScalarT>;
+    using closest_t = mesh_closest_point<ScalarT>;
+
+    // ctors
+public:
+    mesh_distance() = default;
+
+    mesh_distance(span<pos_t const> vertices, span<u32 const> indices) { build(vertices, indices); }
+
+    /// indices contains 3 vertex indices per triangle
+    void build(span<pos_t const> vertices, span<u32 const> indices);
+
+    // accessors
+public:
+    [[nodiscard]] bool empty() const { return _tree.empty(); }
+    [[nodiscard]] size_t triangle_count() const { return _indices.size() / 3; }
+
+    [[nodiscard]] span<pos_t const> vertices() const { return {_vertices.data(), _vertices.size()}; }
+    [[nodiscard]] span<u32 const> indices() const { return {_indices.data(), _indices.size()}; }
+
+    [[nodiscard]] triangle_t triangle_at(size_t i) const
+    {
+        return {_vertices[_indices[3 * i + 0]], _vertices[_indices[3 * i + 1]], _vertices[_indices[3 * i + 2]]};
+    }
+
+    /// the underlying hierarchy (triangles in leaf order)
+    [[nodiscard]] bvh<triangle_t> const& tree() const { return _tree; }
+
+    [[nodiscard]] aabb_t bounds() const { return _tree.bounds(); }
+
+    // queries
+public:
+    [[nodiscard]] closest_t closest(pos_t const& p) const
+    {
+        auto const r = closest_slot(p);
+        auto const tri = _tree.indices()[r.slot];
+        return {r.point, tri, r.distance_sqr, pseudo_normal(tri, r.feature)};
+    }
+
+    [[nodiscard]] pos_t project(pos_t const& p) const { return closest_slot(p).point; }
+
+    [[nodiscard]] ScalarT distance(pos_t const& p) const { return sqrt(closest_slot(p).distance_sqr); }
+
+    /// positive outside, negative inside
+    [[nodiscard]] ScalarT signed_distance(pos_t const& p) const
+    {
+        auto const r = closest_slot(p);
+        auto const d = sqrt(r.distance_sqr);
+        return dot(p - r.point, pseudo_normal(_tree.indices()[r.slot], r.feature)) < ScalarT(0) ? -d : d;
+    }
+
+    /// out must have queries.size() entries
+    void closest_batch(span<pos_t const> queries, span<closest_t> out) const
+    {
+        batch(queries, out, [this](pos_t const& p) { return closest(p); });
+    }
+    void distance_batch(span<pos_t const> queries, span<ScalarT> out) const
+    {
+        batch(queries, out, [this](pos_t const& p) { return distance(p); });
+    }
+    void signed_distance_batch(span<pos_t const> queries, span<ScalarT> out) const
+    {
+        batch(queries, out, [this](pos_t const& p) { return signed_distance(p); });
+    }
+
+    /// max over all surface samples of this mesh of the distance to the other mesh
+    /// samples are the vertices and, for subdivisions > 0, a barycentric grid with subdivisions + 1 segments per edge
+    [[nodiscard]] ScalarT directed_hausdorff_distance(mesh_distance const& other, int subdivisions = 0) const;
+
+private:
+    struct slot_result
+    {
+        pos_t point;
+        u32 slot; ///< index into _tree.objects()
+        int feature;
+        ScalarT distance_sqr;
+    };
+
+    [[nodiscard]] slot_result closest_slot(pos_t const& p) const;
+
+    /// pseudo-normal of a feature of a triangle (see detail::closest_feature_on_triangle)
+    [[nodiscard]] vec_t pseudo_normal(u32 tri, int feature) const
+    {
+        if (feature == 0)
+            return _face_normals[tri];
+        if (feature <= 3)
+            return _vertex_normals[_indices[3 * tri + u32(feature - 1)]];
+        return _edge_normals[3 * tri + u32(feature - 4)];
+    }
+
+    template <class T, class F>
+    void batch(span<pos_t const> queries, span<T> out, F&& f) const
+    {
+        TG_CONTRACT(out.size() == queries.size());
+        detail::parallel_for(queries.size(), [&](size_t i) { out[i] = f(queries[i]); }, 256);
+    }
+
+    bvh<triangle_t> _tree;
+    cc::vector<pos_t> _vertices;
+    cc::vector<u32> _indices;
+    cc::vector<vec_t> _face_normals;   ///< per triangle
+    cc::vector<vec_t> _edge_normals;   ///< 3 per triangle, sum of the adjacent face normals
+    cc::vector<vec_t> _vertex_normals; ///< per vertex, angle-weighted sum of the incident face normals
+};
+
+template <class ScalarT>
+void mesh_distance<ScalarT>::build(span<pos_t const> vertices, span<u32 const> indices)
+{
+    TG_CONTRACT(indices.size() % 3 == 0);
+    TG_CONTRACT(vertices.size() < size_t(u32(-1)));
+
+    auto const tri_count = indices.size() / 3;
+
+    _vertices.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i)
+        _vertices[i] = vertices[i];
+    _indices.resize(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        TG_CONTRACT(indices[i] < vertices.size());
+        _indices[i] = indices[i];
+    }
+
+    // face normals
+    _face_normals.resize(tri_count);
+    detail::parallel_for(tri_count, [&](size_t t) {
+        auto const tri = triangle_at(t);
+        auto const n = cross(tri.pos1 - tri.pos0, tri.pos2 - tri.pos0);
+        auto const l = length(n);
+        _face_normals[t] = l > ScalarT(0) ? n / l : vec_t::zero;
+    });
+
+    // vertex normals, weighted by the incident angle
+    _vertex_normals.resize(vertices.size());
+    for (auto& n : _vertex_normals)
+        n = vec_t::zero;
+    for (size_t t = 0; t < tri_count; ++t)
+    {
+        auto const tri = triangle_at(t);
+        pos_t const corners[3] = {tri.pos0, tri.pos1, tri.pos2};
+        for (auto i = 0; i < 3; ++i)
+        {
+            auto const e0 = corners[(i + 1) % 3] - corners[i];
+            auto const e1 = corners[(i + 2) % 3] - corners[i];
+            auto const l0 = length(e0);
+            auto const l1 = length(e1);
+            if (l0 <= ScalarT(0) || l1 <= ScalarT(0))
+                continue;
+
+            auto const angle = acos(clamp(dot(e0, e1) / (l0 * l1), ScalarT(-1), ScalarT(1)));
+            _vertex_normals[_indices[3 * t + i]] += _face_normals[t] * angle.radians();
+        }
+    }
+
+    // edge normals: sort (edge key, slot) pairs so that all slots of an edge are adjacent
+    cc::vector<u64> edge_keys;
+    edge_keys.resize(3 * tri_count);
+    detail::parallel_for(tri_count, [&](size_t t) {
+        for (auto e = 0; e < 3; ++e)
+        {
+            auto const a = _indices[3 * t + e];
+            auto const b = _indices[3 * t + (e + 1) % 3];
+            edge_keys[3 * t + e] = (u64(tg::min(a, b)) << 32) | u64(tg::max(a, b));
+        }
+    });
+    cc::vector<u32> edge_slots;
+    edge_slots.resize(3 * tri_count);
+    for (size_t i = 0; i < edge_slots.size(); ++i)
+        edge_slots[i] = u32(i);
+    std::sort(edge_slots.begin(), edge_slots.end(), [&](u32 a, u32 b) { return edge_keys[a] < edge_keys[b]; });
+
+    _edge_normals.resize(3 * tri_count);
+    for (size_t begin = 0; begin < edge_slots.size();)
+    {
+        auto end = begin + 1;
+        while (end < edge_slots.size() && edge_keys[edge_slots[end]] == edge_keys[edge_slots[begin]])
+            ++end;
+
+        auto n = vec_t::zero;
+        for (auto i = begin; i < end; ++i)
+            n += _face_normals[edge_slots[i] / 3];
+        for (auto i = begin; i < end; ++i)
+            _edge_normals[edge_slots[i]] = n;
+
+        begin = end;
+    }
+
+    cc::vector<triangle_t> triangles;
+    triangles.resize(tri_count);
+    for (size_t t = 0; t < tri_count; ++t)
+        triangles[t] = triangle_at(t);
+    _tree.build(triangles);
+}
+
+template <class ScalarT>
+typename mesh_distance<ScalarT>::slot_result mesh_distance<ScalarT>::closest_slot(pos_t const& p) const
+{
+    TG_CONTRACT(!empty());
+
+    auto const nodes = _tree.nodes();
+    auto const tris = _tree.objects();
+
+    slot_result best;
+    best.slot = u32(-1);
+    best.feature = 0;
+    best.distance_sqr = tg::max<ScalarT>();
+
+    u32 stack[detail::bvh_max_stack_size];
+    ScalarT stackD[detail::bvh_max_stack_size];
+    auto stackSize = 0;
+    stack[stackSize] = 0;
+    stackD[stackSize++] = detail::mesh_distance_sqr_to_box(p, nodes[0].bounds);
+
+    while (stackSize > 0)
+    {
+        --stackSize;
+        if (stackD[stackSize] > best.distance_sqr)
+            continue;
+
+        auto const& node = nodes[stack[stackSize]];
+        if (node.is_leaf())
+        {
+            for (auto i = node.first; i < node.first + node.count; ++i)
+            {
+                auto const r = detail::closest_feature_on_triangle(p, tris[i]);
+                auto const d2 = distance_sqr(p, r.point);
+                if (d2 < best.distance_sqr)
+                    best = {r.point, i, r.feature, d2};
+            }
+        }
+        else
+        {
+            auto const dl = detail::mesh_distance_sqr_to_box(p, nodes[node.first].bounds);
+            auto const dr = detail::mesh_distance_sqr_to_box(p, nodes[node.first + 1].bounds);
+
+            TG_ASSERT(stackSize + 2 <= detail::bvh_max_stack_size);
+
+            // push the farther child first so that the nearer one is visited first
+            auto const nearL = dl <= dr;
+            auto const farD = nearL ? dr : dl;
+            auto const nearD = nearL ? dl : dr;
+            if (farD <= best.distance_sqr)
+            {
+                stack[stackSize] = nearL ? node.first + 1 : node.first;
+                stackD[stackSize++] = farD;
+            }
+            if (nearD <= best.distance_sqr)
+            {
+                stack[stackSize] = nearL ? node.first : node.first + 1;
+                stackD[stackSize++] = nearD;
+            }
+        }
+    }
+
+    return best;
+}
+
+template <class ScalarT>
+ScalarT mesh_distance<ScalarT>::directed_hausdorff_distance(mesh_distance const& other, int subdivisions) const
+{
+    TG_CONTRACT(subdivisions >= 0);
+    TG_CONTRACT(!other.empty());
+
+    auto const tri_count = triangle_count();
+    if (tri_count == 0)
+        return ScalarT(0);
+
+    auto const segments = subdivisions + 1;
+
+    // per-triangle maxima, the reduction is done serially afterwards
+    cc::vector<ScalarT> tri_max;
+    tri_max.resize(tri_count);
+    detail::parallel_for(
+        tri_count,
+        [&](size_t t) {
+            auto const tri = triangle_at(t);
+            auto m = ScalarT(0);
+            for (auto i = 0; i <= segments; ++i)
+                for (auto j = 0; i + j <= segments; ++j)
+                {
+                    auto const u = ScalarT(i) / ScalarT(segments);
+                    auto const v = ScalarT(j) / ScalarT(segments);
+                    auto const s = tri.pos0 + (tri.pos1 - tri.pos0) * u + (tri.pos2 - tri.pos0) * v;
+                    m = tg::max(m, other.closest_slot(s).distance_sqr);
+                }
+            tri_max[t] = m;
+        },
+        64);
+
+    auto m = ScalarT(0);
+    for (auto d : tri_max)
+        m = tg::max(m, d);
+    return sqrt(m);
+}
+
+
+// ====================================== Free Functions ======================================
+
+template <class ScalarT>
+[[nodiscard]] aabb<3, ScalarT> aabb_of(mesh_distance<ScalarT> const& md)
+{
+    return md.bounds();
+}
+
+/// closest point on the mesh
+template <class ScalarT>
+[[nodiscard]] pos<3, ScalarT> project(pos<3, ScalarT> const& p, mesh_distance<ScalarT> const& md)
+{
+    return md.project(p);
+}
+
+/// positive outside, negative inside
+template <class ScalarT>
+[[nodiscard]] ScalarT signed_distance(pos<3, ScalarT> const& p, mesh_distance<ScalarT> const& md)
+{
+    return md.signed_distance(p);
+}
+
+/// two-sided Hausdorff distance, see mesh_distance::directed_hausdorff_distance for the sampling
+template <class ScalarT>
+[[nodiscard]] ScalarT hausdorff_distance(mesh_distance<ScalarT> const& a, mesh_distance<ScalarT> const& b, int subdivisions = 0)
+{
+    return tg::max(a.directed_hausdorff_distance(b, subdivisions), b.directed_hausdorff_distance(a, subdivisions));
+}
+} // namespace tg
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <utility>
+
+#include <clean-core/vector.hh>
+
+#include <typed-geometry/detail/parallel.hh>
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/functions/basic/limits.hh>
+#include <typed-geometry/functions/basic/scalar_math.hh>
+#include <typed-geometry/functions/vector/distance.hh>
+#include <typed-geometry/functions/vector/dot.hh>
+#include <typed-geometry/types/objects/aabb.hh>
+#include <typed-geometry/types/pos.hh>
+#include <typed-geometry/types/size.hh>
+
+#include "mesh_distance.hh"
+
+/**
+ * Dense signed distance field grids baked from triangle meshes
+ *
+ * Usage:
+ *   auto md = tg::mesh_distance<float>(vertices, indices);
+ *   auto sdf = tg::bake_sdf(md, bounds, voxel_size);               // float values
+ *   auto sdf16 = tg::bake_sdf_i16(md, bounds, voxel_size, max_d);  // i16 values, distance = value * scale
+ *   auto d = sdf.distance_at(x, y, z);
+ *
+ * Algorithm:
+ *   1. narrow band: the grid is split into bricks of sdf_brick_size^3 voxels, bricks close to the surface
+ *      compute the exact closest point (and its pseudo-normal) for every voxel via mesh_distance
+ *   2. propagation: the closest points are flooded into the rest of the grid via jump flooding
+ *      (Rong & Tan 2006) with a final step-1 pass (JFA+1), every pass runs in parallel over z-slices
+ *   3. every voxel takes the distance to its closest point, signed via the stored pseudo-normal
+ *
+ * Notes:
+ *   - voxels are cubic, the grid covers bounds (rounded up to whole voxels), values are sampled at voxel centers
+ *   - voxels within band_voxels of the surface are exact, the rest is very close to exact (jump flooding can
+ *     miss the true closest point in rare configurations, but the result is always the distance to some surface point)
+ *   - the sign is correct wherever the closest point is exact and requires a closed, consistently oriented mesh
+ */
+
+namespace tg
+{
+/// edge length of the bricks (in voxels) that bake_sdf evaluates the narrow band in
+static constexpr int sdf_brick_size = 8;
+
+template <class ValueT, class ScalarT = f32>
+struct sdf_grid
+{
+    using value_t = ValueT;
+    using scalar_t = ScalarT;
+    using pos_t = pos<3, ScalarT>;
+
+    aabb<3, ScalarT> bounds; ///< covers all voxels, bounds.max = bounds.min + voxel_size * dims
+    isize3 dims;
+    ScalarT voxel_size = ScalarT(1);
+    ScalarT scale = ScalarT(1); ///< distance = value * scale
+    cc::vector<ValueT> values;  ///< x-major: values[x + dims.width * (y + dims.height * z)]
+
+    [[nodiscard]] size_t index_of(int x, int y, int z) const
+    {
+        TG_CONTRACT(0 <= x && x < dims.width && 0 <= y && y < dims.height && 0 <= z && z < dims.depth);
+        return size_t(x) + size_t(dims.width) * (size_t(y) + size_t(dims.height) * size_t(z));
+    }
+
+    [[nodiscard]] ValueT& operator()(int x, int y, int z) { return values[index_of(x, y, z)]; }
+    [[nodiscard]] ValueT const& operator()(int x, int y, int z) const { return values[index_of(x, y, z)]; }
+
+    [[nodiscard]] ScalarT distance_at(int x, int y, int z) const { return ScalarT(values[index_of(x, y, z)]) * scale; }
+
+    [[nodiscard]] pos_t center_of(int x, int y, int z) const
+    {
+        return bounds.min + vec<3, ScalarT>(ScalarT(x) + ScalarT(0.5), ScalarT(y) + ScalarT(0.5), ScalarT(z) + ScalarT(0.5)) * voxel_size;
+    }
+};
+
+
+// ======== IMPLEMENTATION ========
+
+namespace detail
+{
+/// allocates the grid and fills it with encode(signed_distance) for every voxel
+template <class ValueT, class ScalarT, class EncodeF>
+void bake_sdf(sdf_grid<ValueT, ScalarT>& grid, mesh_distance<ScalarT> const& md, aabb<3, ScalarT> const& bounds, ScalarT voxel_size, int band_voxels, EncodeF&& encode)
+{
+    TG_CONTRACT(!md.empty());
+    TG_CONTRACT(voxel_size > ScalarT(0));
+    TG_CONTRACT(band_voxels >= 1);
+
+    auto const ext = bounds.max - bounds.min;
+    auto const nx = tg::max(1, int(ceil(ext.x / voxel_size)));
+    auto const ny = tg::max(1, int(ceil(ext.y / voxel_size)));
+    auto const nz = tg::max(1, int(ceil(ext.z / voxel_size)));
+
+    grid.dims = {nx, ny, nz};
+    grid.voxel_size = voxel_size;
+    grid.bounds = {bounds.min, bounds.min + vec<3, ScalarT>(ScalarT(nx), ScalarT(ny), ScalarT(nz)) * voxel_size};
+
+    auto const n = size_t(nx) * size_t(ny) * size_t(nz);
+    TG_CONTRACT(n < size_t(u32(-1)));
+    grid.values.resize(n);
+
+    // 1. exact closest points in all bricks near the surface
+    struct seed
+    {
+        u32 voxel;
+        pos<3, ScalarT> point;
+        vec<3, ScalarT> normal;
+    };
+
+    auto const bs = sdf_brick_size;
+    auto const bx = (nx + bs - 1) / bs;
+    auto const by = (ny + bs - 1) / bs;
+    auto const bz = (nz + bs - 1) / bs;
+    auto const brick_count = size_t(bx) * size_t(by) * size_t(bz);
+    auto const band = ScalarT(band_voxels) * voxel_size;
+
+    cc::vector<cc::vector<seed>> brick_seeds;
+    brick_seeds.resize(brick_count);
+    detail::parallel_for(
+        brick_count,
+        [&](size_t b) {
+            auto const x0 = int(b % size_t(bx)) * bs;
+            auto const y0 = int(b / size_t(bx) % size_t(by)) * bs;
+            auto const z0 = int(b / (size_t(bx) * size_t(by))) * bs;
+            auto const x1 = tg::min(x0 + bs, nx);
+            auto const y1 = tg::min(y0 + bs, ny);
+            auto const z1 = tg::min(z0 + bs, nz);
+
+            // a brick is in the band if any of its voxel centers could be within band of the surface
+            auto const lo = grid.center_of(x0, y0, z0);
+            auto const hi = grid.center_of(x1 - 1, y1 - 1, z1 - 1);
+            auto const center = lo + (hi - lo) / ScalarT(2);
+            auto const radius = distance(lo, hi) / ScalarT(2);
+            if (md.distance(center) > radius + band)
+                return;
+
+            auto& seeds = brick_seeds[b];
+            seeds.reserve(size_t(x1 - x0) * size_t(y1 - y0) * size_t(z1 - z0));
+            for (auto z = z0; z < z1; ++z)
+                for (auto y = y0; y < y1; ++y)
+                    for (auto x = x0; x < x1; ++x)
+                    {
+                        auto const c = md.closest(grid.center_of(x, y, z));
+                        seeds.push_back({u32(grid.index_of(x, y, z)), c.point, c.normal});
+                    }
+        },
+        1);
+
+    cc::vector<pos<3, ScalarT>> seed_points;
+    cc::vector<vec<3, ScalarT>> seed_normals;
+    for (auto const& bsd : brick_seeds)
+        for (auto const& s : bsd)
+        {
+            seed_points.push_back(s.point);
+            seed_normals.push_back(s.normal);
+        }
+
+    auto const value_of = [&](int x, int y, int z, u32 s) {
+        auto const c = grid.center_of(x, y, z);
+        auto const d = distance(c, seed_points[s]);
+        return dot(c - seed_points[s], seed_normals[s]) < ScalarT(0) ? -d : d;
+    };
+
+    if (seed_points.empty())
+    {
+        // the surface is far away from the grid, exact evaluation is all we can do
+        detail::parallel_for(
+            size_t(nz),
+            [&](size_t z) {
+                for (auto y = 0; y < ny; ++y)
+                    for (auto x = 0; x < nx; ++x)
+                        grid(x, y, int(z)) = encode(md.signed_distance(grid.center_of(x, y, int(z))));
+            },
+            1);
+        return;
+    }
+
+    // 2. jump flooding on seed indices
+    auto constexpr no_seed = u32(-1);
+    cc::vector<u32> cur;
+    cc::vector<u32> next;
+    cur.resize(n);
+    next.resize(n);
+    for (auto& s : cur)
+        s = no_seed;
+    {
+        u32 id = 0;
+        for (auto const& bsd : brick_seeds)
+            for (auto const& s : bsd)
+                cur[s.voxel] = id++;
+    }
+    brick_seeds.clear();
+
+    auto const max_dim = tg::max(nx, tg::max(ny, nz));
+    auto first_step = 1;
+    while (first_step * 2 < max_dim)
+        first_step *= 2;
+
+    auto const jfa_pass = [&](int k) {
+        detail::parallel_for(
+            size_t(nz),
+            [&](size_t zi) {
+                auto const z = int(zi);
+                for (auto y = 0; y < ny; ++y)
+                    for (auto x = 0; x < nx; ++x)
+                    {
+                        auto const c = grid.center_of(x, y, z);
+                        auto best = cur[grid.index_of(x, y, z)];
+                        auto best_d2 = best == no_seed ? tg::max<ScalarT>() : distance_sqr(c, seed_points[best]);
+
+                        for (auto dz = -k; dz <= k; dz += k)
+                            for (auto dy = -k; dy <= k; dy += k)
+                                for (auto dx = -k; dx <= k; dx += k)
+                                {
+                                    auto const xx = x + dx;
+                                    auto const yy = y + dy;
+                                    auto const zz = z + dz;
+                                    if (xx < 0 || yy < 0 || zz < 0 || xx >= nx || yy >= ny || zz >= nz)
+                                        continue;
+
+                                    auto const s = cur[grid.index_of(xx, yy, zz)];
+                                    if (s == no_seed || s == best)
+                                        continue;
+
+                                    auto const d2 = distance_sqr(c, seed_points[s]);
+                                    if (d2 < best_d2)
+                                    {
+                                        best_d2 = d2;
+                                        best = s;
+                                    }
+                                }
+
+                        next[grid.index_of(x, y, z)] = best;
+                    }
+            },
+            1);
+        std::swap(cur, next);
+    };
+
+    for (auto k = first_step; k >= 1; k /= 2)
+        jfa_pass(k);
+    jfa_pass(1); // JFA+1 fixes most of the remaining errors
+
+    // 3. signed distances
+    detail::parallel_for(
+        size_t(nz),
+        [&](size_t zi) {
+            auto const z = int(zi);
+            for (auto y = 0; y < ny; ++y)
+                for (auto x = 0; x < nx; ++x)
+                    grid(x, y, z) = encode(value_of(x, y, z, cur[grid.index_of(x, y, z)]));
+        },
+        1);
+}
+}
+
+/// bakes the signed distance field of the mesh into a dense float grid covering bounds
+/// voxels within band_voxels of the surface are exact, the rest is propagated via jump flooding
+template <class ScalarT>
+[[nodiscard]] sdf_grid<ScalarT, ScalarT> bake_sdf(mesh_distance<ScalarT> const& md, aabb<3, ScalarT> const& bounds, ScalarT voxel_size, int band_voxels = 2)
+{
+    sdf_grid<ScalarT, ScalarT> grid;
+    detail::bake_sdf(grid, md, bounds, voxel_size, band_voxels, [](ScalarT d) { return d; });
+    return grid;
+}
+
+/// same as bake_sdf but quantizes to i16 with distances clamped to [-max_distance, max_distance]
+/// (grid.scale = max_distance / 32767, distance_at decodes)
+template <class ScalarT>
+[[nodiscard]] sdf_grid<i16, ScalarT> bake_sdf_i16(mesh_distance<ScalarT> const& md, aabb<3, ScalarT> const& bounds, ScalarT voxel_size, ScalarT max_distance, int band_voxels = 2)
+{
+    TG_CONTRACT(max_distance > ScalarT(0));
+
+    sdf_grid<i16, ScalarT> grid;
+    grid.scale = max_distance / ScalarT(32767);
+    auto const inv_scale = ScalarT(32767) / max_distance;
+    detail::bake_sdf(grid, md, bounds, voxel_size, band_voxels, [inv_scale](ScalarT d) {
+        auto const q = round(clamp(d * inv_scale, ScalarT(-32767), ScalarT(32767)));
+        return i16(q);
+    });
+    return grid;
+}
+} // namespace tg
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include <clean-core/vector.hh>
+
+#include <typed-geometry/detail/parallel.hh>
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/functions/basic/hash.hh>
+#include <typed-geometry/functions/basic/scalar_math.hh>
+#include <typed-geometry/functions/vector/distance.hh>
+#include <typed-geometry/types/pos.hh>
+#include <typed-geometry/types/span.hh>
+
+/**
+ * Spatial hash over points for fixed-radius neighbor queries (SPH, crowds, particle collisions)
+ *
+ * Points are binned into cubic cells of size cell_size, cells are keyed by their integer coordinate (ipos3)
+ * and hashed into a table with one bucket per point (rounded up to a power of two).
+ *
+ * Build:
+ *   auto grid = tg::spatial_hash<float>(points, h); // parallel counting sort, h >= query radius
+ *   grid.build(points, h);                         // rebuild after points moved (reuses memory)
+ *
+ * Queries:
+ *   grid.cell_of(p)                      -> ipos3 of the cell containing p
+ *   grid.for_each_in_cell(c, f)          -> calls f(idx, pos) for all points in cell c
+ *   grid.for_each_in_radius(q, r, f)     -> calls f(idx, distance_sqr) for all points with distance <= r (r <= cell_size)
+ *   grid.radius_search(q, r)             -> cc::vector<u32> with the indices of all points with distance <= r
+ *   grid.for_each_pair(r, f)             -> calls f(i, j, distance_sqr) once for every pair with distance <= r
+ *   grid.for_each_neighbor(r, f)         -> calls f(i, j, distance_sqr) for every ordered pair i != j, in parallel over i
+ *
+ * Notes:
+ *   - radius queries visit the 27 cells around the query, so the radius must not exceed the cell size
+ *   - a cell size close to the query radius gives the best performance
+ *   - points are stored in bucket order, indices passed to callbacks refer to the input span
+ *   - hash collisions only cost time: every stored point remembers its cell and foreign cells are skipped
+ *   - the layout is deterministic (points within a bucket are ordered by input index), even for the parallel build
+ */
+
+namespace tg
+{
+namespace detail
+{
+/// zeroed atomic counters that keep their allocation across rebuilds (copies start empty, they are scratch)
+struct atomic_counters
+{
+    atomic_counters() = default;
+    atomic_counters(atomic_counters const&) {}
+    atomic_counters(atomic_counters&&) = default;
+    atomic_counters& operator=(atomic_counters const&) { return *this; }
+    atomic_counters& operator=(atomic_counters&&) = default;
+
+    /// returns n zeroed counters, only allocates if n exceeds all previous sizes
+    std::atomic<u32>* acquire(size_t n)
+    {
+        if (n > _capacity)
+        {
+            _data.reset(new std::atomic<u32>[n]());
+            _capacity = n;
+            return _data.get();
+        }
+        parallel_for(
+            n, [this](size_t i) { _data[i].store(0, std::memory_order_relaxed); }, 1 << 16);
+        return _data.get();
+    }
+
+private:
+    std::unique_ptr<std::atomic<u32>[]> _data;
+    size_t _capacity = 0;
+};
+}
+
+template <class ScalarT>
+struct spatial_hash
+{
+    using scalar_t = ScalarT;
+    using pos_t = pos<3, ScalarT>;
+
+    // ctors
+public:
+    spatial_hash() = default;
+
+    spatial_hash(span<pos_t const> points, ScalarT cell_size) { build(points, cell_size); }
+
+    /// rebuilds the hash for new point positions (parallel counting sort, linear in the number of points)
+    void build(span<pos_t const> points, ScalarT cell_size);
+
+    // accessors
+public:
+    [[nodiscard]] bool empty() const { return _points.empty(); }
+    [[nodiscard]] size_t size() const { return _points.size(); }
+    [[nodiscard]] ScalarT cell_size() const { return _cell_size; }
+
+    /// number of hash buckets (a power of two)
+    [[nodiscard]] size_t bucket_count() const { return _bucket_start.empty() ? 0 : _bucket_start.size() - 1; }
+
+    /// points in bucket order
+    [[nodiscard]] span<pos_t const> points() const { return {_points.data(), _points.size()}; }
+    /// indices()[i] is the input index of points()[i]
+    [[nodiscard]] span<u32 const> indices() const { return {_indices.data(), _indices.size()}; }
+    /// cells()[i] is the cell of points()[i]
+    [[nodiscard]] span<ipos3 const> cells() const { return {_cells.data(), _cells.size()}; }
+
+    [[nodiscard]] ipos3 cell_of(pos_t const& p) const
+    {
+        return {i32(tg::ifloor(p.x * _inv_cell_size)), i32(tg::ifloor(p.y * _inv_cell_size)), i32(tg::ifloor(p.z * _inv_cell_size))};
+    }
+
+    [[nodiscard]] size_t bucket_of(ipos3 const& c) const { return tg::make_hash(c) & (bucket_count() - 1); }
+
+    // queries
+public:
+    /// calls f(idx, pos) for every point in the cell (idx refers to the input span)
+    template <class F>
+    void for_each_in_cell(ipos3 const& c, F&& f) const;
+
+    /// calls f(idx, distance_sqr) for every point with distance(point, q) <= radius (unsorted)
+    template <class F>
+    void for_each_in_radius(pos_t const& q, ScalarT radius, F&& f) const;
+
+    [[nodiscard]] cc::vector<u32> radius_search(pos_t const& q, ScalarT radius) const
+    {
+        cc::vector<u32> r;
+        for_each_in_radius(q, radius, [&r](u32 idx, ScalarT) { r.push_back(idx); });
+        return r;
+    }
+
+    /// calls f(i, j, distance_sqr) exactly once for every unordered pair of points with distance <= radius
+    template <class F>
+    void for_each_pair(ScalarT radius, F&& f) const;
+
+    /// calls f(i, j, distance_sqr) for every point i and every other point j with distance <= radius
+    /// runs in parallel over i, f is never called concurrently for the same i
+    template <class F>
+    void for_each_neighbor(ScalarT radius, F&& f) const;
+
+private:
+    /// calls f(slot, distance_sqr) for every stored point in the 27 cells around c with distance(point, q) <= radius
+    template <class F>
+    void visit_neighborhood(pos_t const& q, ipos3 const& c, ScalarT radius_sqr, F& f) const;
+
+    ScalarT _cell_size = ScalarT(1);
+    ScalarT _inv_cell_size = ScalarT(1);
+    cc::vector<u32> _bucket_start; ///< points of bucket b are in [_bucket_start[b], _bucket_start[b + 1])
+    cc::vector<pos_t> _points;
+    cc::vector<ipos3> _cells;
+    cc::vector<u32> _indices;
+    cc::vector<u32> _buckets; ///< build scratch: bucket per input point
+    detail::atomic_counters _counts; ///< build scratch: points per bucket, then scatter cursors
+};
+
+
+// ======== IMPLEMENTATION ========
+
+template <class ScalarT>
+void spatial_hash<ScalarT>::build(span<pos_t const> points, ScalarT cell_size)
+{
+    TG_CONTRACT(cell_size > ScalarT(0));
+    TG_CONTRACT(points.size() < size_t(u32(-1)));
+
+    auto const n = points.size();
+    _cell_size = cell_size;
+    _inv_cell_size = ScalarT(1) / cell_size;
+
+    size_t bucket_count = 1;
+    while (bucket_count < n)
+        bucket_count *= 2;
+
+    _bucket_start.resize(bucket_count + 1);
+    _points.resize(n);
+    _cells.resize(n);
+    _indices.resize(n);
+    _buckets.resize(n);
+    if (n == 0)
+    {
+        std::fill(_bucket_start.begin(), _bucket_start.end(), u32(0));
+        return;
+    }
+
+    // counting sort by bucket: histogram, exclusive prefix sum, scatter
+    auto* const counts = _counts.acquire(bucket_count);
+    detail::parallel_for(n, [&](size_t i) {
+        auto const b = u32(bucket_of(cell_of(points[i])));
+        _buckets[i] = b;
+        counts[b].fetch_add(1, std::memory_order_relaxed);
+    });
+
+    auto sum = u32(0);
+    for (size_t b = 0; b < bucket_count; ++b)
+    {
+        _bucket_start[b] = sum;
+        sum += counts[b].load(std::memory_order_relaxed);
+        counts[b].store(_bucket_start[b], std::memory_order_relaxed);
+    }
+    _bucket_start[bucket_count] = sum;
+
+    detail::parallel_for(n, [&](size_t i) { _indices[counts[_buckets[i]].fetch_add(1, std::memory_order_relaxed)] = u32(i); });
+
+    // the parallel scatter leaves buckets in arbitrary order, buckets are tiny so sorting them is cheap
+    detail::parallel_for(
+        bucket_count,
+        [&](size_t b) {
+            auto const begin = _indices.begin() + _bucket_start[b];
+            auto const end = _indices.begin() + _bucket_start[b + 1];
+            if (end - begin > 1)
+                std::sort(begin, end);
+        },
+        1 << 14);
+
+    detail::parallel_for(n, [&](size_t i) {
+        _points[i] = points[_indices[i]];
+        _cells[i] = cell_of(_points[i]);
+    });
+}
+
+template <class ScalarT>
+template <class F>
+void spatial_hash<ScalarT>::for_each_in_cell(ipos3 const& c, F&& f) const
+{
+    if (empty())
+        return;
+
+    auto const b = bucket_of(c);
+    for (auto i = _bucket_start[b]; i < _bucket_start[b + 1]; ++i)
+        if (_cells[i] == c)
+            f(_indices[i], _points[i]);
+}
+
+template <class ScalarT>
+template <class F>
+void spatial_hash<ScalarT>::visit_neighborhood(pos_t const& q, ipos3 const& c, ScalarT radius_sqr, F& f) const
+{
+    // neighboring cells may share a bucket, but the cell check ensures every point is only visited once
+    for (auto dz = -1; dz <= 1; ++dz)
+        for (auto dy = -1; dy <= 1; ++dy)
+            for (auto dx = -1; dx <= 1; ++dx)
+            {
+                auto const nc = ipos3(c.x + dx, c.y + dy, c.z + dz);
+                auto const b = bucket_of(nc);
+                for (auto i = _bucket_start[b]; i < _bucket_start[b + 1]; ++i)
+                {
+                    if (_cells[i] != nc)
+                        continue;
+                    if (auto const d2 = distance_sqr(_points[i], q); d2 <= radius_sqr)
+                        f(i, d2);
+                }
+            }
+}
+
+template <class ScalarT>
+template <class F>
+void spatial_hash<ScalarT>::for_each_in_radius(pos_t const& q, ScalarT radius, F&& f) const
+{
+    TG_CONTRACT(radius <= _cell_size && "radius queries only search the 27 neighboring cells");
+    if (empty())
+        return;
+
+    auto visit = [&](u32 i, ScalarT d2) { f(_indices[i], d2); };
+    visit_neighborhood(q, cell_of(q), radius * radius, visit);
+}
+
+template <class ScalarT>
+template <class F>
+void spatial_hash<ScalarT>::for_each_pair(ScalarT radius, F&& f) const
+{
+    TG_CONTRACT(radius <= _cell_size && "radius queries only search the 27 neighboring cells");
+
+    for (u32 i = 0; i < u32(size()); ++i)
+    {
+        // every pair is found from both sides, only report it from the smaller slot
+        auto visit = [&](u32 j, ScalarT d2) {
+            if (j > i)
+                f(_indices[i], _indices[j], d2);
+        };
+        visit_neighborhood(_points[i], _cells[i], radius * radius, visit);
+    }
+}
+
+template <class ScalarT>
+template <class F>
+void spatial_hash<ScalarT>::for_each_neighbor(ScalarT radius, F&& f) const
+{
+    TG_CONTRACT(radius <= _cell_size && "radius queries only search the 27 neighboring cells");
+
+    // chunks are contiguous in bucket order, so each thread works on a coherent part of the point array
+    detail::parallel_for_chunks(
+        size(),
+        [&](size_t b, size_t e) {
+            for (auto i = u32(b); i < u32(e); ++i)
+            {
+                auto visit = [&](u32 j, ScalarT d2) {
+                    if (j != i)
+                        f(_indices[i], _indices[j], d2);
+                };
+                visit_neighborhood(_points[i], _cells[i], radius * radius, visit);
+            }
+        },
+        1024);
+}
+} // namespace tg
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+
+#include <clean-core/vector.hh>
+
+#include <typed-geometry/detail/parallel.hh>
+#include <typed-geometry/detail/utility.hh>
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/functions/basic/limits.hh>
+#include <typed-geometry/functions/basic/minmax.hh>
+#include <typed-geometry/types/objects/aabb.hh>
+#include <typed-geometry/types/span.hh>
+
+/**
+ * Sweep-and-prune (sort-and-sweep) broadphase over aabbs
+ *
+ * The boxes are kept sorted by their min coordinate along one sweep axis.
+ * Overlapping pairs are found by sweeping over the sorted boxes: box i can only overlap the following
+ * boxes whose min is <= its own max, all other axes are tested explicitly.
+ *
+ * Usage:
+ *   auto sap = tg::sweep_and_prune<3, float>();
+ *   // every frame:
+ *   sap.update(boxes);                        // insertion sort, O(n) for coherent motion
+ *   for (auto [a, b] : sap.find_pairs()) ...  // or find_pairs_parallel() / for_each_pair(f)
+ *
+ * Notes:
+ *   - update() with the same number of boxes assumes that box i is the same object as in the last update
+ *     and repairs the previous order with an insertion sort, which is linear if the order barely changes
+ *   - a different number of boxes (or too many swaps) triggers a full sort and chooses a new sweep axis
+ *     (the one with the largest variance of box centers) unless an axis was given in the constructor
+ *   - pairs are (a, b) with a < b, indices refer to the span given to update()
+ *   - boxes that only touch are reported as overlapping (same as intersects(aabb, aabb))
+ */
+
+namespace tg
+{
+template <int D, class ScalarT>
+struct sweep_and_prune
+{
+    using scalar_t = ScalarT;
+    using aabb_t = aabb<D, ScalarT>;
+    using pair_t = pair<u32, u32>;
+
+    // ctors
+public:
+    /// axis < 0 chooses the sweep axis automatically on every full sort
+    explicit sweep_and_prune(int axis = -1) : _fixed_axis(axis) { TG_CONTRACT(axis < D); }
+
+    /// updates the box positions (exploits frame-to-frame coherence if the number of boxes is unchanged)
+    void update(span<aabb_t const> boxes);
+
+    void clear()
+    {
+        _sorted.clear();
+        _order.clear();
+    }
+
+    // accessors
+public:
+    [[nodiscard]] bool empty() const { return _sorted.empty(); }
+    [[nodiscard]] size_t size() const { return _sorted.size(); }
+
+    /// current sweep axis
+    [[nodiscard]] int axis() const { return _axis; }
+
+    /// order()[i] is the input index of sorted_boxes()[i]
+    [[nodiscard]] span<u32 const> order() const { return {_order.data(), _order.size()}; }
+    /// boxes sorted by their min along axis()
+    [[nodiscard]] span<aabb_t const> sorted_boxes() const { return {_sorted.data(), _sorted.size()}; }
+
+    /// number of element moves done by the insertion sort in the last update (0 after a full sort)
+    [[nodiscard]] size_t swap_count() const { return _swap_count; }
+
+    // queries
+public:
+    /// calls f(a, b) with a < b for every pair of overlapping boxes
+    template <class F>
+    void for_each_pair(F&& f) const
+    {
+        sweep(0, _sorted.size(), f);
+    }
+
+    [[nodiscard]] cc::vector<pair_t> find_pairs() const
+    {
+        cc::vector<pair_t> r;
+        for_each_pair([&r](u32 a, u32 b) { r.push_back({a, b}); });
+        return r;
+    }
+
+    /// same as find_pairs, but the sweep is partitioned along the sweep axis and runs in parallel
+    /// (the result is identical to find_pairs, including the order)
+    [[nodiscard]] cc::vector<pair_t> find_pairs_parallel() const;
+
+private:
+    /// reports all pairs (i, j) of sorted slots with begin <= i < end and i < j
+    template <class F>
+    void sweep(size_t begin, size_t end, F& f) const;
+
+    void full_sort(span<aabb_t const> boxes);
+
+    int _fixed_axis;
+    int _axis = 0;
+    size_t _swap_count = 0;
+    cc::vector<aabb_t> _sorted;
+    cc::vector<u32> _order;
+};
+
+
+// ======== IMPLEMENTATION ========
+
+template <int D, class ScalarT>
+void sweep_and_prune<D, ScalarT>::update(span<aabb_t const> boxes)
+{
+    TG_CONTRACT(boxes.size() < size_t(u32(-1)));
+
+    auto const n = boxes.size();
+    if (n != _sorted.size())
+    {
+        full_sort(boxes);
+        return;
+    }
+
+    for (size_t i = 0; i < n; ++i)
+        _sorted[i] = boxes[_order[i]];
+
+    // insertion sort of the previous order, bail out to a full sort if the scene changed too much
+    auto const max_swaps = 8 * n + 64;
+    auto const a = _axis;
+    _swap_count = 0;
+    for (size_t i = 1; i < n; ++i)
+    {
+        auto const key = _sorted[i];
+        auto const key_idx = _order[i];
+        auto j = i;
+        while (j > 0 && _sorted[j - 1].min[a] > key.min[a])
+        {
+            _sorted[j] = _sorted[j - 1];
+            _order[j] = _order[j - 1];
+            --j;
+        }
+        _sorted[j] = key;
+        _order[j] = key_idx;
+
+        _swap_count += i - j;
+        if (_swap_count > max_swaps)
+        {
+            full_sort(boxes);
+            return;
+        }
+    }
+}
+
+template <int D, class ScalarT>
+void sweep_and_prune<D, ScalarT>::full_sort(span<aabb_t const> boxes)
+{
+    auto const n = boxes.size();
+    _swap_count = 0;
+
+    if (_fixed_axis >= 0)
+        _axis = _fixed_axis;
+    else if (n > 0)
+    {
+        // axis with the largest variance of the box centers separates the boxes best
+        ScalarT sum[D] = {};
+        ScalarT sum_sqr[D] = {};
+        for (auto const& b : boxes)
+            for (auto i = 0; i < D; ++i)
+            {
+                auto const c = (b.min[i] + b.max[i]) / ScalarT(2);
+                sum[i] += c;
+                sum_sqr[i] += c * c;
+            }
+
+        auto best_var = ScalarT(-1);
+        for (auto i = 0; i < D; ++i)
+        {
+            auto const var = sum_sqr[i] - sum[i] * sum[i] / ScalarT(n);
+            if (var > best_var)
+            {
+                best_var = var;
+                _axis = i;
+            }
+        }
+    }
+
+    auto const a = _axis;
+    _order.resize(n);
+    for (size_t i = 0; i < n; ++i)
+        _order[i] = u32(i);
+    std::sort(_order.begin(), _order.end(), [&](u32 l, u32 r) { return boxes[l].min[a] < boxes[r].min[a]; });
+
+    _sorted.resize(n);
+    for (size_t i = 0; i < n; ++i)
+        _sorted[i] = boxes[_order[i]];
+}
+
+template <int D, class ScalarT>
+template <class F>
+void sweep_and_prune<D, ScalarT>::sweep(size_t begin, size_t end, F& f) const
+{
+    auto const a = _axis;
+    auto const n = _sorted.size();
+    for (auto i = begin; i < end; ++i)
+    {
+        auto const& bi = _sorted[i];
+        for (auto j = i + 1; j < n && _sorted[j].min[a] <= bi.max[a]; ++j)
+        {
+            auto const& bj = _sorted[j];
+
+            auto overlap = true;
+            for (auto k = 0; k < D; ++k)
+                overlap = overlap && bi.min[k] <= bj.max[k] && bj.min[k] <= bi.max[k];
+
+            if (overlap)
+            {
+                auto const oi = _order[i];
+                auto const oj = _order[j];
+                f(oi < oj ? oi : oj, oi < oj ? oj : oi);
+            }
+        }
+    }
+}
+
+template <int D, class ScalarT>
+cc::vector<typename sweep_and_prune<D, ScalarT>::pair_t> sweep_and_prune<D, ScalarT>::find_pairs_parallel() const
+{
+    // each partition is a contiguous range of the sweep axis and only reports pairs starting in it,
+    // so the partitions never produce the same pair twice
+    auto const n = _sorted.size();
+    if (n < 4096)
+        return find_pairs();
+
+    auto const parts = size_t(detail::parallel_thread_count());
+    auto const part_size = (n + parts - 1) / parts;
+
+    cc::vector<cc::vector<pair_t>> part_pairs;
+    part_pairs.resize(parts);
+    detail::parallel_for(
+        parts,
+        [&](size_t p) {
+            auto const begin = tg::min(n, p * part_size);
+            auto const end = tg::min(n, begin + part_size);
+            auto& r = part_pairs[p];
+            auto collect = [&r](u32 a, u32 b) { r.push_back({a, b}); };
+            sweep(begin, end, collect);
+        },
+        1);
+
+    size_t total = 0;
+    for (auto const& pp : part_pairs)
+        total += pp.size();
+
+    cc::vector<pair_t> r;
+    r.reserve(total);
+    for (auto const& pp : part_pairs)
+        for (auto const& p : pp)
+            r.push_back(p);
+    return r;
+}
+} // namespace tg
@@ -0,0 +1,548 @@
+#pragma once
+
+#include <algorithm>
+
+#include <clean-core/vector.hh>
+
+#include <typed-geometry/detail/parallel.hh>
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/functions/basic/minmax.hh>
+#include <typed-geometry/functions/basic/scalar_math.hh>
+#include <typed-geometry/functions/objects/intersection.hh>
+#include <typed-geometry/functions/vector/cross.hh>
+#include <typed-geometry/functions/vector/dot.hh>
+#include <typed-geometry/functions/vector/math.hh>
+#include <typed-geometry/types/objects/aabb.hh>
+#include <typed-geometry/types/objects/triangle.hh>
+#include <typed-geometry/types/pos.hh>
+#include <typed-geometry/types/size.hh>
+#include <typed-geometry/types/span.hh>
+
+/**
+ * Surface and solid voxelization of triangle meshes / soups
+ *
+ * Usage:
+ *   auto surf = tg::voxelize_surface(triangles, bounds, voxel_size);          // dense bit grid
+ *   auto cells = tg::voxelize_surface_sparse(triangles, bounds, voxel_size);  // sorted cc::vector<ipos3>
+ *   auto solid = tg::voxelize_solid(triangles, bounds, voxel_size);           // voxel centers inside the mesh
+ *   // all functions also accept an indexed mesh (vertices, indices)
+ *
+ *   if (surf(x, y, z)) ...
+ *   surf.for_each_voxel([](tg::ipos3 v) { ... });
+ *
+ * Algorithm (Schwarz & Seidel 2010, "Fast Parallel Surface and Solid Voxelization on GPUs"):
+ *   - every triangle precomputes its plane and the edge normals of its xy, yz, and zx projections
+ *     (offset by the critical voxel corner), so the triangle-voxel overlap test is a handful of
+ *     multiply-adds and the xy test is hoisted out of the inner z loop
+ *   - surface: a voxel is set iff it overlaps the triangle (same result as intersects(triangle3, aabb3))
+ *   - solid: a ray along +x through every voxel center row flips the parity of all voxels behind each
+ *     triangle crossing, followed by a prefix xor per row (a top-left style rule keeps shared edges watertight)
+ *   - triangles are binned into z-slabs of the grid and the slabs are processed in parallel (every slab owns its rows)
+ *
+ * Notes:
+ *   - voxels are cubic, the grid covers bounds (rounded up to whole voxels) like sdf_grid
+ *   - voxels are closed boxes, so triangles touching a voxel face mark both neighbors
+ *   - solid voxelization requires a closed mesh, the winding is irrelevant (parity)
+ *   - degenerate (zero-area) triangles fall back to intersects(triangle3, aabb3) for surface voxelization
+ *     and are ignored by solid voxelization
+ */
+
+namespace tg
+{
+/// dense voxel grid with one bit per voxel
+template <class ScalarT>
+struct voxel_grid
+{
+    using scalar_t = ScalarT;
+    using pos_t = pos<3, ScalarT>;
+
+    aabb<3, ScalarT> bounds; ///< covers all voxels, bounds.max = bounds.min + voxel_size * dims
+    isize3 dims;
+    ScalarT voxel_size = ScalarT(1);
+    int words_per_row = 0; ///< u64 words per x-row
+    cc::vector<u64> bits;  ///< bit x % 64 of bits[x / 64 + words_per_row * (y + dims.height * z)]
+
+    [[nodiscard]] size_t row_of(int y, int z) const { return size_t(words_per_row) * (size_t(y) + size_t(dims.height) * size_t(z)); }
+
+    [[nodiscard]] bool operator()(int x, int y, int z) const
+    {
+        TG_CONTRACT(0 <= x && x < dims.width && 0 <= y && y < dims.height && 0 <= z && z < dims.depth);
+        return (bits[row_of(y, z) + size_t(x / 64)] >> (x % 64)) & 1;
+    }
+    [[nodiscard]] bool operator()(ipos3 const& v) const { return operator()(v.x, v.y, v.z); }
+
+    void set(int x, int y, int z)
+    {
+        TG_CONTRACT(0 <= x && x < dims.width && 0 <= y && y < dims.height && 0 <= z && z < dims.depth);
+        bits[row_of(y, z) + size_t(x / 64)] |= u64(1) << (x % 64);
+    }
+
+    /// number of set voxels
+    [[nodiscard]] size_t count() const
+    {
+        size_t c = 0;
+        for (auto v : bits)
+            for (; v; v &= v - 1)
+                ++c;
+        return c;
+    }
+
+    [[nodiscard]] aabb<3, ScalarT> voxel_bounds(int x, int y, int z) const
+    {
+        auto const lo = bounds.min + vec<3, ScalarT>(ScalarT(x), ScalarT(y), ScalarT(z)) * voxel_size;
+        return {lo, lo + vec<3, ScalarT>(voxel_size)};
+    }
+
+    [[nodiscard]] pos_t center_of(int x, int y, int z) const
+    {
+        return bounds.min + vec<3, ScalarT>(ScalarT(x) + ScalarT(0.5), ScalarT(y) + ScalarT(0.5), ScalarT(z) + ScalarT(0.5)) * voxel_size;
+    }
+
+    /// calls f(ipos3) for every set voxel in x-major order
+    template <class F>
+    void for_each_voxel(F&& f) const
+    {
+        for (auto z = 0; z < dims.depth; ++z)
+            for (auto y = 0; y < dims.height; ++y)
+            {
+                auto const row = row_of(y, z);
+                for (auto w = 0; w < words_per_row; ++w)
+                {
+                    auto x = w * 64;
+                    for (auto v = bits[row + size_t(w)]; v; v >>= 1, ++x)
+                        if (v & 1)
+                            f(ipos3(x, y, z));
+                }
+            }
+    }
+};
+
+
+// ======== IMPLEMENTATION ========
+
+namespace detail
+{
+/// per-triangle data for the overlap test, all coordinates are relative to the grid origin
+template <class ScalarT>
+struct voxelize_triangle_setup
+{
+    using vec2_t = vec<2, ScalarT>;
+
+    triangle<3, ScalarT> tri; ///< only used for degenerate triangles
+    vec<3, ScalarT> n;
+    ScalarT d1, d2;
+    vec2_t n_xy[3], n_yz[3], n_zx[3];
+    ScalarT d_xy[3], d_yz[3], d_zx[3];
+    ipos3 lo, hi; ///< inclusive voxel range of the bounding box
+    bool degenerate;
+
+    /// returns false if the triangle does not touch the grid
+    bool init(triangle<3, ScalarT> const& t, pos<3, ScalarT> const& origin, ScalarT vs, isize3 dims)
+    {
+        vec<3, ScalarT> const v[3] = {t.pos0 - origin, t.pos1 - origin, t.pos2 - origin};
+        tri = t;
+
+        auto lo_f = tg::min(v[0], tg::min(v[1], v[2]));
+        auto hi_f = tg::max(v[0], tg::max(v[1], v[2]));
+        int const dim[3] = {dims.width, dims.height, dims.depth};
+        for (auto i = 0; i < 3; ++i)
+        {
+            if (hi_f[i] < ScalarT(0) || lo_f[i] > ScalarT(dim[i]) * vs)
+                return false;
+            lo[i] = tg::clamp(int(tg::ifloor(lo_f[i] / vs)), 0, dim[i] - 1);
+            hi[i] = tg::clamp(int(tg::ifloor(hi_f[i] / vs)), 0, dim[i] - 1);
+        }
+
+        vec<3, ScalarT> const e[3] = {v[1] - v[0], v[2] - v[1], v[0] - v[2]};
+        n = cross(e[0], e[1]);
+        degenerate = n == vec<3, ScalarT>::zero;
+        if (degenerate)
+            return true;
+
+        // plane: the voxel overlaps iff its critical corner and the opposite corner lie on different sides
+        auto const c = vec<3, ScalarT>(n.x > 0 ? vs : ScalarT(0), n.y > 0 ? vs : ScalarT(0), n.z > 0 ? vs : ScalarT(0));
+        d1 = dot(n, c - v[0]);
+        d2 = dot(n, vec<3, ScalarT>(vs) - c - v[0]);
+
+        // projections: inward edge normals, offset so that the test uses the voxel min corner
+        auto const s_xy = n.z >= 0 ? ScalarT(1) : ScalarT(-1);
+        auto const s_yz = n.x >= 0 ? ScalarT(1) : ScalarT(-1);
+        auto const s_zx = n.y >= 0 ? ScalarT(1) : ScalarT(-1);
+        auto const offset = [vs](vec2_t const& en, vec2_t const& p) { return -dot(en, p) + tg::max(ScalarT(0), vs * en.x) + tg::max(ScalarT(0), vs * en.y); };
+        for (auto i = 0; i < 3; ++i)
+        {
+            n_xy[i] = vec2_t(-e[i].y, e[i].x) * s_xy;
+            d_xy[i] = offset(n_xy[i], vec2_t(v[i].x, v[i].y));
+            n_yz[i] = vec2_t(-e[i].z, e[i].y) * s_yz;
+            d_yz[i] = offset(n_yz[i], vec2_t(v[i].y, v[i].z));
+            n_zx[i] = vec2_t(-e[i].x, e[i].z) * s_zx;
+            d_zx[i] = offset(n_zx[i], vec2_t(v[i].z, v[i].x));
+        }
+        return true;
+    }
+
+    [[nodiscard]] static bool edges_pass(vec2_t const (&en)[3], ScalarT const (&d)[3], ScalarT a, ScalarT b)
+    {
+        return en[0].x * a + en[0].y * b + d[0] >= 0 && //
+               en[1].x * a + en[1].y * b + d[1] >= 0 && //
+               en[2].x * a + en[2].y * b + d[2] >= 0;
+    }
+
+    /// calls f(x, y, z) for every voxel in [lo, hi] with z in [z_begin, z_end) that overlaps the triangle
+    template <class F>
+    void for_each_overlap(aabb<3, ScalarT> const& grid_bounds, ScalarT vs, int z_begin, int z_end, F& f) const
+    {
+        auto const z0 = tg::max(lo.z, z_begin);
+        auto const z1 = tg::min(hi.z + 1, z_end);
+        if (z0 >= z1)
+            return;
+
+        if (degenerate)
+        {
+            for (auto z = z0; z < z1; ++z)
+                for (auto y = lo.y; y <= hi.y; ++y)
+                    for (auto x = lo.x; x <= hi.x; ++x)
+                    {
+                        auto const vmin = grid_bounds.min + vec<3, ScalarT>(ScalarT(x), ScalarT(y), ScalarT(z)) * vs;
+                        if (intersects(tri, aabb<3, ScalarT>(vmin, vmin + vec<3, ScalarT>(vs))))
+                            f(x, y, z);
+                    }
+            return;
+        }
+
+        for (auto y = lo.y; y <= hi.y; ++y)
+        {
+            auto const py = ScalarT(y) * vs;
+            for (auto x = lo.x; x <= hi.x; ++x)
+            {
+                auto const px = ScalarT(x) * vs;
+                if (!edges_pass(n_xy, d_xy, px, py))
+                    continue;
+
+                auto const nxy = n.x * px + n.y * py;
+                for (auto z = z0; z < z1; ++z)
+                {
+                    auto const pz = ScalarT(z) * vs;
+                    auto const np = nxy + n.z * pz;
+                    auto const a = np + d1;
+                    auto const b = np + d2;
+                    if ((a > 0 && b > 0) || (a < 0 && b < 0))
+                        continue;
+                    if (edges_pass(n_yz, d_yz, py, pz) && edges_pass(n_zx, d_zx, pz, px))
+                        f(x, y, z);
+                }
+            }
+        }
+    }
+};
+
+/// sets up the grid covering bounds, the bit storage is only allocated (and cleared) if allocate_bits is true
+template <class ScalarT>
+void voxel_grid_init(voxel_grid<ScalarT>& grid, aabb<3, ScalarT> const& bounds, ScalarT voxel_size, bool allocate_bits = true)
+{
+    TG_CONTRACT(voxel_size > ScalarT(0));
+
+    auto const ext = bounds.max - bounds.min;
+    auto const nx = tg::max(1, int(ceil(ext.x / voxel_size)));
+    auto const ny = tg::max(1, int(ceil(ext.y / voxel_size)));
+    auto const nz = tg::max(1, int(ceil(ext.z / voxel_size)));
+
+    grid.dims = {nx, ny, nz};
+    grid.voxel_size = voxel_size;
+    grid.bounds = {bounds.min, bounds.min + vec<3, ScalarT>(ScalarT(nx), ScalarT(ny), ScalarT(nz)) * voxel_size};
+    grid.words_per_row = (nx + 63) / 64;
+    if (!allocate_bits)
+        return;
+
+    grid.bits.resize(size_t(grid.words_per_row) * size_t(ny) * size_t(nz));
+    std::fill(grid.bits.begin(), grid.bits.end(), u64(0));
+}
+
+/// splits the z range into slabs and bins the triangles whose voxel z-range [lo_z, hi_z] overlaps them
+struct voxelize_bins
+{
+    int slab = 1;
+    cc::vector<cc::vector<u32>> tris;
+
+    template <class RangeF>
+    voxelize_bins(int depth, size_t tri_count, RangeF&& z_range_of)
+    {
+        // a few slabs per thread balance uneven triangle distributions
+        auto const target = size_t(detail::parallel_thread_count()) * 4;
+        slab = tg::max(1, int((size_t(depth) + target - 1) / target));
+        tris.resize(size_t((depth + slab - 1) / slab));
+
+        for (u32 i = 0; i < u32(tri_count); ++i)
+        {
+            int z0, z1;
+            if (!z_range_of(i, z0, z1))
+                continue;
+            for (auto b = z0 / slab; b <= z1 / slab; ++b)
+                tris[size_t(b)].push_back(i);
+        }
+    }
+
+    [[nodiscard]] size_t size() const { return tris.size(); }
+};
+
+template <class ScalarT>
+cc::vector<voxelize_triangle_setup<ScalarT>> voxelize_setup(span<triangle<3, ScalarT> const> triangles, voxel_grid<ScalarT> const& grid, cc::vector<u8>& valid)
+{
+    TG_CONTRACT(triangles.size() < size_t(u32(-1)));
+
+    cc::vector<voxelize_triangle_setup<ScalarT>> setups;
+    setups.resize(triangles.size());
+    valid.resize(triangles.size());
+    detail::parallel_for(triangles.size(), [&](size_t i) { valid[i] = setups[i].init(triangles[i], grid.bounds.min, grid.voxel_size, grid.dims); });
+    return setups;
+}
+
+template <class ScalarT>
+cc::vector<triangle<3, ScalarT>> voxelize_triangles_of(span<pos<3, ScalarT> const> vertices, span<u32 const> indices)
+{
+    TG_CONTRACT(indices.size() % 3 == 0);
+
+    cc::vector<triangle<3, ScalarT>> tris;
+    tris.resize(indices.size() / 3);
+    for (size_t i = 0; i < tris.size(); ++i)
+    {
+        TG_CONTRACT(indices[3 * i + 0] < vertices.size() && indices[3 * i + 1] < vertices.size() && indices[3 * i + 2] < vertices.size());
+        tris[i] = {vertices[indices[3 * i + 0]], vertices[indices[3 * i + 1]], vertices[indices[3 * i + 2]]};
+    }
+    return tris;
+}
+}
+
+/// marks every voxel that overlaps a triangle (same result as intersects(triangle3, aabb3) per voxel)
+template <class ScalarT>
+[[nodiscard]] voxel_grid<ScalarT> voxelize_surface(span<triangle<3, ScalarT> const> triangles, aabb<3, ScalarT> const& bounds, ScalarT voxel_size)
+{
+    voxel_grid<ScalarT> grid;
+    detail::voxel_grid_init(grid, bounds, voxel_size);
+
+    cc::vector<u8> valid;
+    auto const setups = detail::voxelize_setup(triangles, grid, valid);
+    auto const bins = detail::voxelize_bins(grid.dims.depth, triangles.size(), [&](u32 i, int& z0, int& z1) {
+        z0 = setups[i].lo.z;
+        z1 = setups[i].hi.z;
+        return valid[i] != 0;
+    });
+
+    detail::parallel_for(
+        bins.size(),
+        [&](size_t b) {
+            auto const z_begin = int(b) * bins.slab;
+            auto const z_end = tg::min(z_begin + bins.slab, grid.dims.depth);
+            auto mark = [&grid](int x, int y, int z) { grid.set(x, y, z); };
+            for (auto i : bins.tris[b])
+                setups[i].for_each_overlap(grid.bounds, grid.voxel_size, z_begin, z_end, mark);
+        },
+        1);
+    return grid;
+}
+
+/// same as voxelize_surface but returns the overlapped voxels as a sorted list (by z, y, x) without duplicates
+/// memory is proportional to the surface, not to the grid volume
+template <class ScalarT>
+[[nodiscard]] cc::vector<ipos3> voxelize_surface_sparse(span<triangle<3, ScalarT> const> triangles, aabb<3, ScalarT> const& bounds, ScalarT voxel_size)
+{
+    // only the grid dimensions are needed, the bit storage stays empty
+    voxel_grid<ScalarT> grid;
+    detail::voxel_grid_init(grid, bounds, voxel_size, false);
+
+    cc::vector<u8> valid;
+    auto const setups = detail::voxelize_setup(triangles, grid, valid);
+    auto const bins = detail::voxelize_bins(grid.dims.depth, triangles.size(), [&](u32 i, int& z0, int& z1) {
+        z0 = setups[i].lo.z;
+        z1 = setups[i].hi.z;
+        return valid[i] != 0;
+    });
+
+    auto const less = [](ipos3 const& a, ipos3 const& b) {
+        if (a.z != b.z)
+            return a.z < b.z;
+        if (a.y != b.y)
+            return a.y < b.y;
+        return a.x < b.x;
+    };
+
+    cc::vector<cc::vector<ipos3>> bin_voxels;
+    bin_voxels.resize(bins.size());
+    detail::parallel_for(
+        bins.size(),
+        [&](size_t b) {
+            auto const z_begin = int(b) * bins.slab;
+            auto const z_end = tg::min(z_begin + bins.slab, grid.dims.depth);
+            auto& r = bin_voxels[b];
+            auto collect = [&r](int x, int y, int z) { r.push_back({x, y, z}); };
+            for (auto i : bins.tris[b])
+                setups[i].for_each_overlap(grid.bounds, grid.voxel_size, z_begin, z_end, collect);
+
+            std::sort(r.begin(), r.end(), less);
+            r.resize(size_t(std::unique(r.begin(), r.end()) - r.begin()));
+        },
+        1);
+
+    // slabs are disjoint in z, so concatenating them keeps the order
+    size_t total = 0;
+    for (auto const& bv : bin_voxels)
+        total += bv.size();
+
+    cc::vector<ipos3> r;
+    r.reserve(total);
+    for (auto const& bv : bin_voxels)
+        for (auto const& v : bv)
+            r.push_back(v);
+    return r;
+}
+
+/// marks every voxel whose center is inside the closed mesh (parity of ray crossings along +x)
+template <class ScalarT>
+[[nodiscard]] voxel_grid<ScalarT> voxelize_solid(span<triangle<3, ScalarT> const> triangles, aabb<3, ScalarT> const& bounds, ScalarT voxel_size)
+{
+    TG_CONTRACT(triangles.size() < size_t(u32(-1)));
+
+    voxel_grid<ScalarT> grid;
+    detail::voxel_grid_init(grid, bounds, voxel_size);
+
+    auto const vs = voxel_size;
+    auto const nx = grid.dims.width;
+    auto const ny = grid.dims.height;
+    auto const nz = grid.dims.depth;
+    auto const origin = grid.bounds.min;
+
+    // voxel center range of a coordinate interval: centers (i + 0.5) * vs in [lo, hi]
+    auto const center_range = [vs](ScalarT lo, ScalarT hi, int n, int& i0, int& i1) {
+        i0 = tg::max(0, int(tg::iceil(lo / vs - ScalarT(0.5))));
+        i1 = tg::min(n - 1, int(tg::ifloor(hi / vs - ScalarT(0.5))));
+        return i0 <= i1;
+    };
+
+    auto const bins = detail::voxelize_bins(nz, triangles.size(), [&](u32 i, int& z0, int& z1) {
+        auto const& t = triangles[i];
+        auto const lo = tg::min(t.pos0.z, tg::min(t.pos1.z, t.pos2.z)) - origin.z;
+        auto const hi = tg::max(t.pos0.z, tg::max(t.pos1.z, t.pos2.z)) - origin.z;
+        return center_range(lo, hi, nz, z0, z1);
+    });
+
+    detail::parallel_for(
+        bins.size(),
+        [&](size_t b) {
+            auto const z_begin = int(b) * bins.slab;
+            auto const z_end = tg::min(z_begin + bins.slab, nz);
+
+            for (auto ti : bins.tris[b])
+            {
+                auto const& t = triangles[ti];
+                vec<3, ScalarT> const v[3] = {t.pos0 - origin, t.pos1 - origin, t.pos2 - origin};
+                auto const n = cross(v[1] - v[0], v[2] - v[0]);
+                if (n.x == ScalarT(0))
+                    continue; // parallel to the rays
+
+                // 2D edge functions in the yz-plane, E_i(y, z) = a_i * y + b_i * z + c_i >= 0 inside
+                ScalarT ea[3], eb[3], ec[3];
+                for (auto i = 0; i < 3; ++i)
+                {
+                    auto const& p = v[i];
+                    auto const& q = v[(i + 1) % 3];
+                    ea[i] = p.z - q.z;
+                    eb[i] = q.y - p.y;
+                    ec[i] = p.y * q.z - p.z * q.y;
+                }
+                auto const area = ea[0] * v[2].y + eb[0] * v[2].z + ec[0];
+                if (area == ScalarT(0))
+                    continue;
+                bool owned[3];
+                for (auto i = 0; i < 3; ++i)
+                {
+                    if (area < ScalarT(0))
+                    {
+                        ea[i] = -ea[i];
+                        eb[i] = -eb[i];
+                        ec[i] = -ec[i];
+                    }
+                    // the two triangles sharing an edge see exactly negated edge functions, so exactly one owns E == 0
+                    owned[i] = ea[i] > 0 || (ea[i] == 0 && eb[i] > 0);
+                }
+
+                int y0, y1, z0, z1;
+                if (!center_range(tg::min(v[0].y, tg::min(v[1].y, v[2].y)), tg::max(v[0].y, tg::max(v[1].y, v[2].y)), ny, y0, y1))
+                    continue;
+                if (!center_range(tg::min(v[0].z, tg::min(v[1].z, v[2].z)), tg::max(v[0].z, tg::max(v[1].z, v[2].z)), nz, z0, z1))
+                    continue;
+                z0 = tg::max(z0, z_begin);
+                z1 = tg::min(z1, z_end - 1);
+
+                for (auto z = z0; z <= z1; ++z)
+                {
+                    auto const cz = (ScalarT(z) + ScalarT(0.5)) * vs;
+                    for (auto y = y0; y <= y1; ++y)
+                    {
+                        auto const cy = (ScalarT(y) + ScalarT(0.5)) * vs;
+                        auto inside = true;
+                        for (auto i = 0; i < 3; ++i)
+                        {
+                            auto const e = ea[i] * cy + eb[i] * cz + ec[i];
+                            inside = inside && (owned[i] ? e >= 0 : e > 0);
+                        }
+                        if (!inside)
+                            continue;
+
+                        // the crossing flips all voxels whose center lies behind it
+                        auto const cx = v[0].x - (n.y * (cy - v[0].y) + n.z * (cz - v[0].z)) / n.x;
+                        auto const first = tg::max(0, int(tg::ifloor(cx / vs - ScalarT(0.5))) + 1);
+                        if (first < nx)
+                            grid.bits[grid.row_of(y, z) + size_t(first / 64)] ^= u64(1) << (first % 64);
+                    }
+                }
+            }
+
+            // prefix xor turns the crossing flips into inside runs
+            for (auto z = z_begin; z < z_end; ++z)
+                for (auto y = 0; y < ny; ++y)
+                {
+                    auto const row = grid.bits.data() + grid.row_of(y, z);
+                    u64 carry = 0;
+                    for (auto w = 0; w < grid.words_per_row; ++w)
+                    {
+                        auto v = row[w];
+                        v ^= v << 1;
+                        v ^= v << 2;
+                        v ^= v << 4;
+                        v ^= v << 8;
+                        v ^= v << 16;
+                        v ^= v << 32;
+                        v ^= carry;
+                        carry = (v >> 63) ? ~u64(0) : u64(0);
+                        row[w] = v;
+                    }
+                    // open meshes can leave the parity set past the last voxel
+                    if (nx % 64 != 0)
+                        row[grid.words_per_row - 1] &= (u64(1) << (nx % 64)) - 1;
+                }
+        },
+        1);
+    return grid;
+}
+
+// indexed mesh versions
+
+template <class ScalarT>
+[[nodiscard]] voxel_grid<ScalarT> voxelize_surface(span<pos<3, ScalarT> const> vertices, span<u32 const> indices, aabb<3, ScalarT> const& bounds, ScalarT voxel_size)
+{
+    auto const tris = detail::voxelize_triangles_of(vertices, indices);
+    return voxelize_surface(span<triangle<3, ScalarT> const>(tris.data(), tris.size()), bounds, voxel_size);
+}
+template <class ScalarT>
+[[nodiscard]] cc::vector<ipos3> voxelize_surface_sparse(span<pos<3, ScalarT> const> vertices, span<u32 const> indices, aabb<3, ScalarT> const& bounds, ScalarT voxel_size)
+{
+    auto const tris = detail::voxelize_triangles_of(vertices, indices);
+    return voxelize_surface_sparse(span<triangle<3, ScalarT> const>(tris.data(), tris.size()), bounds, voxel_size);
+}
+template <class ScalarT>
+[[nodiscard]] voxel_grid<ScalarT> voxelize_solid(span<pos<3, ScalarT> const> vertices, span<u32 const> indices, aabb<3, ScalarT> const& bounds, ScalarT voxel_size)
+{
+    auto const tris = detail::voxelize_triangles_of(vertices, indices);
+    return voxelize_solid(span<triangle<3, ScalarT> const>(tris.data(), tris.size()), bounds, voxel_size);
+}
+} // namespace tg
@@ -79,4 +79,15 @@ template <int D, class ScalarT>
 
     return true;
 }
+
+/// true iff the last row is exactly (0, ..., 0, 1), i.e. m does not need a perspective divide
+template <int D, class ScalarT>
+[[nodiscard]] constexpr bool is_affine(mat<D, D, ScalarT> const& m)
+{
+    for (auto i = 0; i < D - 1; ++i)
+        if (m[i][D - 1] != ScalarT(0))
+            return false;
+
+    return m[D - 1][D - 1] == ScalarT(1);
+}
 }
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <typed-geometry/detail/operators/ops_mat.hh>
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/functions/basic/scalar_math.hh>
+#include <typed-geometry/functions/matrix/inverse.hh>
+#include <typed-geometry/types/dir.hh>
+#include <typed-geometry/types/mat.hh>
+#include <typed-geometry/types/objects/aabb.hh>
+#include <typed-geometry/types/pos.hh>
+#include <typed-geometry/types/transform.hh>
+#include <typed-geometry/types/vec.hh>
+
+// Functions for affine<D, ScalarT>
+//
+// compared to mat<D+1, D+1>:
+//   - affine * affine skips the last row (affine3: 63 instead of 112 flops)
+//   - affine * pos never needs the perspective divide
+//   - inverse only inverts the DxD linear part
+
+namespace tg
+{
+// ================================= conversions =================================
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr affine<D, ScalarT> affine<D, ScalarT>::from_mat(mat<D + 1, D + 1, ScalarT> const& m)
+{
+    for (auto i = 0; i < D; ++i)
+        TG_ASSERT(m[i][D] == ScalarT(0) && "not an affine matrix");
+    TG_ASSERT(m[D][D] == ScalarT(1) && "not an affine matrix");
+
+    return {mat<D, D, ScalarT>(m), vec<D, ScalarT>(m[D])};
+}
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr affine<D, ScalarT>::operator mat<D + 1, D + 1, ScalarT>() const
+{
+    auto m = mat<D + 1, D + 1, ScalarT>(linear);
+    m[D] = vec<D + 1, ScalarT>(translation, ScalarT(1));
+    return m;
+}
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr mat<D + 1, D + 1, ScalarT> to_mat(affine<D, ScalarT> const& t)
+{
+    return mat<D + 1, D + 1, ScalarT>(t);
+}
+
+// ================================= Operators =================================
+
+/// composition, (a * b) * p == a * (b * p)
+template <int D, class ScalarT>
+[[nodiscard]] constexpr affine<D, ScalarT> operator*(affine<D, ScalarT> const& a, affine<D, ScalarT> const& b)
+{
+    return {a.linear * b.linear, a.linear * b.translation + a.translation};
+}
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr pos<D, ScalarT> operator*(affine<D, ScalarT> const& t, pos<D, ScalarT> const& p)
+{
+    return pos<D, ScalarT>::zero + (t.linear * (p - pos<D, ScalarT>::zero) + t.translation);
+}
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr vec<D, ScalarT> operator*(affine<D, ScalarT> const& t, vec<D, ScalarT> const& v)
+{
+    return t.linear * v;
+}
+
+/// NOTE: returns a vec as scaling and shearing do not preserve the length
+template <int D, class ScalarT>
+[[nodiscard]] constexpr vec<D, ScalarT> operator*(affine<D, ScalarT> const& t, dir<D, ScalarT> const& d)
+{
+    return t.linear * vec<D, ScalarT>(d);
+}
+
+/// tightest aabb containing the transformed box
+template <int D, class ScalarT, class TraitsT>
+[[nodiscard]] constexpr aabb<D, ScalarT, TraitsT> operator*(affine<D, ScalarT> const& t, aabb<D, ScalarT, TraitsT> const& b)
+{
+    // see "Transforming Axis-Aligned Bounding Boxes", Arvo 1990
+    auto const c = b.min + (b.max - b.min) * ScalarT(0.5);
+    auto const e = (b.max - b.min) * ScalarT(0.5);
+    auto const tc = t * c;
+
+    vec<D, ScalarT> te;
+    for (auto r = 0; r < D; ++r)
+        for (auto col = 0; col < D; ++col)
+            te[r] += abs(t.linear[col][r]) * e[col];
+
+    return {tc - te, tc + te};
+}
+
+// ================================= Functions =================================
+
+template <int D, class ScalarT>
+[[nodiscard]] constexpr affine<D, ScalarT> inverse(affine<D, ScalarT> const& t)
+{
+    auto const li = inverse(t.linear);
+    return {li, -(li * t.translation)};
+}
+}
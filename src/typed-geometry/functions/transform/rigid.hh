@@ -0,0 +1,105 @@
+#pragma once
+
+#include <typed-geometry/feature/quat.hh>
+#include <typed-geometry/functions/vector/cross.hh>
+#include <typed-geometry/types/dir.hh>
+#include <typed-geometry/types/mat.hh>
+#include <typed-geometry/types/objects/aabb.hh>
+#include <typed-geometry/types/pos.hh>
+#include <typed-geometry/types/transform.hh>
+#include <typed-geometry/types/vec.hh>
+
+#include "affine.hh"
+
+// Functions for rigid<3, ScalarT>
+//
+// vectors are rotated directly by the (normalized) quaternion instead of converting it to a matrix
+// inverse is conjugate + rotated translation, i.e. no matrix inversion at all
+
+namespace tg
+{
+namespace detail
+{
+/// q * v for normalized q
+template <class ScalarT>
+[[nodiscard]] constexpr vec<3, ScalarT> rigid_rotate(quaternion<ScalarT> const& q, vec<3, ScalarT> const& v)
+{
+    // v + 2 * cross(u, cross(u, v) + w * v) with u = imaginary(q)
+    auto const u = vec<3, ScalarT>(q.x, q.y, q.z);
+    auto const t = cross(u, v) * ScalarT(2);
+    return v + t * q.w + cross(u, t);
+}
+}
+
+// ================================= conversions =================================
+
+template <class ScalarT>
+[[nodiscard]] constexpr rigid<3, ScalarT> rigid<3, ScalarT>::from_mat(mat<4, 4, ScalarT> const& m)
+{
+    return {normalize(quaternion<ScalarT>::from_rotation_matrix(m)), vec<3, ScalarT>(m[3])};
+}
+
+template <class ScalarT>
+[[nodiscard]] constexpr rigid<3, ScalarT>::operator mat<4, 4, ScalarT>() const
+{
+    auto m = mat<4, 4, ScalarT>(rotation);
+    m[3] = vec<4, ScalarT>(translation, ScalarT(1));
+    return m;
+}
+
+template <class ScalarT>
+[[nodiscard]] constexpr rigid<3, ScalarT>::operator affine<3, ScalarT>() const
+{
+    return {mat<3, 3, ScalarT>(rotation), translation};
+}
+
+template <class ScalarT>
+[[nodiscard]] constexpr mat<4, 4, ScalarT> to_mat(rigid<3, ScalarT> const& t)
+{
+    return mat<4, 4, ScalarT>(t);
+}
+
+// ================================= Operators =================================
+
+/// composition, (a * b) * p == a * (b * p)
+template <class ScalarT>
+[[nodiscard]] constexpr rigid<3, ScalarT> operator*(rigid<3, ScalarT> const& a, rigid<3, ScalarT> const& b)
+{
+    return {a.rotation * b.rotation, detail::rigid_rotate(a.rotation, b.translation) + a.translation};
+}
+
+template <class ScalarT>
+[[nodiscard]] constexpr pos<3, ScalarT> operator*(rigid<3, ScalarT> const& t, pos<3, ScalarT> const& p)
+{
+    return pos<3, ScalarT>::zero + (detail::rigid_rotate(t.rotation, p - pos<3, ScalarT>::zero) + t.translation);
+}
+
+template <class ScalarT>
+[[nodiscard]] constexpr vec<3, ScalarT> operator*(rigid<3, ScalarT> const& t, vec<3, ScalarT> const& v)
+{
+    return detail::rigid_rotate(t.rotation, v);
+}
+
+template <class ScalarT>
+[[nodiscard]] constexpr dir<3, ScalarT> operator*(rigid<3, ScalarT> const& t, dir<3, ScalarT> const& d)
+{
+    return dir<3, ScalarT>(detail::rigid_rotate(t.rotation, vec<3, ScalarT>(d)));
+}
+
+/// tightest aabb containing the transformed box
+template <class ScalarT, class TraitsT>
+[[nodiscard]] constexpr aabb<3, ScalarT, TraitsT> operator*(rigid<3, ScalarT> const& t, aabb<3, ScalarT, TraitsT> const& b)
+{
+    return affine<3, ScalarT>(t) * b;
+}
+
+// ================================= Functions =================================
+
+/// NOTE: assumes a normalized rotation
+template <class ScalarT>
+[[nodiscard]] constexpr rigid<3, ScalarT> inverse(rigid<3, ScalarT> const& t)
+{
+    auto const qi = conjugate(t.rotation);
+    return {qi, -detail::rigid_rotate(qi, t.translation)};
+}
+}
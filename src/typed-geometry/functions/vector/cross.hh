@@ -5,11 +5,24 @@
 #include <typed-geometry/types/mat.hh>
 #include <typed-geometry/types/vec.hh>
 
+#ifdef TG_ENABLE_SIMD
+#include <typed-geometry/detail/simd.hh>
+#endif
+
 namespace tg
 {
 template <class ScalarT>
 [[nodiscard]] constexpr vec<3, ScalarT> cross(vec<3, ScalarT> const& a, vec_or_dir<3, ScalarT> const& b)
 {
+#ifdef TG_SIMD_BACKEND
+    if constexpr (std::is_same_v<ScalarT, f32>)
+        if (!TG_IS_CONSTANT_EVALUATED())
+        {
+            vec<3, f32> r;
+            detail::simd_cross3(&a.x, &b.x, &r.x);
+            return r;
+        }
+#endif
     return {
         a.y * b.z - a.z * b.y, //
         a.z * b.x - a.x * b.z, //
@@ -26,6 +39,15 @@ template <class ScalarT>
 template <class ScalarT>
 [[nodiscard]] constexpr vec<3, ScalarT> cross(dir<3, ScalarT> const& a, vec_or_dir<3, ScalarT> const& b)
 {
+#ifdef TG_SIMD_BACKEND
+    if constexpr (std::is_same_v<ScalarT, f32>)
+        if (!TG_IS_CONSTANT_EVALUATED())
+        {
+            vec<3, f32> r;
+            detail::simd_cross3(&a.x, &b.x, &r.x);
+            return r;
+        }
+#endif
     return {
         a.y * b.z - a.z * b.y, //
         a.z * b.x - a.x * b.z, //
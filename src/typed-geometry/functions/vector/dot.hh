@@ -4,6 +4,10 @@
 #include <typed-geometry/types/dir.hh>
 #include <typed-geometry/types/vec.hh>
 
+#ifdef TG_ENABLE_SIMD
+#include <typed-geometry/detail/simd.hh>
+#endif
+
 namespace tg
 {
 template <class ScalarT>
@@ -20,6 +24,11 @@ template <class ScalarT>
 template <class ScalarT>
 [[nodiscard]] constexpr ScalarT dot(vec<3, ScalarT> const& a, vec<3, ScalarT> const& b)
 {
+#ifdef TG_SIMD_BACKEND
+    if constexpr (std::is_same_v<ScalarT, f32>)
+        if (!TG_IS_CONSTANT_EVALUATED())
+            return detail::simd_dot3(&a.x, &b.x);
+#endif
     return a.x * b.x + //
            a.y * b.y + //
            a.z * b.z;
@@ -27,6 +36,11 @@ template <class ScalarT>
 template <class ScalarT>
 [[nodiscard]] constexpr ScalarT dot(vec<4, ScalarT> const& a, vec<4, ScalarT> const& b)
 {
+#ifdef TG_SIMD_BACKEND
+    if constexpr (std::is_same_v<ScalarT, f32>)
+        if (!TG_IS_CONSTANT_EVALUATED())
+            return detail::simd_dot4(&a.x, &b.x);
+#endif
     return a.x * b.x + //
            a.y * b.y + //
            a.z * b.z + //
@@ -4,6 +4,10 @@
 #include <typed-geometry/types/dir.hh>
 #include <typed-geometry/types/vec.hh>
 
+#ifdef TG_ENABLE_SIMD
+#include <typed-geometry/detail/simd.hh>
+#endif
+
 #include "length.hh"
 
 namespace tg
@@ -11,6 +15,18 @@ namespace tg
 template <int D, class ScalarT>
 [[nodiscard]] constexpr dir<D, fractional_result<ScalarT>> normalize(vec<D, ScalarT> const& v)
 {
+#ifdef TG_SIMD_BACKEND
+    if constexpr ((D == 3 || D == 4) && std::is_same_v<ScalarT, f32>)
+        if (!TG_IS_CONSTANT_EVALUATED())
+        {
+            dir<D, f32> r;
+            if constexpr (D == 3)
+                detail::simd_normalize3(&v.x, &r.x);
+            else
+                detail::simd_normalize4(&v.x, &r.x);
+            return r;
+        }
+#endif
     return dir<D, fractional_result<ScalarT>>(v / length(v));
 }
 
@@ -5,4 +5,5 @@
 #include <typed-geometry/feature/objects.hh>
 #include <typed-geometry/feature/quat.hh>
 #include <typed-geometry/feature/random.hh>
+#include <typed-geometry/feature/transform.hh>
 #include <typed-geometry/feature/vector.hh>
@@ -38,6 +38,12 @@ struct quaternion;
 template <int C, int R, class ScalarT>
 struct mat;
 
+// transformation types:
+template <int D, class ScalarT>
+struct affine;
+template <int D, class ScalarT>
+struct rigid;
+
 // object types:
 template <int D, class ScalarT>
 struct line;
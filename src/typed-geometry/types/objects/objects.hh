@@ -19,6 +19,7 @@
 #include "pyramid.hh"
 #include "quad.hh"
 #include "ray.hh"
+#include "ray_packet.hh"
 #include "segment.hh"
 #include "sphere.hh"
 #include "tetrahedron.hh"
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+
+#include <clean-core/vector.hh>
+
+#include <typed-geometry/feature/assert.hh>
+#include <typed-geometry/types/scalars/default.hh>
+#include "../pos.hh"
+#include "../span.hh"
+#include "../vec.hh"
+
+// A polygon is a closed ring of vertices (the edge from the last to the first vertex is implicit)
+//
+// Notes:
+//   - vertices are stored contiguously, in either winding, without a repeated closing vertex
+//   - build_slab_index() prepares repeated contains(polygon, p) queries in O(log n),
+//     the index requires a simple (non self-intersecting) polygon and must be rebuilt after changing vertices
+//   - an edge is stored once per slab it crosses, which is quadratic for combs and zig-zags,
+//     such polygons get no index (see build_slab_index) and contains falls back to the O(n) test
+namespace tg
+{
+template <int D, class ScalarT>
+struct polygon;
+
+// Common polygon types
+
+using polygon2 = polygon<2, f32>;
+
+using fpolygon2 = polygon<2, f32>;
+
+using dpolygon2 = polygon<2, f64>;
+
+
+// ======== IMPLEMENTATION ========
+
+namespace detail
+{
+/// non-horizontal polygon edge, oriented upwards (y0 is the lower endpoint)
+template <class ScalarT>
+struct polygon_edge
+{
+    ScalarT x0;
+    ScalarT y0;
+    ScalarT dxdy;
+
+    [[nodiscard]] constexpr ScalarT x_at(ScalarT y) const { return x0 + (y - y0) * dxdy; }
+};
+
+template <class ScalarT>
+[[nodiscard]] constexpr polygon_edge<ScalarT> polygon_edge_of(pos<2, ScalarT> a, pos<2, ScalarT> b)
+{
+    if (b.y < a.y)
+    {
+        auto const t = a;
+        a = b;
+        b = t;
+    }
+    return {a.x, a.y, (b.x - a.x) / (b.y - a.y)};
+}
+}
+
+template <int D, class ScalarT>
+struct polygon
+{
+    static_assert(D == 2, "only 2D polygons are supported");
+
+    using scalar_t = ScalarT;
+    using vec_t = vec<D, ScalarT>;
+    using pos_t = pos<D, ScalarT>;
+
+    cc::vector<pos_t> vertices;
+
+    // slab index, slab i is [slab_y[i], slab_y[i + 1]) and is crossed by
+    // slab_edges[slab_offsets[i], slab_offsets[i + 1]) sorted by x
+    cc::vector<ScalarT> slab_y;
+    cc::vector<u32> slab_offsets;
+    cc::vector<detail::polygon_edge<ScalarT>> slab_edges;
+
+    polygon() = default;
+    explicit polygon(span<pos_t const> v)
+    {
+        vertices.reserve(v.size());
+        for (auto const& p : v)
+            vertices.push_back(p);
+    }
+    explicit polygon(cc::vector<pos_t> v) : vertices(std::move(v)) {}
+
+    [[nodiscard]] size_t size() const { return vertices.size(); }
+    [[nodiscard]] bool empty() const { return vertices.empty(); }
+
+    [[nodiscard]] pos_t& operator[](size_t i) { return vertices[i]; }
+    [[nodiscard]] pos_t const& operator[](size_t i) const { return vertices[i]; }
+
+    [[nodiscard]] bool has_slab_index() const { return !slab_offsets.empty(); }
+
+    void clear_slab_index()
+    {
+        slab_y.clear();
+        slab_offsets.clear();
+        slab_edges.clear();
+    }
+
+    /// builds the y-sorted slab index in O(n log n + m log m) time and O(n + m) memory,
+    /// m is the number of (edge, slab) crossings (about 2 per slab for convex polygons, up to n^2 / 4 for combs)
+    /// if m would exceed max_crossings_per_vertex * n (or 2^32 - 1), no index is built (has_slab_index() is false)
+    void build_slab_index(size_t max_crossings_per_vertex = 32)
+    {
+        clear_slab_index();
+
+        auto const n = vertices.size();
+        for (auto const& p : vertices)
+            slab_y.push_back(p.y);
+        std::sort(slab_y.begin(), slab_y.end());
+        slab_y.resize(size_t(std::unique(slab_y.begin(), slab_y.end()) - slab_y.begin()));
+
+        auto const slab_count = slab_y.empty() ? size_t(0) : slab_y.size() - 1;
+        auto const slab_of = [&](ScalarT y) { return size_t(std::lower_bound(slab_y.begin(), slab_y.end(), y) - slab_y.begin()); };
+
+        // an edge crosses the slabs [lo, hi) between its endpoints, count them with a difference array
+        // (unsigned wrap-around of the decrements cancels in the running sum)
+        slab_offsets.resize(slab_count + 1);
+        for (auto& o : slab_offsets)
+            o = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            auto const a = vertices[i].y;
+            auto const b = vertices[i + 1 == n ? 0 : i + 1].y;
+            if (a == b)
+                continue;
+            ++slab_offsets[slab_of(a < b ? a : b)];
+            --slab_offsets[slab_of(a < b ? b : a)];
+        }
+
+        // running count per slab, then exclusive prefix sum, bailing out before anything quadratic is allocated
+        // offsets are u32, so the limit never exceeds what they can address (the check also avoids overflowing the product)
+        auto const max_u32 = u64(u32(-1));
+        auto const max_crossings = n == 0 || u64(max_crossings_per_vertex) >= max_u32 / n ? max_u32 : u64(max_crossings_per_vertex) * n;
+        auto crossing = u32(0);
+        auto total = u64(0);
+        for (size_t s = 0; s < slab_count; ++s)
+        {
+            crossing += slab_offsets[s];
+            slab_offsets[s] = u32(total);
+            total += crossing;
+            if (total > max_crossings)
+            {
+                clear_slab_index();
+                return;
+            }
+        }
+        TG_ASSERT(total <= max_u32 && "slab offsets overflow");
+        slab_offsets[slab_count] = u32(total);
+
+        slab_edges.resize(slab_offsets[slab_count]);
+        cc::vector<u32> cursor;
+        cursor.resize(slab_count);
+        for (size_t s = 0; s < slab_count; ++s)
+            cursor[s] = slab_offsets[s];
+        for (size_t i = 0; i < n; ++i)
+        {
+            auto const pa = vertices[i];
+            auto const pb = vertices[i + 1 == n ? 0 : i + 1];
+            if (pa.y == pb.y)
+                continue;
+            auto const e = detail::polygon_edge_of(pa, pb);
+            auto const lo = slab_of(pa.y < pb.y ? pa.y : pb.y);
+            auto const hi = slab_of(pa.y < pb.y ? pb.y : pa.y);
+            for (auto s = lo; s < hi; ++s)
+                slab_edges[cursor[s]++] = e;
+        }
+
+        // edges of a simple polygon do not cross inside a slab, so their order at the slab center holds for the whole slab
+        for (size_t s = 0; s < slab_count; ++s)
+        {
+            auto const y = (slab_y[s] + slab_y[s + 1]) / 2;
+            std::sort(slab_edges.begin() + slab_offsets[s], slab_edges.begin() + slab_offsets[s + 1],
+                      [y](detail::polygon_edge<ScalarT> const& l, detail::polygon_edge<ScalarT> const& r) { return l.x_at(y) < r.x_at(y); });
+        }
+    }
+};
+} // namespace tg
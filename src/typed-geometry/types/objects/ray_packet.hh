@@ -0,0 +1,111 @@
+#pragma once
+
+#include <typed-geometry/feature/assert.hh>
+
+#include <typed-geometry/types/scalars/default.hh>
+#include <typed-geometry/types/span.hh>
+#include "ray.hh"
+
+namespace tg
+{
+template <int D, class ScalarT, int W>
+struct ray_packet;
+
+// Common ray packet types
+
+using ray3_packet4 = ray_packet<3, f32, 4>;
+using ray3_packet8 = ray_packet<3, f32, 8>;
+using ray3_packet16 = ray_packet<3, f32, 16>;
+
+using fray3_packet4 = ray_packet<3, f32, 4>;
+using fray3_packet8 = ray_packet<3, f32, 8>;
+using fray3_packet16 = ray_packet<3, f32, 16>;
+
+using dray3_packet4 = ray_packet<3, f64, 4>;
+using dray3_packet8 = ray_packet<3, f64, 8>;
+using dray3_packet16 = ray_packet<3, f64, 16>;
+
+
+// ======== IMPLEMENTATION ========
+
+/// a fixed number of W rays stored as structure-of-arrays
+/// origin[d][lane] and dir[d][lane] are the d-th coordinates of the given lane
+/// the lane count W is limited to 32 so that per-lane results fit into a u32 bitmask
+/// NOTE: directions must be normalized (same as tg::ray)
+template <int D, class ScalarT, int W>
+struct ray_packet
+{
+    static_assert(1 <= W && W <= 32, "ray packets support 1 to 32 lanes");
+
+    using scalar_t = ScalarT;
+    using ray_t = ray<D, ScalarT>;
+    using pos_t = pos<D, ScalarT>;
+    using dir_t = tg::dir<D, ScalarT>;
+
+    static constexpr int width = W;
+
+    alignas(sizeof(ScalarT) * (W >= 4 ? 4 : W)) ScalarT origin[D][W] = {};
+    alignas(sizeof(ScalarT) * (W >= 4 ? 4 : W)) ScalarT dir[D][W] = {};
+
+    constexpr ray_packet() = default;
+
+    /// creates a packet where every lane contains the same ray
+    explicit constexpr ray_packet(ray_t const& r)
+    {
+        for (auto l = 0; l < W; ++l)
+            set_lane(l, r);
+    }
+
+    /// creates a packet from up to W rays
+    /// unused lanes replicate the first ray so that all lanes stay well-defined
+    explicit constexpr ray_packet(span<ray_t const> rays)
+    {
+        TG_CONTRACT(0 < rays.size() && rays.size() <= size_t(W));
+        for (auto l = 0; l < W; ++l)
+            set_lane(l, rays[size_t(l) < rays.size() ? size_t(l) : 0]);
+    }
+
+    [[nodiscard]] constexpr ray_t lane(int l) const
+    {
+        TG_CONTRACT(0 <= l && l < W);
+        pos_t o;
+        dir_t d;
+        for (auto i = 0; i < D; ++i)
+        {
+            o[i] = origin[i][l];
+            d[i] = dir[i][l];
+        }
+        return {o, d};
+    }
+
+    constexpr void set_lane(int l, ray_t const& r)
+    {
+        TG_CONTRACT(0 <= l && l < W);
+        for (auto i = 0; i < D; ++i)
+        {
+            origin[i][l] = r.origin[i];
+            dir[i][l] = r.dir[i];
+        }
+    }
+
+    /// returns the position of lane l at ray parameter t
+    [[nodiscard]] constexpr pos_t at(int l, ScalarT t) const
+    {
+        TG_CONTRACT(0 <= l && l < W);
+        pos_t p;
+        for (auto i = 0; i < D; ++i)
+            p[i] = origin[i][l] + dir[i][l] * t;
+        return p;
+    }
+
+    /// bitmask with one bit set for each of the W lanes
+    static constexpr u32 all_lanes = W == 32 ? ~u32(0) : (u32(1) << W) - 1;
+};
+
+template <class I, int D, class ScalarT, int W>
+constexpr void introspect(I&& i, ray_packet<D, ScalarT, W>& v)
+{
+    i(v.origin, "origin");
+    i(v.dir, "dir");
+}
+} // namespace tg
@@ -1,3 +1,127 @@
 #pragma once
 
-// TODO: explicit types for transformation hierarchy
+#include <typed-geometry/types/scalars/default.hh>
+#include "../detail/macros.hh"
+#include "../detail/scalar_traits.hh"
+#include "../detail/special_values.hh"
+#include "../detail/utility.hh"
+#include "fwd.hh"
+#include "mat.hh"
+#include "quat.hh"
+#include "vec.hh"
+
+/**
+ * Explicit transformation types as cheaper alternatives to homogeneous mat<D+1, D+1>
+ *
+ * affine<D, ScalarT>: linear part (mat<D, D>) + translation, i.e. the top D rows of a homogeneous matrix
+ *   affine * pos = linear * pos + translation
+ *   (e.g. affine3 is 3x4 storage and never needs a perspective divide)
+ *
+ * rigid<3, ScalarT>: rotation (normalized quaternion) + translation
+ *   rigid * pos = rotation * pos + translation
+ *
+ * composition follows matrix conventions: (a * b) * p == a * (b * p)
+ *
+ * functions (compose, inverse, application to pos/vec/dir/aabb, conversions) need
+ *   functions/transform/affine.hh and functions/transform/rigid.hh
+ *   or feature/transform.hh
+ *   or tg.hh
+ */
+
+namespace tg
+{
+template <int D, class ScalarT>
+struct affine;
+
+template <int D, class ScalarT>
+struct rigid;
+
+// Common transformation types
+
+using affine2 = affine<2, f32>;
+using affine3 = affine<3, f32>;
+
+using faffine2 = affine<2, f32>;
+using faffine3 = affine<3, f32>;
+
+using daffine2 = affine<2, f64>;
+using daffine3 = affine<3, f64>;
+
+using rigid3 = rigid<3, f32>;
+using frigid3 = rigid<3, f32>;
+using drigid3 = rigid<3, f64>;
+
+// ======== IMPLEMENTATION ========
+
+template <int D, class ScalarT>
+struct affine
+{
+    using scalar_t = ScalarT;
+
+    mat<D, D, ScalarT> linear = mat<D, D, ScalarT>::diag(ScalarT(1));
+    vec<D, ScalarT> translation;
+
+    static const affine identity;
+
+    constexpr affine() = default;
+    constexpr affine(mat<D, D, ScalarT> const& linear, vec<D, ScalarT> const& translation) : linear(linear), translation(translation) {}
+
+    /// takes the top D rows of a homogeneous matrix (the last row is assumed to be (0, ..., 0, 1))
+    /// needs functions/transform/affine.hh
+    ///    or feature/transform.hh
+    ///    or tg.hh
+    [[nodiscard]] static constexpr affine from_mat(mat<D + 1, D + 1, ScalarT> const& m);
+
+    [[nodiscard]] constexpr explicit operator mat<D + 1, D + 1, ScalarT>() const;
+
+    [[nodiscard]] constexpr bool operator==(affine const& rhs) const { return linear == rhs.linear && translation == rhs.translation; }
+    [[nodiscard]] constexpr bool operator!=(affine const& rhs) const { return !operator==(rhs); }
+};
+
+template <int D, class ScalarT>
+const affine<D, ScalarT> affine<D, ScalarT>::identity = {};
+
+template <class ScalarT>
+struct rigid<3, ScalarT>
+{
+    using scalar_t = ScalarT;
+
+    /// NOTE: must be normalized
+    quaternion<ScalarT> rotation = {ScalarT(0), ScalarT(0), ScalarT(0), ScalarT(1)};
+    vec<3, ScalarT> translation;
+
+    static const rigid identity;
+
+    constexpr rigid() = default;
+    constexpr rigid(quaternion<ScalarT> const& rotation, vec<3, ScalarT> const& translation) : rotation(rotation), translation(translation) {}
+
+    /// assumes m is a rotation + translation (no scaling, shearing or projection)
+    /// needs functions/transform/rigid.hh
+    ///    or feature/transform.hh
+    ///    or tg.hh
+    [[nodiscard]] static constexpr rigid from_mat(mat<4, 4, ScalarT> const& m);
+
+    [[nodiscard]] constexpr explicit operator mat<4, 4, ScalarT>() const;
+    [[nodiscard]] constexpr explicit operator affine<3, ScalarT>() const;
+
+    [[nodiscard]] constexpr bool operator==(rigid const& rhs) const { return rotation == rhs.rotation && translation == rhs.translation; }
+    [[nodiscard]] constexpr bool operator!=(rigid const& rhs) const { return !operator==(rhs); }
+};
+
+template <class ScalarT>
+const rigid<3, ScalarT> rigid<3, ScalarT>::identity = {};
+
+// reflection
+template <class I, int D, class ScalarT>
+constexpr void introspect(I&& i, affine<D, ScalarT>& v)
+{
+    i(v.linear, "linear");
+    i(v.translation, "translation");
+}
+template <class I, int D, class ScalarT>
+constexpr void introspect(I&& i, rigid<D, ScalarT>& v)
+{
+    i(v.rotation, "rotation");
+    i(v.translation, "translation");
+}
+}
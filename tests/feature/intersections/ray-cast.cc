@@ -0,0 +1,193 @@
+#include <nexus/fuzz_test.hh>
+#include <nexus/ext/tg-approx.hh>
+
+#include <typed-geometry/feature/intersections.hh>
+#include <typed-geometry/feature/objects.hh>
+
+FUZZ_TEST("RayCast - Consistency")(tg::rng& rng)
+{
+    auto const range = tg::aabb3(-5, 5);
+    auto const ray = tg::ray3(uniform(rng, range), tg::uniform<tg::dir3>(rng));
+
+    // t and position agree with closest_intersection_parameter on the boundary
+    auto const check_obj = [&](auto const& obj, auto const& surface) {
+        auto const hit = tg::ray_cast(ray, obj);
+        auto const t = tg::closest_intersection_parameter(ray, surface);
+        CHECK(hit.has_value() == t.has_value());
+        if (!hit.has_value() || !t.has_value())
+            return hit;
+
+        CHECK(hit.value().t == nx::approx(t.value()).abs(1e-3f));
+        CHECK(hit.value().position == nx::approx(ray[hit.value().t]).abs(1e-3f));
+        CHECK(length(tg::vec3(hit.value().normal)) == nx::approx(1.0f));
+        return hit;
+    };
+
+    auto const p0 = uniform(rng, range);
+    auto const p1 = uniform(rng, range);
+    auto const p2 = uniform(rng, range);
+
+    // triangle
+    {
+        auto const tri = tg::triangle3(p0, p1, p2);
+        auto const hit = check_obj(tri, tri);
+        if (hit.has_value())
+        {
+            auto const& h = hit.value();
+            REQUIRE(h.barycentrics.has_value());
+            auto const b = h.barycentrics.value();
+            CHECK(b.comp0 + b.comp1 + b.comp2 == nx::approx(1.0f));
+            CHECK(tri[b] == nx::approx(h.position).abs(1e-3f));
+            CHECK(tg::abs(dot(h.normal, normal_of(tri))) == nx::approx(1.0f));
+        }
+    }
+
+    // plane
+    {
+        auto const pl = tg::plane3(tg::uniform<tg::dir3>(rng), p0);
+        auto const hit = check_obj(pl, pl);
+        if (hit.has_value())
+            CHECK(hit.value().normal == pl.normal);
+    }
+
+    // convex solids: normal points outwards
+    auto const check_convex = [&](auto const& obj, tg::pos3 center) {
+        auto const hit = check_obj(obj, boundary_of(obj));
+        if (hit.has_value())
+            CHECK(dot(hit.value().normal, hit.value().position - center) > -1e-3f);
+        CHECK(!tg::ray_cast(ray, obj).has_value() || !tg::ray_cast(ray, obj).value().barycentrics.has_value());
+    };
+
+    auto const bb = aabb_of(p0, p1);
+    check_convex(bb, centroid_of(bb));
+    check_convex(tg::sphere3(p0, uniform(rng, 0.5f, 3.0f)), p0);
+    check_convex(tg::capsule3(p0, p1, uniform(rng, 0.5f, 3.0f)), centroid_of(tg::segment3(p0, p1)));
+    check_convex(tg::cylinder3(p0, p1, uniform(rng, 0.5f, 3.0f)), centroid_of(tg::segment3(p0, p1)));
+
+    auto const d0 = tg::uniform<tg::dir3>(rng);
+    auto const d1 = any_normal(d0);
+    auto const d2 = normalize(cross(d0, d1));
+    auto m = tg::mat3();
+    m[0] = d0 * uniform(rng, 1.0f, 3.0f);
+    m[1] = d1 * uniform(rng, 1.0f, 3.0f);
+    m[2] = d2 * uniform(rng, 1.0f, 3.0f);
+    check_convex(tg::box3(p0, m), p0);
+    check_convex(tg::ellipse3(p0, m), p0);
+
+    // cones and pyramids have their apex on the normal side of the base
+    auto const h = uniform(rng, 0.5f, 3.0f);
+    check_convex(tg::cone3(tg::sphere2in3(p0, uniform(rng, 0.5f, 3.0f), d0), h), p0 + d0 * (h / 4));
+    auto const base = tg::triangle3(p0, p1, p2);
+    check_convex(tg::pyramid<tg::triangle3>(base, h), centroid_of(base) + normal_of(base) * (h / 4));
+}
+
+FUZZ_TEST("RayCast - 2D")(tg::rng& rng)
+{
+    auto const range = tg::aabb2(-5, 5);
+    auto const ray = tg::ray2(uniform(rng, range), tg::uniform<tg::dir2>(rng));
+
+    auto const check_obj = [&](auto const& obj, auto const& surface) {
+        auto const hit = tg::ray_cast(ray, obj);
+        auto const t = tg::closest_intersection_parameter(ray, surface);
+        CHECK(hit.has_value() == t.has_value());
+        if (!hit.has_value() || !t.has_value())
+            return hit;
+
+        CHECK(hit.value().t == nx::approx(t.value()).abs(1e-3f));
+        CHECK(length(tg::vec2(hit.value().normal)) == nx::approx(1.0f));
+        return hit;
+    };
+
+    auto const p0 = uniform(rng, range);
+    auto const p1 = uniform(rng, range);
+    auto const p2 = uniform(rng, range);
+    auto const d = tg::uniform<tg::dir2>(rng);
+
+    // lines, rays and segments: normal is perpendicular
+    if (auto const hit = check_obj(tg::line2(p0, d), tg::line2(p0, d)); hit.has_value())
+        CHECK(tg::abs(dot(hit.value().normal, d)) < 1e-3f);
+    if (auto const hit = check_obj(tg::ray2(p0, d), tg::ray2(p0, d)); hit.has_value())
+        CHECK(tg::abs(dot(hit.value().normal, d)) < 1e-3f);
+    if (auto const hit = check_obj(tg::segment2(p0, p1), tg::segment2(p0, p1)); hit.has_value())
+        CHECK(tg::abs(dot(hit.value().normal, p1 - p0)) < 1e-3f * (1 + length(p1 - p0)));
+
+    // solids: normal points outwards, rays starting inside report the exit
+    auto const tri = tg::triangle2(p0, p1, p2);
+    if (auto const hit = tg::ray_cast(ray, tri); hit.has_value())
+    {
+        CHECK(hit.value().t >= 0);
+        CHECK(distance(hit.value().position, tri) < 1e-3f);
+        CHECK(dot(hit.value().normal, hit.value().position - centroid_of(tri)) > -1e-3f);
+    }
+
+    auto const cyl = tg::inf_cylinder2(tg::line2(p0, d), uniform(rng, 0.5f, 3.0f));
+    if (auto const hit = check_obj(cyl, boundary_of(cyl)); hit.has_value())
+        CHECK(dot(hit.value().normal, hit.value().position - project(hit.value().position, cyl.axis)) > -1e-3f);
+
+    auto const cone = tg::inf_cone2(p0, d, tg::degree(uniform(rng, 10.f, 170.f)));
+    if (auto const hit = check_obj(cone, boundary_of(cone)); hit.has_value())
+    {
+        CHECK(dot(hit.value().normal, d) < 1e-3f);
+        CHECK(tg::abs(dot(hit.value().normal, hit.value().position - p0)) < 1e-2f);
+    }
+}
+
+TEST("RayCast - Known hits")
+{
+    auto const r = tg::ray3(tg::pos3(0, 0, -5), tg::dir3::pos_z);
+
+    auto const s = tg::ray_cast(r, tg::sphere3(tg::pos3::zero, 1.0f));
+    REQUIRE(s.has_value());
+    CHECK(s.value().t == nx::approx(4.0f));
+    CHECK(s.value().normal == tg::dir3::neg_z);
+
+    // starting inside reports the exit
+    auto const inside = tg::ray_cast(tg::ray3(tg::pos3::zero, tg::dir3::pos_x), tg::aabb3(-1, 2));
+    REQUIRE(inside.has_value());
+    CHECK(inside.value().t == nx::approx(2.0f));
+    CHECK(inside.value().normal == tg::dir3::pos_x);
+
+    auto const b = tg::ray_cast(r, tg::aabb3(-1, 1));
+    REQUIRE(b.has_value());
+    CHECK(b.value().t == nx::approx(4.0f));
+    CHECK(b.value().normal == tg::dir3::neg_z);
+
+    auto const tri = tg::triangle3({-1, -1, 0}, {2, -1, 0}, {-1, 2, 0});
+    auto const t = tg::ray_cast(r, tri);
+    REQUIRE(t.has_value());
+    CHECK(t.value().t == nx::approx(5.0f));
+    CHECK(t.value().normal == tg::dir3::pos_z);
+    CHECK(t.value().barycentrics.value() == nx::approx(tg::comp3(1 / 3.f, 1 / 3.f, 1 / 3.f)));
+
+    CHECK(!tg::ray_cast(r, tg::plane3(tg::dir3::pos_x, tg::pos3::zero)).has_value());
+
+    // unit sphere as quadric
+    auto const q = tg::ray_cast(r, tg::quadric3::from_coefficients(tg::mat3::identity, tg::vec3::zero, -1.0f));
+    REQUIRE(q.has_value());
+    CHECK(q.value().t == nx::approx(4.0f));
+    CHECK(q.value().normal == tg::dir3::neg_z);
+
+    // 45 degree cone with apex (0, 1, 0), hit on the mantle
+    auto const cone = tg::cone3(tg::sphere2in3(tg::pos3::zero, 1.0f, tg::dir3::pos_y), 1.0f);
+    auto const c = tg::ray_cast(tg::ray3(tg::pos3(0, 0.5f, -5), tg::dir3::pos_z), cone);
+    REQUIRE(c.has_value());
+    CHECK(c.value().t == nx::approx(4.5f));
+    CHECK(tg::vec3(c.value().normal) == nx::approx(tg::vec3(0, 0.70710678f, -0.70710678f)));
+
+    // and on its base
+    auto const cb = tg::ray_cast(tg::ray3(tg::pos3(0.25f, -5, 0), tg::dir3::pos_y), cone);
+    REQUIRE(cb.has_value());
+    CHECK(cb.value().t == nx::approx(5.0f));
+    CHECK(cb.value().normal == tg::dir3::neg_y);
+
+    // solid triangle2, from outside and from inside
+    auto const tri = tg::triangle2({-1, -1}, {2, -1}, {-1, 2});
+    auto const t0 = tg::ray_cast(tg::ray2(tg::pos2(0, -5), tg::dir2::pos_y), tri);
+    REQUIRE(t0.has_value());
+    CHECK(t0.value().t == nx::approx(4.0f));
+    CHECK(t0.value().normal == tg::dir2::neg_y);
+    auto const t1 = tg::ray_cast(tg::ray2(tg::pos2(0, 0), tg::dir2::pos_y), tri);
+    REQUIRE(t1.has_value());
+    CHECK(t1.value().t == nx::approx(1.0f));
+    CHECK(tg::vec2(t1.value().normal) == nx::approx(tg::vec2(0.70710678f, 0.70710678f)));
+}
@@ -0,0 +1,95 @@
+#include <nexus/fuzz_test.hh>
+#include <nexus/ext/tg-approx.hh>
+
+#include <typed-geometry/feature/intersections.hh>
+#include <typed-geometry/feature/objects.hh>
+
+FUZZ_TEST("RayPacket - Intersections")(tg::rng& rng)
+{
+    auto const range = tg::aabb3(-5, 5);
+
+    tg::ray3 rays[8];
+    for (auto& r : rays)
+        r = tg::ray3(uniform(rng, range), tg::uniform<tg::dir3>(rng));
+    auto const packet = tg::ray3_packet8(rays);
+
+    for (auto l = 0; l < 8; ++l)
+        CHECK(packet.lane(l) == rays[l]);
+
+    auto const test_obj = [&](auto const& obj)
+    {
+        auto const ps = tg::intersection_parameter(packet, obj);
+        auto const mask = tg::intersects(packet, obj);
+        CHECK(mask == ps.mask);
+        for (auto l = 0; l < 8; ++l)
+        {
+            auto const ts = tg::intersection_parameter(rays[l], obj);
+            auto const lane = ps[l];
+            CHECK(lane.size() == ts.size());
+            if (lane.size() != ts.size())
+                continue;
+            for (auto i = 0; i < ts.size(); ++i)
+                CHECK(lane[i] == nx::approx(ts[i]).abs(1e-3f));
+        }
+    };
+
+    auto const test_solid_obj = [&](auto const& obj)
+    {
+        auto const ps = tg::intersection_parameter(packet, obj);
+        auto const cs = tg::closest_intersection_parameter(packet, obj);
+        CHECK(cs.mask == ps.mask);
+        for (auto l = 0; l < 8; ++l)
+        {
+            auto const ts = tg::intersection_parameter(rays[l], obj);
+            auto const lane = ps[l];
+            CHECK(lane.has_value() == ts.has_value());
+            if (lane.has_value() && ts.has_value())
+            {
+                CHECK(lane.value().start == nx::approx(ts.value().start).abs(1e-3f));
+                CHECK(lane.value().end == nx::approx(ts.value().end).abs(1e-3f));
+                CHECK(cs.t[0][l] == lane.value().start);
+            }
+        }
+    };
+
+    auto const p0 = uniform(rng, range);
+    auto const p1 = uniform(rng, range);
+    auto const p2 = uniform(rng, range);
+
+    // aabb
+    test_solid_obj(aabb_of(p0, p1));
+
+    // box
+    auto const d0 = tg::uniform<tg::dir3>(rng);
+    auto const d1 = any_normal(d0);
+    auto const d2 = normalize(cross(d0, d1));
+    auto m = tg::mat3();
+    m[0] = d0 * uniform(rng, 1.0f, 3.0f);
+    m[1] = d1 * uniform(rng, 1.0f, 3.0f);
+    m[2] = d2 * uniform(rng, 1.0f, 3.0f);
+    test_solid_obj(tg::box3(p0, m));
+
+    // plane, sphere and triangle
+    test_obj(tg::plane3(tg::uniform<tg::dir3>(rng), p0));
+    test_obj(tg::sphere_boundary<3, float>(p0, uniform(rng, 0.5f, 5.0f)));
+    test_obj(tg::triangle3(p0, p1, p2));
+}
+
+TEST("RayPacket - Replicated lanes")
+{
+    auto const r = tg::ray3(tg::pos3(0, 0, -5), tg::dir3(0, 0, 1));
+    auto const packet = tg::ray3_packet4(r);
+    auto const s = tg::sphere_boundary<3, float>(tg::pos3(0, 0, 0), 1.0f);
+
+    auto const hits = tg::intersection_parameter(packet, s);
+    CHECK(hits.mask == tg::ray3_packet4::all_lanes);
+    for (auto l = 0; l < 4; ++l)
+    {
+        CHECK(hits.count[l] == 2);
+        CHECK(hits.t[0][l] == nx::approx(4.0f));
+        CHECK(hits.t[1][l] == nx::approx(6.0f));
+    }
+
+    auto const miss = tg::aabb3(tg::pos3(2, 2, 2), tg::pos3(3, 3, 3));
+    CHECK(tg::intersects(packet, miss) == 0u);
+}
@@ -0,0 +1,58 @@
+#include <nexus/ext/tg-approx.hh>
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/matrix.hh>
+#include <typed-geometry/feature/vector.hh>
+
+// with TG_ENABLE_SIMD these go through the SSE4.1 kernels at runtime
+// the f64 versions serve as reference
+
+// the CMake option must actually activate the kernels
+#if defined(TG_ENABLE_SIMD) && !defined(TG_SIMD_BACKEND)
+#error "TG_ENABLE_SIMD is set but TG_SIMD_BACKEND is not defined"
+#endif
+
+// constant evaluation still works
+static_assert(dot(tg::vec3(1, 2, 3), tg::vec3(4, 5, 6)) == 32);
+static_assert(dot(tg::vec4(1, 2, 3, 4), tg::vec4(4, 5, 6, 7)) == 60);
+static_assert(cross(tg::vec3(1, 0, 0), tg::vec3(0, 1, 0)) == tg::vec3(0, 0, 1));
+
+FUZZ_TEST("SimdBackend - Matches f64")(tg::rng& rng)
+{
+    auto const r = tg::aabb4(-10, 10);
+
+    tg::mat4 a, b;
+    for (auto i = 0; i < 4; ++i)
+    {
+        a[i] = tg::vec4(uniform(rng, r));
+        b[i] = tg::vec4(uniform(rng, r));
+    }
+    auto const v4 = tg::vec4(uniform(rng, r));
+    auto const w4 = tg::vec4(uniform(rng, r));
+    auto const v3 = tg::vec3(v4);
+    auto const w3 = tg::vec3(w4);
+    auto const p3 = tg::pos3(v3);
+
+    auto const da = tg::dmat4(a);
+    auto const db = tg::dmat4(b);
+
+    CHECK(a * v4 == nx::approx(tg::vec4(da * tg::dvec4(v4))).abs(1e-3f));
+    CHECK(a * b == nx::approx(tg::mat4(da * db)).abs(1e-2f));
+
+    auto affine = a;
+    affine[0][3] = affine[1][3] = affine[2][3] = 0;
+    affine[3][3] = 1;
+    CHECK(affine * p3 == nx::approx(tg::pos3(tg::dmat4(affine) * tg::dpos3(p3))).abs(1e-2f));
+
+    CHECK(dot(v3, w3) == nx::approx(float(dot(tg::dvec3(v3), tg::dvec3(w3)))).abs(1e-3f));
+    CHECK(dot(v4, w4) == nx::approx(float(dot(tg::dvec4(v4), tg::dvec4(w4)))).abs(1e-3f));
+    CHECK(cross(v3, w3) == nx::approx(tg::vec3(cross(tg::dvec3(v3), tg::dvec3(w3)))).abs(1e-3f));
+    CHECK(cross(normalize(v3), w3) == nx::approx(tg::vec3(cross(normalize(tg::dvec3(v3)), tg::dvec3(w3)))).abs(1e-3f));
+
+    CHECK(tg::vec3(normalize(v3)) == nx::approx(tg::vec3(normalize(tg::dvec3(v3)))).abs(1e-5f));
+    CHECK(tg::vec4(normalize(v4)) == nx::approx(tg::vec4(normalize(tg::dvec4(v4)))).abs(1e-5f));
+
+    // mat * vec accumulates in the same order as the scalar path
+    auto const row_dot = tg::vec4(dot(a.row(0), v4), dot(a.row(1), v4), dot(a.row(2), v4), dot(a.row(3), v4));
+    CHECK(a * v4 == nx::approx(row_dot).abs(1e-4f));
+}
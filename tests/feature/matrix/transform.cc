@@ -0,0 +1,99 @@
+#include <nexus/ext/tg-approx.hh>
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/matrix.hh>
+#include <typed-geometry/feature/random.hh>
+#include <typed-geometry/feature/vector.hh>
+
+#include <vector>
+
+namespace
+{
+template <class ScalarT>
+tg::mat<4, 4, ScalarT> random_affine(tg::rng& rng)
+{
+    using vec3_t = tg::vec<3, ScalarT>;
+    auto const r = tg::aabb<3, ScalarT>(ScalarT(-5), ScalarT(5));
+    auto m = tg::mat<4, 4, ScalarT>::identity;
+    for (auto i = 0; i < 3; ++i)
+        m[i] = tg::vec<4, ScalarT>(vec3_t(uniform(rng, r)), ScalarT(0));
+    m[3] = tg::vec<4, ScalarT>(vec3_t(uniform(rng, r)), ScalarT(1));
+    return m;
+}
+
+template <class ScalarT>
+void check_transforms(tg::rng& rng)
+{
+    using pos3_t = tg::pos<3, ScalarT>;
+    using vec3_t = tg::vec<3, ScalarT>;
+    using dir3_t = tg::dir<3, ScalarT>;
+
+    auto const r = tg::aabb<3, ScalarT>(ScalarT(-10), ScalarT(10));
+    auto const n = size_t(uniform(rng, 0, 100));
+
+    std::vector<pos3_t> pts;
+    std::vector<vec3_t> dirs;
+    std::vector<dir3_t> normals;
+    for (size_t i = 0; i < n; ++i)
+    {
+        pts.push_back(uniform(rng, r));
+        dirs.push_back(vec3_t(uniform(rng, r)));
+        normals.push_back(tg::uniform<dir3_t>(rng));
+    }
+
+    auto const m = random_affine<ScalarT>(rng);
+    REQUIRE(is_affine(m));
+
+    std::vector<pos3_t> out_pts(n);
+    std::vector<vec3_t> out_dirs(n);
+    std::vector<dir3_t> out_normals(n);
+    tg::transform_points(m, pts, out_pts);
+    tg::transform_directions(m, dirs, out_dirs);
+    tg::transform_normals(m, normals, out_normals);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        CHECK(out_pts[i] == nx::approx(m * pts[i]).abs(1e-3f));
+        CHECK(out_dirs[i] == nx::approx(tg::vec<3, ScalarT>(m * tg::vec<4, ScalarT>(dirs[i], ScalarT(0)))).abs(1e-3f));
+
+        // transformed normals stay orthogonal to transformed tangents
+        auto const t = any_normal(normals[i]);
+        auto const tt = tg::vec<3, ScalarT>(m * tg::vec<4, ScalarT>(t, ScalarT(0)));
+        CHECK(tg::abs(dot(out_normals[i], normalize(tt))) <= ScalarT(1e-3));
+        CHECK(length(tg::vec<3, ScalarT>(out_normals[i])) == nx::approx(ScalarT(1)).abs(1e-5f));
+    }
+
+    // perspective divide
+    auto const proj = tg::perspective_opengl(tg::horizontal_fov(60_deg), 1.5f, 0.1f, 100.f);
+    auto const pm = tg::mat<4, 4, ScalarT>(proj) * m;
+    CHECK(!is_affine(pm));
+    tg::transform_points(pm, pts, out_pts);
+    for (size_t i = 0; i < n; ++i)
+        CHECK(out_pts[i] == nx::approx(pm * pts[i]).abs(1e-3f));
+
+    // in-place
+    auto in_place = pts;
+    tg::transform_points(m, in_place, in_place);
+    for (size_t i = 0; i < n; ++i)
+        CHECK(in_place[i] == nx::approx(m * pts[i]).abs(1e-3f));
+}
+}
+
+FUZZ_TEST("Transform - Bulk")(tg::rng& rng)
+{
+    check_transforms<float>(rng);
+    check_transforms<double>(rng);
+}
+
+TEST("Transform - 2D")
+{
+    auto const m = tg::translation(tg::vec2(1, 2)) * tg::mat3(tg::scaling(2.f, 3.f));
+    std::vector<tg::pos2> pts = {{0, 0}, {1, 1}};
+    std::vector<tg::dir2> normals = {tg::dir2(1, 0), tg::dir2(0, 1)};
+    tg::transform_points(m, pts, pts);
+    tg::transform_normals(m, normals, normals);
+    CHECK(pts[0] == tg::pos2(1, 2));
+    CHECK(pts[1] == tg::pos2(3, 5));
+    CHECK(normals[0] == nx::approx(tg::dir2(1, 0)));
+    CHECK(normals[1] == nx::approx(tg::dir2(0, 1)));
+}
@@ -0,0 +1,97 @@
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/matrix.hh>
+#include <typed-geometry/feature/objects.hh>
+
+#include <vector>
+
+namespace
+{
+template <class Obj, class ScalarT>
+void check_batch(tg::rng& rng, Obj const& obj, tg::aabb<3, ScalarT> const& range, ScalarT eps)
+{
+    std::vector<tg::pos<3, ScalarT>> pts;
+    auto const n = uniform(rng, 0, 300);
+    for (auto i = 0; i < n; ++i)
+        pts.push_back(uniform(rng, range));
+
+    std::vector<tg::u8> out(pts.size(), 2);
+    std::vector<tg::u64> mask((pts.size() + 63) / 64, ~tg::u64(0));
+    tg::contains_batch(obj, pts, out, eps);
+    auto const cnt = tg::contains_batch_mask(obj, pts, mask, eps);
+
+    bool bools[300];
+    tg::contains_batch(obj, tg::span<tg::pos<3, ScalarT> const>(pts), tg::span<bool>(bools, pts.size()), eps);
+
+    size_t expected_cnt = 0;
+    for (size_t i = 0; i < pts.size(); ++i)
+    {
+        auto const expected = contains(obj, pts[i], eps);
+        expected_cnt += expected;
+        CHECK(bool(out[i]) == expected);
+        CHECK(bools[i] == expected);
+        CHECK(bool((mask[i / 64] >> (i % 64)) & 1) == expected);
+    }
+    CHECK(cnt == expected_cnt);
+
+    // unused bits are cleared
+    if (pts.size() % 64 != 0)
+        CHECK(mask.back() >> (pts.size() % 64) == 0);
+}
+
+template <class Obj, class ScalarT>
+void check_batch_no_eps(tg::rng& rng, Obj const& obj, tg::aabb<3, ScalarT> const& range)
+{
+    std::vector<tg::pos<3, ScalarT>> pts;
+    for (auto i = 0; i < 100; ++i)
+        pts.push_back(uniform(rng, range));
+
+    std::vector<tg::u8> out(pts.size());
+    tg::contains_batch(obj, pts, out);
+    for (size_t i = 0; i < pts.size(); ++i)
+        CHECK(bool(out[i]) == contains(obj, pts[i]));
+}
+
+template <class ScalarT>
+void check_objects(tg::rng& rng)
+{
+    using pos_t = tg::pos<3, ScalarT>;
+    auto const range = tg::aabb<3, ScalarT>(ScalarT(-5), ScalarT(5));
+    auto const eps = uniform(rng, ScalarT(0), ScalarT(0.5));
+
+    auto const p0 = uniform(rng, range);
+    auto const p1 = uniform(rng, range);
+    auto const r = uniform(rng, ScalarT(0.5), ScalarT(3));
+
+    check_batch(rng, aabb_of(p0, p1), range, eps);
+    check_batch(rng, tg::sphere<3, ScalarT>(p0, r), range, eps);
+    check_batch(rng, tg::capsule<3, ScalarT>(p0, p1, r), range, eps);
+    check_batch(rng, tg::halfspace<3, ScalarT>(tg::uniform<tg::dir<3, ScalarT>>(rng), p0), range, eps);
+    check_batch_no_eps(rng, tg::cylinder<3, ScalarT>(p0, p1, r), range);
+
+    auto const d0 = tg::uniform<tg::dir<3, ScalarT>>(rng);
+    auto const d1 = any_normal(d0);
+    auto const d2 = normalize(cross(d0, d1));
+    auto m = tg::mat<3, 3, ScalarT>();
+    m[0] = d0 * uniform(rng, ScalarT(1), ScalarT(3));
+    m[1] = d1 * uniform(rng, ScalarT(1), ScalarT(3));
+    m[2] = d2 * uniform(rng, ScalarT(1), ScalarT(3));
+    check_batch(rng, tg::box<3, ScalarT>(p0, m), range, eps);
+
+    // objects without a SIMD kernel use the scalar path
+    check_batch(rng, tg::ellipse<3, ScalarT>(p0, m), range, eps);
+    check_batch(rng, tg::sphere<3, ScalarT>(pos_t::zero, r), range, ScalarT(0));
+}
+}
+
+FUZZ_TEST("ContainsBatch - Matches contains")(tg::rng& rng)
+{
+    check_objects<float>(rng);
+    check_objects<double>(rng);
+
+    auto const view = tg::look_at_opengl(uniform(rng, tg::aabb3(-5, 5)), uniform(rng, tg::aabb3(-5, 5)), tg::dir3::pos_y);
+    auto const proj = tg::perspective_opengl(tg::horizontal_fov(uniform(rng, 30_deg, 80_deg)), uniform(rng, 0.5f, 2.0f), uniform(rng, 0.1f, 1.f), uniform(rng, 10.f, 50.f));
+    auto const frustum = tg::frustum3::from_view_proj(proj * view);
+    check_batch(rng, frustum, tg::aabb3(-20, 20), 0.0f);
+    check_batch(rng, frustum, tg::aabb3(-20, 20), 0.1f);
+}
@@ -0,0 +1,278 @@
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/objects.hh>
+#include <typed-geometry/feature/random.hh>
+
+namespace
+{
+template <class Obj>
+void check_support(tg::rng& rng, Obj const& obj)
+{
+    using ScalarT = typename tg::object_traits<Obj>::scalar_t;
+    constexpr int D = tg::object_traits<Obj>::domain_dimension;
+    auto const tolerance = ScalarT(1e-3);
+
+    auto const d = tg::uniform_vec(rng, tg::sphere_boundary<D, ScalarT>::unit);
+    auto const p = support_point(obj, d);
+    CHECK(contains(obj, p, tolerance));
+
+    for (auto i = 0; i < 20; ++i)
+    {
+        auto const q = uniform(rng, obj);
+        CHECK(dot(q - p, d) <= tolerance);
+    }
+}
+}
+
+FUZZ_TEST("GJK - SupportPoint")(tg::rng& rng)
+{
+    auto const range = tg::aabb3(-5, 5);
+    auto const r = [&] { return uniform(rng, 0.1f, 3.0f); };
+
+    check_support(rng, tg::aabb_of(uniform(rng, range), uniform(rng, range)));
+    check_support(rng, tg::triangle3(uniform(rng, range), uniform(rng, range), uniform(rng, range)));
+    check_support(rng, tg::segment3(uniform(rng, range), uniform(rng, range)));
+    check_support(rng, tg::sphere3(uniform(rng, range), r()));
+    check_support(rng, tg::sphere2in3(uniform(rng, range), r(), tg::uniform<tg::dir3>(rng)));
+    check_support(rng, tg::hemisphere3(uniform(rng, range), r(), tg::uniform<tg::dir3>(rng)));
+    check_support(rng, tg::capsule3(uniform(rng, range), uniform(rng, range), r()));
+    check_support(rng, tg::cylinder3(uniform(rng, range), uniform(rng, range), r()));
+    check_support(rng, tg::box3(uniform(rng, range), tg::mat3(tg::rotation_around(tg::uniform<tg::dir3>(rng), tg::degree(uniform(rng, 0.f, 360.f))))
+                                                         * tg::mat3::diag({r(), r(), r()})));
+    check_support(rng, tg::ellipse3(uniform(rng, range), tg::mat3::diag({r(), r(), r()})));
+    check_support(rng, tg::cone3(tg::sphere2in3(uniform(rng, range), r(), tg::uniform<tg::dir3>(rng)), r()));
+
+    check_support(rng, tg::aabb2(tg::pos2(-1, -2), tg::pos2(3, 1)));
+    check_support(rng, tg::sphere2(tg::pos2(1, 2), r()));
+    check_support(rng, tg::triangle2(tg::pos2(0, 0), tg::pos2(2, 0), tg::pos2(1, 3)));
+}
+
+FUZZ_TEST("GJK - Distance")(tg::rng& rng)
+{
+    auto const range = tg::aabb3(-10, 10);
+    auto const r = [&] { return uniform(rng, 0.1, 3.0); };
+
+    // spheres
+    {
+        auto const a = tg::dsphere3(tg::dpos3(uniform(rng, range)), r());
+        auto const b = tg::dsphere3(tg::dpos3(uniform(rng, range)), r());
+        auto const expected = tg::max(0.0, distance(a.center, b.center) - a.radius - b.radius);
+        auto const res = gjk(a, b);
+        CHECK(res.distance == nx::approx(expected).abs(1e-6));
+        CHECK(res.intersects == (expected == 0));
+        CHECK(intersects_gjk(a, b) == (expected == 0));
+        if (!res.intersects)
+        {
+            CHECK(distance(res.closest_a, res.closest_b) == nx::approx(expected).abs(1e-6));
+            CHECK(contains(a, res.closest_a, 1e-6));
+            CHECK(contains(b, res.closest_b, 1e-6));
+        }
+    }
+
+    // capsules
+    {
+        auto const a = tg::capsule<3, double>(tg::dpos3(uniform(rng, range)), tg::dpos3(uniform(rng, range)), r());
+        auto const b = tg::capsule<3, double>(tg::dpos3(uniform(rng, range)), tg::dpos3(uniform(rng, range)), r());
+        auto const expected = tg::max(0.0, distance(a.axis, b.axis) - a.radius - b.radius);
+        CHECK(distance_gjk(a, b) == nx::approx(expected).abs(1e-6));
+    }
+
+    // aabb and triangle (polytopes converge exactly)
+    {
+        auto const bb = tg::aabb_of(tg::dpos3(uniform(rng, range)), tg::dpos3(uniform(rng, range)));
+        auto const t = tg::dtriangle3(tg::dpos3(uniform(rng, range)), tg::dpos3(uniform(rng, range)), tg::dpos3(uniform(rng, range)));
+
+        auto expected = tg::max<double>();
+        if (intersects(bb, t))
+            expected = 0;
+        else
+        {
+            for (auto p : vertices_of(t))
+                expected = tg::min(expected, distance(bb, p));
+            for (auto p : vertices_of(bb))
+                expected = tg::min(expected, distance(t, p));
+            for (auto e0 : edges_of(t))
+                for (auto e1 : edges_of(bb))
+                    expected = tg::min(expected, distance(e0, e1));
+        }
+
+        CHECK(distance_gjk(bb, t) == nx::approx(expected).abs(1e-9));
+        CHECK(distance_gjk(t, bb) == nx::approx(expected).abs(1e-9));
+        CHECK(intersects_gjk(bb, t) == intersects(bb, t));
+        CHECK(distance(bb, t) == nx::approx(expected).abs(1e-9));
+    }
+
+    // point queries
+    {
+        auto const p = tg::dpos3(uniform(rng, range));
+        auto const b = tg::aabb_of(tg::dpos3(uniform(rng, range)), tg::dpos3(uniform(rng, range)));
+        CHECK(distance_gjk(p, b) == nx::approx(distance(p, b)).abs(1e-9));
+
+        auto const [pa, pb] = closest_points_gjk(b, p);
+        CHECK(distance(pb, p) == nx::approx(0.0).abs(1e-9));
+        CHECK(distance(pa, project(p, b)) == nx::approx(0.0).abs(1e-9));
+    }
+}
+
+FUZZ_TEST("GJK - Intersects")(tg::rng& rng)
+{
+    auto const range = tg::aabb3(-5, 5);
+    auto const range2 = tg::aabb2(-5, 5);
+
+    auto const random_box = [&] {
+        auto const rot = tg::mat3(tg::rotation_around(tg::uniform<tg::dir3>(rng), tg::degree(uniform(rng, 0.f, 360.f))));
+        return tg::box3(uniform(rng, range), rot * tg::mat3::diag({uniform(rng, 0.1f, 3.0f), uniform(rng, 0.1f, 3.0f), uniform(rng, 0.1f, 3.0f)}));
+    };
+
+    // float polytopes: compare with SAT, skipping near-touching configurations
+    {
+        auto const a = random_box();
+        auto const b = random_box();
+
+        tg::vec3 axes[15];
+        auto n = 0;
+        for (auto i = 0; i < 3; ++i)
+        {
+            axes[n++] = a.half_extents[i];
+            axes[n++] = b.half_extents[i];
+            for (auto j = 0; j < 3; ++j)
+                axes[n++] = cross(a.half_extents[i], b.half_extents[j]);
+        }
+        auto const sat = tg::detail::intersects_SAT(a, b, tg::span<tg::vec3 const>(axes));
+
+        auto const d = distance_gjk(a, b);
+        if (d > 1e-3f || d == 0)
+            CHECK(intersects_gjk(a, b) == sat);
+    }
+    {
+        auto const bb = tg::aabb_of(uniform(rng, range), uniform(rng, range));
+        auto const t = tg::triangle3(uniform(rng, range), uniform(rng, range), uniform(rng, range));
+        auto const d = distance_gjk(bb, t);
+        if (d > 1e-3f || d == 0)
+            CHECK(intersects_gjk(bb, t) == intersects(bb, t));
+    }
+    {
+        auto const bb = tg::aabb_of(uniform(rng, range2), uniform(rng, range2));
+        auto const s = tg::sphere2(uniform(rng, range2), uniform(rng, 0.1f, 3.0f));
+        auto const d = distance(bb, s.center) - s.radius;
+        if (tg::abs(d) > 1e-3f)
+            CHECK(intersects_gjk(bb, s) == (d <= 0));
+        if (d > 1e-3f)
+            CHECK(distance_gjk(bb, s) == nx::approx(d).abs(1e-4f));
+    }
+}
+
+TEST("GJK - EPA")
+{
+    // overlapping spheres
+    {
+        auto const a = tg::dsphere3(tg::dpos3(0, 0, 0), 1);
+        auto const b = tg::dsphere3(tg::dpos3(1.5, 0, 0), 1);
+        auto const r = epa(a, b);
+        CHECK(r.intersects);
+        CHECK(r.depth == nx::approx(0.5).abs(1e-4));
+        CHECK(r.normal.x == nx::approx(1.0).abs(1e-2));
+        CHECK(length((r.contact_a - r.contact_b) - r.normal * r.depth) == nx::approx(0.0).abs(1e-9));
+    }
+
+    // overlapping aabbs (exact)
+    {
+        auto const a = tg::daabb3(tg::dpos3(0, 0, 0), tg::dpos3(2, 2, 2));
+        auto const b = tg::daabb3(tg::dpos3(1.7, 0.5, -1), tg::dpos3(4, 1.5, 1.2));
+        auto const r = epa(a, b);
+        CHECK(r.intersects);
+        CHECK(r.depth == nx::approx(0.3).abs(1e-9));
+        CHECK(length(r.normal - tg::dvec3(1, 0, 0)) == nx::approx(0.0).abs(1e-9));
+
+        // translating b by the penetration vector makes them touch
+        auto const moved = tg::daabb3(b.min + r.normal * r.depth, b.max + r.normal * r.depth);
+        CHECK(distance_gjk(a, moved) == nx::approx(0.0).abs(1e-9));
+    }
+
+    // rotated boxes in float
+    {
+        auto const a = tg::box3(tg::pos3(0, 0, 0), tg::mat3(tg::rotation_z(tg::degree(45.f))));
+        auto const b = tg::box3(tg::pos3(2.3f, 0, 0), tg::mat3::identity);
+        auto const r = epa(a, b);
+        CHECK(r.intersects);
+        CHECK(r.depth == nx::approx(tg::sqrt(2.f) + 1 - 2.3f).abs(1e-4f));
+        CHECK(r.normal.x == nx::approx(1.0f).abs(1e-4f));
+    }
+
+    // 2D
+    {
+        auto const a = tg::aabb2(tg::pos2(0, 0), tg::pos2(2, 2));
+        auto const b = tg::sphere2(tg::pos2(1, 2.5f), 1);
+        auto const r = epa(a, b);
+        CHECK(r.intersects);
+        CHECK(r.depth == nx::approx(0.5f).abs(1e-3f));
+        CHECK(r.normal.y == nx::approx(1.0f).abs(1e-3f));
+    }
+
+    // touching and separated objects
+    {
+        auto const a = tg::daabb3(tg::dpos3(0, 0, 0), tg::dpos3(1, 1, 1));
+        auto const b = tg::daabb3(tg::dpos3(1, 0, 0), tg::dpos3(2, 1, 1));
+        auto const r = epa(a, b);
+        CHECK(r.intersects);
+        CHECK(r.depth == nx::approx(0.0).abs(1e-9));
+
+        auto const c = tg::daabb3(tg::dpos3(3, 0, 0), tg::dpos3(4, 1, 1));
+        auto const s = epa(a, c);
+        CHECK(!s.intersects);
+        CHECK(s.depth == 0);
+        CHECK(s.normal == tg::dvec3(1, 0, 0));
+        CHECK(distance(s.contact_a, s.contact_b) == nx::approx(2.0).abs(1e-9));
+    }
+}
+
+FUZZ_TEST("GJK - EPA Random")(tg::rng& rng)
+{
+    auto const range = tg::aabb3(-2, 2);
+
+    // spheres
+    {
+        auto const a = tg::dsphere3(tg::dpos3(uniform(rng, range)), uniform(rng, 0.5, 2.0));
+        auto const b = tg::dsphere3(tg::dpos3(uniform(rng, range)), uniform(rng, 0.5, 2.0));
+        auto const expected = a.radius + b.radius - distance(a.center, b.center);
+        auto const r = epa(a, b);
+        CHECK(r.intersects == (expected >= 0));
+        if (expected > 1e-3)
+        {
+            CHECK(r.depth == nx::approx(expected).abs(1e-5));
+            CHECK(dot(r.normal, normalize(b.center - a.center)) == nx::approx(1.0).abs(1e-4));
+        }
+    }
+
+    // aabbs
+    {
+        auto const a = tg::aabb_of(tg::dpos3(uniform(rng, range)), tg::dpos3(uniform(rng, range)));
+        auto const b = tg::aabb_of(tg::dpos3(uniform(rng, range)), tg::dpos3(uniform(rng, range)));
+        auto expected = tg::max<double>();
+        for (auto i = 0; i < 3; ++i)
+            expected = tg::min(expected, tg::min(a.max[i] - b.min[i], b.max[i] - a.min[i]));
+
+        auto const r = epa(a, b);
+        CHECK(r.intersects == (expected >= 0));
+        if (expected > 1e-6)
+        {
+            CHECK(r.depth == nx::approx(expected).abs(1e-9));
+            auto const moved = tg::daabb3(b.min + r.normal * r.depth, b.max + r.normal * r.depth);
+            CHECK(distance_gjk(a, moved) == nx::approx(0.0).abs(1e-9));
+        }
+    }
+
+    // cylinder and capsule in float: moving b by the penetration vector resolves the collision
+    {
+        auto const a = tg::cylinder3(uniform(rng, range), uniform(rng, range), uniform(rng, 0.2f, 1.0f));
+        auto const b = tg::capsule3(uniform(rng, range), uniform(rng, range), uniform(rng, 0.2f, 1.0f));
+        auto const r = epa(a, b);
+        CHECK(r.intersects == intersects_gjk(a, b));
+        if (r.intersects)
+        {
+            auto const t = r.normal * (r.depth * 1.01f + 1e-3f);
+            auto const moved = tg::capsule3(b.axis.pos0 + t, b.axis.pos1 + t, b.radius);
+            CHECK(!intersects_gjk(a, moved));
+        }
+    }
+}
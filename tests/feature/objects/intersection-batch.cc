@@ -0,0 +1,137 @@
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/matrix.hh>
+#include <typed-geometry/feature/objects.hh>
+
+#include <vector>
+
+namespace
+{
+template <class ScalarT>
+struct soa_bounds
+{
+    std::vector<ScalarT> cx, cy, cz, ex, ey, ez, r;
+
+    tg::aabb_soa_view<ScalarT> aabbs() const { return {cx, cy, cz, ex, ey, ez}; }
+    tg::sphere_soa_view<ScalarT> spheres() const { return {cx, cy, cz, r}; }
+
+    tg::aabb<3, ScalarT> aabb(size_t i) const
+    {
+        // centroid and half extents are exactly representable for these values
+        auto const c = tg::pos<3, ScalarT>(cx[i], cy[i], cz[i]);
+        auto const e = tg::vec<3, ScalarT>(ex[i], ey[i], ez[i]);
+        return {c - e, c + e};
+    }
+    tg::sphere<3, ScalarT> sphere(size_t i) const { return {{cx[i], cy[i], cz[i]}, r[i]}; }
+};
+
+template <class ScalarT>
+soa_bounds<ScalarT> random_bounds(tg::rng& rng, size_t n)
+{
+    // quantized to 1/16 so that the aabb min/max round-trip exactly
+    auto const q = [&](ScalarT lo, ScalarT hi) { return tg::round(uniform(rng, lo, hi) * ScalarT(16)) / ScalarT(16); };
+
+    soa_bounds<ScalarT> b;
+    for (size_t i = 0; i < n; ++i)
+    {
+        b.cx.push_back(q(-60, 60));
+        b.cy.push_back(q(-60, 60));
+        b.cz.push_back(q(-60, 60));
+        b.ex.push_back(q(0, 4));
+        b.ey.push_back(q(0, 4));
+        b.ez.push_back(q(0, 4));
+        b.r.push_back(q(0, 4));
+    }
+    return b;
+}
+
+template <class ScalarT>
+tg::frustum<3, ScalarT> random_frustum(tg::rng& rng)
+{
+    auto const view = tg::look_at_opengl(uniform(rng, tg::aabb3(-5, 5)), uniform(rng, tg::aabb3(-20, 20)), tg::dir3::pos_y);
+    auto const proj = tg::perspective_opengl(tg::horizontal_fov(uniform(rng, 30_deg, 80_deg)), uniform(rng, 0.5f, 2.0f), 0.1f, uniform(rng, 10.f, 50.f));
+    auto const f = tg::frustum3::from_view_proj(proj * view);
+
+    // from_view_proj is f32-only
+    tg::frustum<3, ScalarT> r;
+    for (auto i = 0; i < int(f.planes.size()); ++i)
+        r.planes[i] = {normalize(tg::vec<3, ScalarT>(f.planes[i].normal)), ScalarT(f.planes[i].dis)};
+    return r;
+}
+
+bool bit(std::vector<tg::u64> const& m, size_t i) { return (m[i / 64] >> (i % 64)) & 1; }
+
+template <class ScalarT>
+void check_batch(tg::rng& rng)
+{
+    auto const n = size_t(uniform(rng, 0, 300));
+    auto const words = (n + 63) / 64;
+    auto const b = random_bounds<ScalarT>(rng, n);
+
+    std::vector<tg::frustum<3, ScalarT>> frusta;
+    for (auto i = uniform(rng, 1, 4); i > 0; --i)
+        frusta.push_back(random_frustum<ScalarT>(rng));
+
+    // single frustum
+    {
+        auto const& f = frusta[0];
+        std::vector<tg::u64> ma(words, ~tg::u64(0)), ms(words, ~tg::u64(0));
+        auto const ca = tg::intersects_conservative_batch(f, b.aabbs(), ma);
+        auto const cs = tg::intersects_conservative_batch(f, b.spheres(), ms);
+
+        size_t ea = 0, es = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            auto const va = intersects_conservative(f, b.aabb(i));
+            auto const vs = intersects_conservative(f, b.sphere(i));
+            ea += va;
+            es += vs;
+            CHECK(bit(ma, i) == va);
+            CHECK(bit(ms, i) == vs);
+        }
+        CHECK(ca == ea);
+        CHECK(cs == es);
+
+        if (n % 64 != 0)
+        {
+            CHECK(ma.back() >> (n % 64) == 0);
+            CHECK(ms.back() >> (n % 64) == 0);
+        }
+    }
+
+    // multiple frusta
+    {
+        std::vector<tg::u64> ma(words * frusta.size()), ms(words * frusta.size());
+        auto const eps = ScalarT(0.5);
+        tg::intersects_conservative_batch<ScalarT>(frusta, b.aabbs(), ma);
+        tg::intersects_conservative_batch<ScalarT>(frusta, b.spheres(), ms, eps);
+
+        for (size_t f = 0; f < frusta.size(); ++f)
+            for (size_t i = 0; i < n; ++i)
+            {
+                CHECK(bool((ma[f * words + i / 64] >> (i % 64)) & 1) == intersects_conservative(frusta[f], b.aabb(i)));
+                CHECK(bool((ms[f * words + i / 64] >> (i % 64)) & 1) == intersects_conservative(frusta[f], b.sphere(i), eps));
+            }
+    }
+
+    // inf_frustum
+    {
+        auto const view = tg::look_at_opengl(tg::pos3::zero, tg::pos3(0, 0, -1), tg::dir3::pos_y);
+        auto const proj = tg::perspective_reverse_z_opengl(tg::horizontal_fov(60_deg), 1.0f, 0.1f);
+        auto const f32_frustum = tg::inf_frustum3::from_view_proj_reverse_z(proj * view);
+        tg::inf_frustum<3, ScalarT> f;
+        for (auto i = 0; i < int(f.planes.size()); ++i)
+            f.planes[i] = {normalize(tg::vec<3, ScalarT>(f32_frustum.planes[i].normal)), ScalarT(f32_frustum.planes[i].dis)};
+        std::vector<tg::u64> ma(words);
+        tg::intersects_conservative_batch(f, b.aabbs(), ma);
+        for (size_t i = 0; i < n; ++i)
+            CHECK(bit(ma, i) == intersects_conservative(f, b.aabb(i)));
+    }
+}
+}
+
+FUZZ_TEST("IntersectionBatch - Frustum culling")(tg::rng& rng)
+{
+    check_batch<float>(rng);
+    check_batch<double>(rng);
+}
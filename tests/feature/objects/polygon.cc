@@ -0,0 +1,137 @@
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/objects.hh>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// counter-clockwise polygon that is star-shaped around c (angular gaps < 180 degree)
+tg::polygon2 random_star(tg::rng& rng, tg::pos2 c, int n)
+{
+    auto const step = 360.f / float(n);
+
+    tg::polygon2 p;
+    for (auto i = 0; i < n; ++i)
+    {
+        auto const a = tg::degree(step * (float(i) + uniform(rng, 0.25f, 0.75f)));
+        auto const r = uniform(rng, 1.f, 10.f);
+        p.vertices.push_back(c + tg::vec2(tg::cos(a), tg::sin(a)) * r);
+    }
+    return p;
+}
+}
+
+FUZZ_TEST("Polygon - AreaCentroidAabb")(tg::rng& rng)
+{
+    auto const c = uniform(rng, tg::aabb2(tg::pos2(-100), tg::pos2(100)));
+    auto const poly = random_star(rng, c, uniform(rng, 4, 40));
+    auto const n = poly.size();
+
+    // triangle fan from the star center
+    auto area = 0.f;
+    auto centroid = tg::vec2::zero;
+    for (auto i = 0u; i < n; ++i)
+    {
+        auto const t = tg::triangle2(c, poly[i], poly[(i + 1) % n]);
+        auto const a = signed_area_of(t);
+        area += a;
+        centroid += (centroid_of(t) - c) * a;
+    }
+
+    auto const eps = 1e-4f * (1 + area);
+    CHECK(signed_area_of(poly) == nx::approx(area).abs(eps));
+    CHECK(area_of(poly) == nx::approx(area).abs(eps));
+    CHECK(distance(centroid_of(poly), c + centroid / area) < 1e-2f);
+
+    auto reversed = poly;
+    std::reverse(reversed.vertices.begin(), reversed.vertices.end());
+    CHECK(signed_area_of(reversed) == nx::approx(-area).abs(eps));
+
+    auto bb = tg::aabb2(poly[0], poly[0]);
+    for (auto const& v : poly.vertices)
+        bb = aabb_of(bb, v);
+    CHECK(aabb_of(poly) == bb);
+}
+
+FUZZ_TEST("Polygon - Contains")(tg::rng& rng)
+{
+    auto const c = uniform(rng, tg::aabb2(tg::pos2(-100), tg::pos2(100)));
+    auto const poly = random_star(rng, c, uniform(rng, 4, 40));
+    auto indexed = poly;
+    indexed.build_slab_index();
+    CHECK(indexed.has_slab_index());
+
+    auto const n = poly.size();
+    auto const bb = aabb_of(poly);
+    auto const range = tg::aabb2(bb.min - tg::vec2(1), bb.max + tg::vec2(1));
+    for (auto i = 0; i < 100; ++i)
+    {
+        auto const p = uniform(rng, range);
+
+        auto in_fan = false;
+        for (auto j = 0u; j < n; ++j)
+            in_fan = in_fan || contains(tg::triangle2(c, poly[j], poly[(j + 1) % n]), p);
+
+        CHECK(contains(poly, p) == in_fan);
+        CHECK(contains(indexed, p) == in_fan);
+    }
+
+    // vertices shared by many slabs
+    for (auto const& v : poly.vertices)
+        CHECK(contains(indexed, v) == contains(poly, v));
+}
+
+FUZZ_TEST("Polygon - ZigZagWithoutIndex")(tg::rng& rng)
+{
+    // every tooth edge crosses almost every slab of the valleys, the index would be quadratic
+    auto const k = 200;
+    tg::polygon2 poly;
+    poly.vertices.push_back(tg::pos2(0, 0));
+    poly.vertices.push_back(tg::pos2(float(k), 0));
+    for (auto i = k - 1; i >= 0; --i)
+    {
+        poly.vertices.push_back(tg::pos2(float(i + 1), 1 + 0.01f * float(i)));
+        poly.vertices.push_back(tg::pos2(float(i) + 0.5f, 10 + 0.01f * float(i)));
+    }
+
+    auto indexed = poly;
+    indexed.build_slab_index();
+    CHECK(!indexed.has_slab_index());
+    CHECK(indexed.slab_edges.empty());
+
+    auto const range = tg::aabb2(tg::pos2(-1, -1), tg::pos2(float(k) + 1, 12));
+    for (auto i = 0; i < 100; ++i)
+    {
+        auto const p = uniform(rng, range);
+        CHECK(contains(indexed, p) == contains(poly, p));
+    }
+    CHECK(contains(indexed, tg::pos2(float(k) / 2, 0.5f)));
+    CHECK(!contains(indexed, tg::pos2(float(k) / 2, 11.5f)));
+
+    // a generous limit builds it, an unbounded one is clamped to what the u32 offsets can address
+    indexed.build_slab_index(size_t(-1));
+    CHECK(indexed.has_slab_index());
+    indexed.build_slab_index(size_t(4 * k));
+    CHECK(indexed.has_slab_index());
+    for (auto i = 0; i < 100; ++i)
+    {
+        auto const p = uniform(rng, range);
+        CHECK(contains(indexed, p) == contains(poly, p));
+    }
+}
+
+FUZZ_TEST("Polygon - Coverage")(tg::rng& rng)
+{
+    auto const size = tg::isize2(32, 32);
+    auto const poly = random_star(rng, tg::pos2(16, 16), uniform(rng, 4, 40));
+
+    std::vector<tg::u8> coverage(size.width * size.height);
+    tg::rasterize_coverage(poly, coverage, size);
+
+    auto sum = 0.f;
+    for (auto v : coverage)
+        sum += float(v) / 255;
+    CHECK(tg::abs(sum - area_of(poly)) <= 0.5f + 0.01f * area_of(poly));
+}
@@ -0,0 +1,162 @@
+#include <nexus/fuzz_test.hh>
+#include <nexus/test.hh>
+
+#include <typed-geometry/feature/objects.hh>
+
+#include <vector>
+
+namespace
+{
+// exact area of a polygon clipped to an axis-aligned box (sutherland-hodgman)
+float clipped_area(std::vector<tg::pos2> poly, tg::aabb2 const& box)
+{
+    for (auto axis = 0; axis < 2; ++axis)
+        for (auto side = 0; side < 2; ++side)
+        {
+            auto const c = side == 0 ? box.min[axis] : box.max[axis];
+            auto const inside = [&](tg::pos2 const& p) { return side == 0 ? p[axis] >= c : p[axis] <= c; };
+            std::vector<tg::pos2> out;
+            for (auto i = 0u; i < poly.size(); ++i)
+            {
+                auto const a = poly[(i + poly.size() - 1) % poly.size()];
+                auto const b = poly[i];
+                if (inside(a) != inside(b))
+                    out.push_back(a + (b - a) * ((c - a[axis]) / (b[axis] - a[axis])));
+                if (inside(b))
+                    out.push_back(b);
+            }
+            poly = out;
+        }
+
+    auto a = 0.f;
+    for (auto i = 0u; i < poly.size(); ++i)
+        a += cross(poly[i] - tg::pos2::zero, poly[(i + 1) % poly.size()] - tg::pos2::zero);
+    return tg::abs(a) / 2;
+}
+
+float total_coverage(std::vector<tg::u8> const& c)
+{
+    auto s = 0.f;
+    for (auto v : c)
+        s += float(v) / 255;
+    return s;
+}
+}
+
+FUZZ_TEST("RasterizeCoverage - ExactArea")(tg::rng& rng)
+{
+    auto const size = tg::isize2(uniform(rng, 1, 40), uniform(rng, 1, 40));
+    auto const range = tg::aabb2(tg::pos2(-8), tg::pos2(float(size.width) + 8, float(size.height) + 8));
+
+    std::vector<tg::pos2> tri = {uniform(rng, range), uniform(rng, range), uniform(rng, range)};
+    std::vector<tg::u8> coverage(size.width * size.height);
+    tg::rasterize_coverage(tri, coverage, size, uniform(rng, 0, 1) == 0 ? tg::fill_rule::nonzero : tg::fill_rule::even_odd);
+
+    for (auto y = 0; y < size.height; ++y)
+        for (auto x = 0; x < size.width; ++x)
+        {
+            auto const ref = clipped_area(tri, tg::aabb2(tg::pos2(float(x), float(y)), tg::pos2(float(x + 1), float(y + 1))));
+            CHECK(tg::abs(float(coverage[x + size.width * y]) / 255 - ref) <= 0.5f / 255 + 1e-3f);
+        }
+}
+
+FUZZ_TEST("RasterizeCoverage - Origin")(tg::rng& rng)
+{
+    // the same polygon in tile coordinates and shifted by the tile origin
+    auto const size = tg::isize2(uniform(rng, 1, 40), uniform(rng, 1, 40));
+    auto const origin = tg::pos2(float(uniform(rng, -100, 100)), float(uniform(rng, -100, 100)));
+    auto const range = tg::aabb2(tg::pos2(-4), tg::pos2(float(size.width) + 4, float(size.height) + 4));
+
+    std::vector<tg::pos2> poly;
+    std::vector<tg::pos2> poly_shifted;
+    for (auto i = uniform(rng, 3, 8); i > 0; --i)
+    {
+        poly.push_back(uniform(rng, range));
+        poly_shifted.push_back(poly.back() + (origin - tg::pos2::zero));
+    }
+
+    std::vector<tg::u8> c0(size.width * size.height);
+    std::vector<tg::u8> c1(size.width * size.height);
+    tg::rasterize_coverage(poly, c0, size);
+
+    tg::coverage_buffer buffer(size, origin);
+    buffer.add_polygon(poly_shifted);
+    buffer.resolve(c1);
+
+    for (auto i = 0u; i < c0.size(); ++i)
+        CHECK(tg::abs(int(c0[i]) - int(c1[i])) <= 1);
+}
+
+TEST("RasterizeCoverage - FillRule")
+{
+    auto const size = tg::isize2(16, 16);
+    std::vector<tg::pos2> const square = {{2, 2}, {10, 2}, {10, 10}, {2, 10}};
+
+    // the same square twice: winding 2 inside
+    tg::coverage_buffer buffer(size);
+    buffer.add_polygon(square);
+    buffer.add_polygon(square);
+
+    std::vector<tg::u8> nonzero(size.width * size.height);
+    std::vector<tg::u8> even_odd(size.width * size.height);
+    buffer.resolve(nonzero, tg::fill_rule::nonzero);
+    buffer.resolve(even_odd, tg::fill_rule::even_odd);
+
+    for (auto y = 0; y < size.height; ++y)
+        for (auto x = 0; x < size.width; ++x)
+        {
+            auto const in = x >= 2 && x < 10 && y >= 2 && y < 10;
+            CHECK(nonzero[x + size.width * y] == (in ? 255 : 0));
+            CHECK(even_odd[x + size.width * y] == 0);
+        }
+}
+
+FUZZ_TEST("RasterizeCoverage - Curves")(tg::rng& rng)
+{
+    auto const size = tg::isize2(64, 64);
+    auto const range = tg::aabb2(tg::pos2(4), tg::pos2(60));
+    std::vector<tg::u8> coverage(size.width * size.height);
+
+    // quadratic bezier closed by its chord, the enclosed area is 2/3 of the control triangle
+    {
+        auto const p0 = uniform(rng, range);
+        auto const p1 = uniform(rng, range);
+        auto const p2 = uniform(rng, range);
+
+        tg::coverage_buffer buffer(size);
+        buffer.add_bezier(tg::bezier<2, tg::pos2>(p0, p1, p2), 0.01f);
+        buffer.add_line(p2, p0);
+        buffer.resolve(coverage);
+
+        auto const ref = tg::abs(cross(p1 - p0, p2 - p0)) / 3;
+        CHECK(tg::abs(total_coverage(coverage) - ref) <= 0.01f * ref + 0.5f);
+    }
+
+    // a cubic bezier that is a straight line encloses nothing with its chord
+    {
+        auto const p0 = uniform(rng, range);
+        auto const p3 = uniform(rng, range);
+
+        tg::coverage_buffer buffer(size);
+        buffer.add_bezier(tg::bezier<3, tg::pos2>(p0, p0 + (p3 - p0) * (1.f / 3), p0 + (p3 - p0) * (2.f / 3), p3));
+        buffer.add_line(p3, p0);
+        buffer.resolve(coverage);
+
+        CHECK(total_coverage(coverage) < 0.1f);
+    }
+
+    // straight stroke: area is length * width
+    {
+        auto const p0 = uniform(rng, range);
+        auto const p1 = uniform(rng, range);
+        auto const w = uniform(rng, 0.5f, 3.f);
+
+        std::vector<tg::pos2> const line = {p0, p1};
+        tg::coverage_buffer buffer(size);
+        buffer.add_polyline(line, w);
+        buffer.resolve(coverage);
+
+        auto const ref = length(p1 - p0) * w;
+        CHECK(tg::abs(total_coverage(coverage) - ref) <= 0.01f * ref + 0.5f);
+    }
+}
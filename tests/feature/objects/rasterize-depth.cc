@@ -0,0 +1,120 @@
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/objects.hh>
+
+#include <vector>
+
+namespace
+{
+tg::triangle2 xy_of(tg::triangle4 const& t) { return {tg::pos2(t.pos0.x, t.pos0.y), tg::pos2(t.pos1.x, t.pos1.y), tg::pos2(t.pos2.x, t.pos2.y)}; }
+}
+
+FUZZ_TEST("RasterizeDepth - Watertight")(tg::rng& rng)
+{
+    // jittered grid mesh covering more than the viewport, every pixel must be covered exactly once
+    auto const size = tg::isize2(uniform(rng, 1, 70), uniform(rng, 1, 70));
+    auto const spacing = uniform(rng, 2.f, 9.f);
+    auto const cols = int(float(size.width) / spacing) + 3;
+    auto const rows = int(float(size.height) / spacing) + 3;
+
+    std::vector<tg::pos4> verts;
+    for (auto y = 0; y <= rows; ++y)
+        for (auto x = 0; x <= cols; ++x)
+        {
+            auto const j = tg::vec2(uniform(rng, -0.2f, 0.2f), uniform(rng, -0.2f, 0.2f)) * spacing;
+            verts.emplace_back(float(x - 1) * spacing + j.x, float(y - 1) * spacing + j.y, 0.5f, uniform(rng, 0.5f, 2.f));
+        }
+
+    std::vector<tg::triangle4> tris;
+    auto const add = [&](int a, int b, int c) {
+        if (uniform(rng, 0, 1) == 0)
+            tris.emplace_back(verts[a], verts[b], verts[c]);
+        else
+            tris.emplace_back(verts[a], verts[c], verts[b]);
+    };
+    for (auto y = 0; y < rows; ++y)
+        for (auto x = 0; x < cols; ++x)
+        {
+            auto const i = y * (cols + 1) + x;
+            add(i, i + 1, i + cols + 2);
+            add(i, i + cols + 2, i + cols + 1);
+        }
+
+    std::vector<float> depth(size.width * size.height, 1.f);
+    std::vector<int> count(depth.size(), 0);
+    tg::rasterize_depth(tris, depth, size, [&](tg::u32 tri, tg::ipos2 p, float z, float a, float b) {
+        CHECK(tri < tris.size());
+        CHECK(0 <= p.x && p.x < size.width && 0 <= p.y && p.y < size.height);
+        CHECK(z == 0.5f);
+        CHECK(a >= -0.001f);
+        CHECK(b >= -0.001f);
+        CHECK(a + b <= 1.001f);
+        count[p.x + size.width * p.y]++;
+    });
+
+    for (auto i = 0u; i < depth.size(); ++i)
+    {
+        CHECK(count[i] == 1);
+        CHECK(depth[i] == 0.5f);
+    }
+}
+
+FUZZ_TEST("RasterizeDepth - DepthTest")(tg::rng& rng)
+{
+    auto const size = tg::isize2(uniform(rng, 1, 80), uniform(rng, 1, 80));
+    auto const range = tg::aabb2(tg::pos2(-10), tg::pos2(float(size.width) + 10, float(size.height) + 10));
+
+    std::vector<tg::triangle4> tris;
+    auto const cnt = uniform(rng, 0, 20);
+    for (auto i = 0; i < cnt; ++i)
+    {
+        auto const v = [&] {
+            auto const p = uniform(rng, range);
+            return tg::pos4(p.x, p.y, uniform(rng, 0.f, 1.f), uniform(rng, 0.5f, 3.f));
+        };
+        tris.emplace_back(v(), v(), v());
+    }
+
+    std::vector<float> depth(size.width * size.height, 1.f);
+    tg::rasterize_depth(tris, depth, size);
+    std::vector<float> depth_cb(size.width * size.height, 1.f);
+    tg::rasterize_depth(tris, depth_cb, size, [&](tg::u32 tri, tg::ipos2 p, float z, float a, float b) {
+        // perspective-correct barycentrics
+        auto const t = tris[tri];
+        auto const l = coordinates(xy_of(t), tg::pos2(float(p.x) + 0.5f, float(p.y) + 0.5f));
+        auto const p0 = l[0] / t.pos0.w;
+        auto const p1 = l[1] / t.pos1.w;
+        auto const p2 = l[2] / t.pos2.w;
+        CHECK(tg::abs(a - p0 / (p0 + p1 + p2)) < 1e-3f);
+        CHECK(tg::abs(b - p1 / (p0 + p1 + p2)) < 1e-3f);
+        CHECK(tg::abs(z - (l[0] * t.pos0.z + l[1] * t.pos1.z + l[2] * t.pos2.z)) < 1e-3f);
+    });
+    CHECK(depth == depth_cb);
+
+    // brute force reference, pixels too close to an edge are skipped
+    for (auto y = 0; y < size.height; ++y)
+        for (auto x = 0; x < size.width; ++x)
+        {
+            auto const c = tg::pos2(float(x) + 0.5f, float(y) + 0.5f);
+            auto ref = 1.f;
+            auto ambiguous = false;
+            for (auto const& t : tris)
+            {
+                auto const tri2 = xy_of(t);
+                if (area(tri2) < 0.01f)
+                {
+                    ambiguous = true;
+                    continue;
+                }
+                auto const l = coordinates(tri2, c);
+                auto const m = tg::min(l[0], tg::min(l[1], l[2]));
+                if (tg::abs(m) < 1e-3f)
+                    ambiguous = true;
+                else if (m > 0)
+                    ref = tg::min(ref, l[0] * t.pos0.z + l[1] * t.pos1.z + l[2] * t.pos2.z);
+            }
+
+            if (!ambiguous)
+                CHECK(tg::abs(depth[x + size.width * y] - ref) < 1e-3f);
+        }
+}
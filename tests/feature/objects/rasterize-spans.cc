@@ -0,0 +1,88 @@
+#include <nexus/fuzz_test.hh>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include <typed-geometry/tg-std.hh>
+
+FUZZ_TEST("RasterizeSpans - Segment")(tg::rng& rng)
+{
+    auto const range2 = tg::aabb2(tg::pos2(-20), tg::pos2(20));
+    auto const seg = tg::segment2(uniform(rng, range2), uniform(rng, range2));
+
+    std::vector<tg::ipos2> ref;
+    tg::rasterize(seg, [&](tg::ipos2 p, float) { ref.push_back(p); });
+
+    std::vector<tg::ipos2> pixels;
+    tg::rasterize_spans(seg, [&](int y, int x_begin, int x_end, float a, float da) {
+        CHECK(x_begin < x_end);
+        for (auto x = x_begin; x < x_end; ++x)
+        {
+            auto const ax = a + float(x - x_begin) * da;
+            CHECK(ax >= -1e-5f);
+            CHECK(ax <= 1 + 1e-5f);
+            pixels.emplace_back(x, y);
+        }
+    });
+
+    std::sort(ref.begin(), ref.end(), std::less<tg::ipos2>());
+    std::sort(pixels.begin(), pixels.end(), std::less<tg::ipos2>());
+    CHECK(pixels == ref);
+}
+
+FUZZ_TEST("RasterizeSpans - Circle")(tg::rng& rng)
+{
+    auto const circle = tg::icircle2(tg::ipos2(uniform(rng, -10, 10), uniform(rng, -10, 10)), uniform(rng, 0, 40));
+
+    std::map<tg::ipos2, int> ref;
+    tg::rasterize(circle, [&](tg::ipos2 p) { ref[p] = 1; });
+
+    std::map<tg::ipos2, int> pixels;
+    auto last_y = circle.center.y - circle.radius;
+    tg::rasterize_spans(circle, [&](int y, int x_begin, int x_end) {
+        CHECK(x_begin < x_end);
+        CHECK(y >= last_y);
+        last_y = y;
+        for (auto x = x_begin; x < x_end; ++x)
+            pixels[tg::ipos2(x, y)]++;
+    });
+
+    // same pixels, each emitted exactly once
+    CHECK(pixels == ref);
+}
+
+FUZZ_TEST("RasterizeSpans - Triangle")(tg::rng& rng)
+{
+    auto const range2 = tg::aabb2(tg::pos2(-20), tg::pos2(20));
+    auto const tri = tg::triangle2(uniform(rng, range2), uniform(rng, range2), uniform(rng, range2));
+    auto const offset = uniform(rng, 0, 1) == 0 ? tg::vec2(0) : tg::vec2(0.5f);
+
+    std::map<tg::ipos2, tg::vec2> ref;
+    tg::rasterize(
+        tri, [&](tg::ipos2 p, float a, float b) { ref[p] = tg::vec2(a, b); }, offset);
+
+    std::map<tg::ipos2, tg::vec2> pixels;
+    tg::rasterize_spans<float>(
+        tri,
+        [&](int y, int x_begin, int x_end, float a, float b, float da, float db) {
+            CHECK(x_begin < x_end);
+            for (auto x = x_begin; x < x_end; ++x)
+            {
+                auto const p = tg::ipos2(x, y);
+                CHECK(pixels.count(p) == 0u);
+                pixels[p] = tg::vec2(a + float(x - x_begin) * da, b + float(x - x_begin) * db);
+            }
+        },
+        offset);
+
+    // interpolated and directly computed coordinates differ more for slivers
+    auto const tolerance = 1e-3f * tg::max(1.f, 1.f / area(tri));
+    CHECK(pixels.size() == ref.size());
+    for (auto const& [p, ab] : pixels)
+    {
+        CHECK(ref.count(p) == 1u);
+        CHECK(length(ab - ref[p]) < tolerance);
+    }
+}
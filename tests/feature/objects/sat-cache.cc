@@ -0,0 +1,83 @@
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/objects.hh>
+#include <typed-geometry/feature/random.hh>
+
+namespace
+{
+tg::box3 random_box(tg::rng& rng, tg::aabb3 const& range)
+{
+    auto const rot = tg::mat3(tg::rotation_around(tg::uniform<tg::dir3>(rng), tg::degree(uniform(rng, 0.f, 360.f))));
+    return tg::box3(uniform(rng, range), rot * tg::mat3::diag({uniform(rng, 0.1f, 3.0f), uniform(rng, 0.1f, 3.0f), uniform(rng, 0.1f, 3.0f)}));
+}
+
+template <class A, class B>
+bool full_sat(A const& a, B const& b)
+{
+    for (auto i = 0; i < tg::detail::sat_axes<A, B>::count; ++i)
+        if (tg::detail::sat_separates(a, b, i))
+            return false;
+    return true;
+}
+}
+
+FUZZ_TEST("SatCache - BoxBox")(tg::rng& rng)
+{
+    auto const range = tg::aabb3(-4, 4);
+    auto a = random_box(rng, range);
+    auto b = random_box(rng, range);
+
+    // intersects(box3, box3) vs. GJK (skipping near-touching configurations)
+    {
+        auto const d = distance_gjk(a, b);
+        if (d > 1e-3f || d == 0)
+            CHECK(intersects(a, b) == intersects_gjk(a, b));
+    }
+
+    // persistent pair with small motions
+    tg::sat_cache<tg::box3, tg::box3> cache;
+    CHECK(cache.cached_axis() == -1);
+    auto const step = tg::uniform_vec(rng, tg::sphere3(tg::pos3::zero, 0.1f));
+    for (auto i = 0; i < 50; ++i)
+    {
+        a.center += step;
+        b.center -= step;
+
+        auto const r = cache.intersects(a, b);
+        CHECK(r == intersects(a, b));
+        CHECK(r == full_sat(a, b));
+        if (r)
+            CHECK(cache.cached_axis() == -1);
+        else
+            CHECK(tg::detail::sat_separates(a, b, cache.cached_axis()));
+    }
+
+    cache.reset();
+    CHECK(cache.cached_axis() == -1);
+}
+
+FUZZ_TEST("SatCache - BoxTriangle")(tg::rng& rng)
+{
+    auto const range = tg::aabb3(-4, 4);
+    auto b = random_box(rng, range);
+    auto t = tg::triangle3(uniform(rng, range), uniform(rng, range), uniform(rng, range));
+
+    tg::sat_cache<tg::box3, tg::triangle3> cache;
+    tg::sat_cache<tg::triangle3, tg::box3> cache_swapped;
+    auto const step = tg::uniform_vec(rng, tg::sphere3(tg::pos3::zero, 0.1f));
+    for (auto i = 0; i < 50; ++i)
+    {
+        b.center += step;
+
+        auto const r = cache.intersects(b, t);
+        CHECK(r == full_sat(b, t));
+        CHECK(r == cache_swapped.intersects(t, b));
+        if (!r)
+            CHECK(tg::detail::sat_separates(b, t, cache.cached_axis()));
+
+        // the SAT result is exact, compare with GJK away from touching configurations
+        auto const d = distance_gjk(b, t);
+        if (d > 1e-3f || d == 0)
+            CHECK(r == intersects_gjk(b, t));
+    }
+}
@@ -0,0 +1,174 @@
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/objects.hh>
+
+#include <utility>
+#include <vector>
+
+namespace
+{
+struct visit
+{
+    tg::ipos3 cell;
+    float t_enter;
+    float t_exit;
+};
+
+/// parameter interval of o + t * d inside b for t in [t0, t1] (empty if lo > hi)
+void clip(tg::pos3 o, tg::vec3 d, tg::aabb3 const& b, float& lo, float& hi)
+{
+    for (auto i = 0; i < 3; ++i)
+    {
+        if (d[i] == 0)
+        {
+            if (o[i] < b.min[i] || o[i] > b.max[i])
+                hi = -1;
+            continue;
+        }
+        auto ta = (b.min[i] - o[i]) / d[i];
+        auto tb = (b.max[i] - o[i]) / d[i];
+        if (ta > tb)
+            std::swap(ta, tb);
+        lo = tg::max(lo, ta);
+        hi = tg::min(hi, tb);
+    }
+}
+
+/// checks order, adjacency, and the parameters against brute force clipping of every cell
+void check_traversal(std::vector<visit> const& vs, tg::pos3 o, tg::vec3 d, tg::aabb3 const& grid, tg::isize3 res, float t_max)
+{
+    for (size_t i = 0; i < vs.size(); ++i)
+    {
+        CHECK(vs[i].t_enter <= vs[i].t_exit);
+        if (i > 0)
+        {
+            auto const dc = vs[i].cell - vs[i - 1].cell;
+            CHECK(tg::abs(dc.x) + tg::abs(dc.y) + tg::abs(dc.z) == 1);
+            CHECK(vs[i].t_enter == vs[i - 1].t_exit);
+        }
+    }
+
+    auto const cs = tg::vec3((grid.max - grid.min).x / res.width, (grid.max - grid.min).y / res.height, (grid.max - grid.min).z / res.depth);
+    auto const eps = 1e-3f;
+    size_t pierced = 0;
+    for (auto z = 0; z < res.depth; ++z)
+        for (auto y = 0; y < res.height; ++y)
+            for (auto x = 0; x < res.width; ++x)
+            {
+                auto const lo = grid.min + tg::vec3(float(x), float(y), float(z)) * cs;
+                auto t0 = 0.f;
+                auto t1 = t_max;
+                clip(o, d, tg::aabb3(lo, lo + cs), t0, t1);
+
+                auto found = -1;
+                for (size_t i = 0; i < vs.size(); ++i)
+                    if (vs[i].cell == tg::ipos3(x, y, z))
+                        found = int(i);
+
+                if (t1 - t0 > eps)
+                {
+                    // clearly pierced
+                    ++pierced;
+                    CHECK(found >= 0);
+                    if (found >= 0)
+                    {
+                        CHECK(tg::abs(vs[found].t_enter - t0) < eps);
+                        CHECK(tg::abs(vs[found].t_exit - t1) < eps);
+                    }
+                }
+                else if (t1 < t0 - eps)
+                    CHECK(found < 0); // clearly missed
+            }
+    CHECK(vs.size() >= pierced);
+}
+}
+
+FUZZ_TEST("TraverseGrid - Ray")(tg::rng& rng)
+{
+    auto const grid = tg::aabb3(uniform(rng, tg::aabb3(-3, -1)), uniform(rng, tg::aabb3(1, 3)));
+    auto const res = tg::isize3(uniform(rng, 1, 12), uniform(rng, 1, 12), uniform(rng, 1, 12));
+
+    auto dir = tg::uniform<tg::dir3>(rng);
+    if (uniform(rng, 0, 3) == 0)
+        dir = tg::dir3::pos_y; // axis-aligned
+    auto const r = tg::ray3(uniform(rng, tg::aabb3(-4, 4)), dir);
+    auto const t_max = uniform(rng, 0.f, 10.f);
+
+    std::vector<visit> vs;
+    CHECK(tg::traverse_grid(r, grid, res, [&](tg::ipos3 c, float t0, float t1) { vs.push_back({c, t0, t1}); }, t_max));
+    for (auto const& v : vs)
+        CHECK(0 <= v.cell.x && v.cell.x < res.width && 0 <= v.cell.y && v.cell.y < res.height && 0 <= v.cell.z && v.cell.z < res.depth);
+    check_traversal(vs, r.origin, tg::vec3(r.dir), grid, res, t_max);
+
+    // early termination
+    if (vs.size() > 2)
+    {
+        auto cnt = 0;
+        CHECK(!tg::traverse_grid(r, grid, res, [&](tg::ipos3, float, float) { return ++cnt < 2; }, t_max));
+        CHECK(cnt == 2);
+    }
+}
+
+FUZZ_TEST("TraverseGrid - Segment")(tg::rng& rng)
+{
+    auto const grid = tg::aabb3(-2, 2);
+    auto const res = tg::isize3(uniform(rng, 1, 10), uniform(rng, 1, 10), uniform(rng, 1, 10));
+    auto const s = tg::segment3(uniform(rng, tg::aabb3(-3, 3)), uniform(rng, tg::aabb3(-3, 3)));
+
+    std::vector<visit> vs;
+    tg::traverse_grid(s, grid, res, [&](tg::ipos3 c, float t0, float t1) { vs.push_back({c, t0, t1}); });
+    check_traversal(vs, s.pos0, s.pos1 - s.pos0, grid, res, 1.f);
+
+    // unbounded grid: starts in the cell of pos0, ends in the cell of pos1
+    auto const cell_size = uniform(rng, 0.1f, 1.f);
+    std::vector<visit> us;
+    tg::traverse_grid(s, cell_size, [&](tg::ipos3 c, float t0, float t1) { us.push_back({c, t0, t1}); });
+    CHECK(!us.empty());
+    CHECK(us.front().cell == tg::ipos3(tg::ifloor(s.pos0.x / cell_size), tg::ifloor(s.pos0.y / cell_size), tg::ifloor(s.pos0.z / cell_size)));
+    CHECK(us.back().cell == tg::ipos3(tg::ifloor(s.pos1.x / cell_size), tg::ifloor(s.pos1.y / cell_size), tg::ifloor(s.pos1.z / cell_size)));
+    CHECK(us.front().t_enter == 0.f);
+    CHECK(us.back().t_exit == 1.f);
+    for (size_t i = 1; i < us.size(); ++i)
+    {
+        auto const dc = us[i].cell - us[i - 1].cell;
+        CHECK(tg::abs(dc.x) + tg::abs(dc.y) + tg::abs(dc.z) == 1);
+        CHECK(us[i].t_enter == us[i - 1].t_exit);
+    }
+}
+
+FUZZ_TEST("TraverseGrid - Packet")(tg::rng& rng)
+{
+    auto const grid = tg::aabb3(-2, 2);
+    auto const res = tg::isize3(uniform(rng, 1, 16), uniform(rng, 1, 16), uniform(rng, 1, 16));
+
+    // coherent rays from a common origin
+    auto const o = uniform(rng, tg::aabb3(-5, 5));
+    auto const target = uniform(rng, tg::aabb3(-1, 1));
+    tg::ray3 rays[8];
+    for (auto& r : rays)
+        r = tg::ray3(o, normalize(target + uniform(rng, tg::aabb3(-0.5f, 0.5f)) - o));
+    auto const packet = tg::ray3_packet8(rays);
+
+    std::vector<visit> lanes[8];
+    auto const stopped = tg::traverse_grid(packet, grid, res, [&](int l, tg::ipos3 c, float t0, float t1) {
+        lanes[l].push_back({c, t0, t1});
+        return l != 3 || lanes[l].size() < 2;
+    });
+
+    for (auto l = 0; l < 8; ++l)
+    {
+        std::vector<visit> expected;
+        auto const completed = tg::traverse_grid(rays[l], grid, res, [&](tg::ipos3 c, float t0, float t1) {
+            expected.push_back({c, t0, t1});
+            return l != 3 || expected.size() < 2;
+        });
+        CHECK(bool((stopped >> l) & 1) == !completed);
+        CHECK(lanes[l].size() == expected.size());
+        for (size_t i = 0; i < expected.size() && i < lanes[l].size(); ++i)
+        {
+            CHECK(lanes[l][i].cell == expected[i].cell);
+            CHECK(lanes[l][i].t_enter == expected[i].t_enter);
+            CHECK(lanes[l][i].t_exit == expected[i].t_exit);
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/objects.hh>
+
+#include <vector>
+
+namespace
+{
+template <class Obj>
+void check_voxelize(Obj const& obj, tg::aabb3 const& grid, tg::isize3 res, bool solid)
+{
+    std::vector<int> count(res.width * res.height * res.depth, 0);
+    auto blocks = 0;
+    auto large_blocks = 0;
+    tg::voxelize(obj, grid, res, [&](tg::ipos3 b, tg::ipos3 e) {
+        CHECK(0 <= b.x && b.x < e.x && e.x <= res.width);
+        CHECK(0 <= b.y && b.y < e.y && e.y <= res.height);
+        CHECK(0 <= b.z && b.z < e.z && e.z <= res.depth);
+        ++blocks;
+        large_blocks += (e.x - b.x) * (e.y - b.y) * (e.z - b.z) > 1;
+        for (auto z = b.z; z < e.z; ++z)
+            for (auto y = b.y; y < e.y; ++y)
+                for (auto x = b.x; x < e.x; ++x)
+                    count[x + res.width * (y + res.height * z)]++;
+    });
+
+    // exactly the voxels that intersect the object, each one once
+    auto const cs = tg::vec3((grid.max - grid.min).x / res.width, (grid.max - grid.min).y / res.height, (grid.max - grid.min).z / res.depth);
+    auto voxels = 0;
+    for (auto z = 0; z < res.depth; ++z)
+        for (auto y = 0; y < res.height; ++y)
+            for (auto x = 0; x < res.width; ++x)
+            {
+                // same rounding as the block bounds
+                auto const lo = grid.min + tg::vec3(float(x) * cs.x, float(y) * cs.y, float(z) * cs.z);
+                auto const hi = grid.min + tg::vec3(float(x + 1) * cs.x, float(y + 1) * cs.y, float(z + 1) * cs.z);
+                auto const expected = intersects(obj, tg::aabb3(lo, hi));
+                auto const c = count[x + res.width * (y + res.height * z)];
+                CHECK(c == (expected ? 1 : 0));
+                voxels += expected;
+            }
+
+    // large, compact solid objects are reported in blocks
+    if (solid && voxels > 1000)
+        CHECK(large_blocks > 0);
+    CHECK(blocks <= voxels);
+}
+}
+
+FUZZ_TEST("Voxelize - Objects")(tg::rng& rng)
+{
+    auto const grid = tg::aabb3(-2, 2);
+    auto const res = tg::isize3(uniform(rng, 1, 24), uniform(rng, 1, 24), uniform(rng, 1, 24));
+    auto const range = tg::aabb3(-2.5f, 2.5f);
+
+    check_voxelize(tg::sphere3(uniform(rng, range), uniform(rng, 0.1f, 2.f)), grid, res, true);
+    check_voxelize(tg::capsule3(uniform(rng, range), uniform(rng, range), uniform(rng, 0.1f, 1.f)), grid, res, false);
+    check_voxelize(tg::triangle3(uniform(rng, range), uniform(rng, range), uniform(rng, range)), grid, res, false);
+    check_voxelize(aabb_of(uniform(rng, range), uniform(rng, range)), grid, res, true);
+}
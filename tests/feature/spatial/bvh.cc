@@ -0,0 +1,93 @@
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/spatial.hh>
+
+#include <vector>
+
+FUZZ_TEST("Bvh - Triangles")(tg::rng& rng)
+{
+    auto const range = tg::aabb3(-10, 10);
+
+    std::vector<tg::triangle3> tris;
+    auto const cnt = uniform(rng, 1, 200);
+    for (auto i = 0; i < cnt; ++i)
+    {
+        auto const c = uniform(rng, range);
+        auto const s = uniform(rng, 0.1f, 2.0f);
+        tris.emplace_back(c + tg::uniform<tg::dir3>(rng) * s, c + tg::uniform<tg::dir3>(rng) * s, c + tg::uniform<tg::dir3>(rng) * s);
+    }
+
+    auto const tree = tg::bvh<tg::triangle3>(tris, uniform(rng, 1, 8));
+    CHECK(tree.size() == tris.size());
+    CHECK(tree.bounds() == aabb_of(tris));
+
+    // every object is referenced by exactly one leaf
+    std::vector<int> refs(tris.size(), 0);
+    for (auto const& n : tree.nodes())
+        if (n.is_leaf())
+            for (auto i = n.first; i < n.first + n.count; ++i)
+                refs[tree.indices()[i]]++;
+    for (auto r : refs)
+        CHECK(r == 1);
+
+    for (auto it = 0; it < 20; ++it)
+    {
+        auto const ray = tg::ray3(uniform(rng, range), tg::uniform<tg::dir3>(rng));
+
+        auto bestT = tg::max<float>();
+        auto bestIdx = -1;
+        for (auto i = 0; i < int(tris.size()); ++i)
+            if (auto const t = tg::closest_intersection_parameter(ray, tris[i]); t.has_value() && t.value() < bestT)
+            {
+                bestT = t.value();
+                bestIdx = i;
+            }
+
+        auto const hit = tree.closest_hit(ray);
+        CHECK(hit.has_value() == (bestIdx >= 0));
+        CHECK(tree.any_hit(ray) == (bestIdx >= 0));
+        CHECK(tg::intersects(ray, tree) == (bestIdx >= 0));
+        if (hit.has_value() && bestIdx >= 0)
+        {
+            CHECK(hit.value().t == nx::approx(bestT));
+            CHECK(tg::closest_intersection_parameter(ray, tris[hit.value().index]).value() == nx::approx(bestT));
+            CHECK(tg::closest_intersection(ray, tree).value() == nx::approx(ray[bestT]));
+
+            CHECK(!tree.any_hit(ray, bestT * 0.99f));
+        }
+
+        auto const box = aabb_of(uniform(rng, range), uniform(rng, range));
+        std::vector<bool> found(tris.size(), false);
+        auto foundCnt = 0;
+        tree.for_each_intersecting(box, [&](tg::u32 idx) {
+            found[idx] = true;
+            ++foundCnt;
+        });
+        auto expectedCnt = 0;
+        for (auto i = 0; i < int(tris.size()); ++i)
+        {
+            auto const e = tg::intersects(tris[i], box);
+            expectedCnt += int(e);
+            CHECK(found[i] == e);
+        }
+        CHECK(foundCnt == expectedCnt);
+        CHECK(tg::intersects(box, tree) == (expectedCnt > 0));
+    }
+}
+
+TEST("Bvh - Degenerate input")
+{
+    auto const empty = tg::bvh<tg::sphere3>();
+    CHECK(empty.empty());
+    CHECK(!empty.closest_hit(tg::ray3(tg::pos3::zero, tg::dir3::pos_x)).has_value());
+
+    // identical centroids cannot be separated by SAH
+    std::vector<tg::sphere3> spheres(100, tg::sphere3(tg::pos3(5, 0, 0), 1.0f));
+    auto const tree = tg::bvh<tg::sphere3>(spheres);
+    CHECK(tree.size() == 100);
+
+    auto const hit = tree.closest_hit(tg::ray3(tg::pos3::zero, tg::dir3::pos_x));
+    REQUIRE(hit.has_value());
+    CHECK(hit.value().t == nx::approx(4.0f));
+    CHECK(!tree.any_hit(tg::ray3(tg::pos3::zero, tg::dir3::neg_x)));
+}
@@ -0,0 +1,253 @@
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/spatial.hh>
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using tree_t = tg::dynamic_aabb_tree<3, float>;
+
+/// checks parent links, heights, balance and containment, returns the number of leaves below n
+int check_node(tree_t const& tree, tg::u32 n)
+{
+    auto const& node = tree.nodes()[n];
+    if (node.is_leaf())
+    {
+        CHECK(node.height == 0);
+        CHECK(contains(node.bounds, tree.bounds_of(n)));
+        return 1;
+    }
+
+    auto const& c1 = tree.nodes()[node.child1];
+    auto const& c2 = tree.nodes()[node.child2];
+    CHECK(c1.parent == n);
+    CHECK(c2.parent == n);
+    CHECK(node.height == 1 + tg::max(c1.height, c2.height));
+    CHECK(tg::abs(c1.height - c2.height) <= 1);
+    CHECK(contains(node.bounds, c1.bounds));
+    CHECK(contains(node.bounds, c2.bounds));
+    return check_node(tree, node.child1) + check_node(tree, node.child2);
+}
+
+void check_tree(tree_t const& tree)
+{
+    if (tree.empty())
+    {
+        CHECK(tree.root() == tg::dynamic_aabb_tree_null);
+        return;
+    }
+    CHECK(tree.nodes()[tree.root()].parent == tg::dynamic_aabb_tree_null);
+    CHECK(check_node(tree, tree.root()) == int(tree.size()));
+}
+
+std::vector<std::pair<tg::u32, tg::u32>> brute_force_pairs(std::vector<tg::aabb3> const& boxes, std::vector<bool> const& alive)
+{
+    std::vector<std::pair<tg::u32, tg::u32>> r;
+    for (tg::u32 a = 0; a < boxes.size(); ++a)
+        for (auto b = a + 1; b < boxes.size(); ++b)
+            if (alive[a] && alive[b] && intersects(boxes[a], boxes[b]))
+                r.emplace_back(a, b);
+    return r;
+}
+
+std::vector<std::pair<tg::u32, tg::u32>> brute_force_fat_pairs(tree_t const& tree, std::vector<bool> const& alive)
+{
+    std::vector<std::pair<tg::u32, tg::u32>> r;
+    for (tg::u32 a = 0; a < alive.size(); ++a)
+        for (auto b = a + 1; b < alive.size(); ++b)
+            if (alive[a] && alive[b] && intersects(tree.fat_bounds_of(a), tree.fat_bounds_of(b)))
+                r.emplace_back(a, b);
+    return r;
+}
+
+tg::aabb3 random_box(tg::rng& rng, tg::aabb3 const& range)
+{
+    auto const c = uniform(rng, range);
+    auto const e = tg::vec3(uniform(rng, 0.1f, 2.f), uniform(rng, 0.1f, 2.f), uniform(rng, 0.1f, 2.f));
+    return {c - e, c + e};
+}
+}
+
+FUZZ_TEST("DynamicAabbTree - Insert Move Remove")(tg::rng& rng)
+{
+    auto const range = tg::aabb3(-30, 30);
+    tree_t tree(0.2f);
+
+    // ids are indices into boxes
+    std::vector<tg::aabb3> boxes;
+    std::vector<bool> alive;
+    auto const add = [&] {
+        auto const b = random_box(rng, range);
+        auto const id = tree.insert(b);
+        if (id >= boxes.size())
+        {
+            boxes.resize(id + 1);
+            alive.resize(id + 1);
+        }
+        CHECK(!alive[id]);
+        boxes[id] = b;
+        alive[id] = true;
+        return id;
+    };
+
+    auto const cnt = uniform(rng, 1, 300);
+    for (auto i = 0; i < cnt; ++i)
+        add();
+    check_tree(tree);
+
+    // all pairs
+    auto const pairs_of = [&](auto&& query) {
+        std::vector<std::pair<tg::u32, tg::u32>> r;
+        query([&](tg::u32 a, tg::u32 b) {
+            CHECK(a < b);
+            r.emplace_back(a, b);
+        });
+        std::sort(r.begin(), r.end());
+        return r;
+    };
+    CHECK(pairs_of([&](auto&& f) { tree.for_each_pair(f); }) == brute_force_pairs(boxes, alive));
+
+    // persistent candidate pairs as a broadphase would keep them
+    auto const initial = pairs_of([&](auto&& f) { tree.update_pairs(f); });
+    CHECK(initial == brute_force_fat_pairs(tree, alive));
+    std::set<std::pair<tg::u32, tg::u32>> candidates(initial.begin(), initial.end());
+
+    for (auto frame = 0; frame < 5; ++frame)
+    {
+        // move some, remove some, add some
+        std::vector<bool> moved(boxes.size());
+        for (tg::u32 id = 0; id < boxes.size(); ++id)
+        {
+            if (!alive[id])
+                continue;
+
+            auto const r = uniform(rng, 0, 9);
+            if (r == 0)
+            {
+                tree.remove(id);
+                alive[id] = false;
+                for (auto it = candidates.begin(); it != candidates.end();)
+                    it = it->first == id || it->second == id ? candidates.erase(it) : std::next(it);
+            }
+            else if (r < 5)
+            {
+                auto const d = tg::vec3(uniform(rng, -1.f, 1.f), uniform(rng, -1.f, 1.f), uniform(rng, -1.f, 1.f));
+                boxes[id] = {boxes[id].min + d, boxes[id].max + d};
+                if (tree.move(id, boxes[id], d))
+                    moved[id] = true;
+                CHECK(contains(tree.fat_bounds_of(id), boxes[id]));
+            }
+        }
+        for (auto i = uniform(rng, 0, 20); i > 0; --i)
+        {
+            auto const id = add();
+            moved.resize(boxes.size());
+            moved[id] = true;
+        }
+        check_tree(tree);
+
+        // update_pairs reports exactly the fat-overlapping pairs that involve a reinserted object
+        std::vector<std::pair<tg::u32, tg::u32>> expected_updated;
+        for (auto const& [a, b] : brute_force_fat_pairs(tree, alive))
+            if (moved[a] || moved[b])
+                expected_updated.emplace_back(a, b);
+        auto const updated = pairs_of([&](auto&& f) { tree.update_pairs(f); });
+        CHECK(updated == expected_updated);
+        CHECK(pairs_of([&](auto&& f) { tree.update_pairs(f); }).empty());
+
+        // every tight overlap, also between objects that stayed inside their fat aabbs, is already a candidate
+        candidates.insert(updated.begin(), updated.end());
+        auto const all = brute_force_pairs(boxes, alive);
+        for (auto const& p : all)
+            CHECK(candidates.count(p) == 1u);
+
+        CHECK(pairs_of([&](auto&& f) { tree.for_each_pair(f); }) == all);
+
+        // box queries
+        for (auto it = 0; it < 10; ++it)
+        {
+            auto const q = random_box(rng, range);
+            std::vector<tg::u32> found;
+            tree.for_each_intersecting(q, [&](tg::u32 id) { found.push_back(id); });
+            std::sort(found.begin(), found.end());
+
+            std::vector<tg::u32> expected;
+            for (tg::u32 id = 0; id < boxes.size(); ++id)
+                if (alive[id] && intersects(boxes[id], q))
+                    expected.push_back(id);
+            CHECK(found == expected);
+            CHECK(intersects(q, tree) == !expected.empty());
+        }
+
+        // ray queries
+        for (auto it = 0; it < 10; ++it)
+        {
+            auto const r = tg::ray3(uniform(rng, range), tg::uniform<tg::dir3>(rng));
+            std::vector<tg::u32> found;
+            tree.raycast(r, [&](tg::u32 id, float t) {
+                CHECK(t >= 0.f);
+                found.push_back(id);
+            });
+            std::sort(found.begin(), found.end());
+
+            std::vector<tg::u32> expected;
+            for (tg::u32 id = 0; id < boxes.size(); ++id)
+                if (alive[id] && intersects(r, boxes[id]))
+                    expected.push_back(id);
+            CHECK(found == expected);
+        }
+    }
+
+    // clipping the ray to the closest hit finds the first box
+    {
+        tree_t t;
+        auto const a = t.insert(tg::aabb3({5, -1, -1}, {6, 1, 1}));
+        auto const b = t.insert(tg::aabb3({2, -1, -1}, {3, 1, 1}));
+        t.insert(tg::aabb3({2, 5, 5}, {3, 6, 6}));
+
+        auto closest = tg::dynamic_aabb_tree_null;
+        t.raycast(tg::ray3({0, 0, 0}, tg::dir3::pos_x), [&](tg::u32 id, float tt) {
+            closest = id;
+            return tt;
+        });
+        CHECK(closest == b);
+
+        t.remove(b);
+        closest = tg::dynamic_aabb_tree_null;
+        t.raycast(tg::ray3({0, 0, 0}, tg::dir3::pos_x), [&](tg::u32 id, float tt) {
+            closest = id;
+            return tt;
+        });
+        CHECK(closest == a);
+    }
+}
+
+TEST("DynamicAabbTree - Balanced")
+{
+    // sorted insertion degenerates without rotations
+    tree_t tree(0.f);
+    for (auto i = 0; i < 4096; ++i)
+        tree.insert(tg::aabb3({float(i), 0, 0}, {float(i) + 0.5f, 1, 1}));
+
+    check_tree(tree);
+    CHECK(tree.height() <= 2 * 12);
+
+    for (tg::u32 i = 0; i < 4096; i += 2)
+        tree.remove(i);
+    check_tree(tree);
+    CHECK(tree.size() == 2048);
+
+    // freed ids are reused
+    auto const id = tree.insert(tg::aabb3({0, 0, 0}, {1, 1, 1}));
+    CHECK(id < 4096 * 2);
+    CHECK(tree.nodes()[id].height == 0);
+
+    tree.clear();
+    CHECK(tree.empty());
+    CHECK(tree.height() == -1);
+}
@@ -0,0 +1,139 @@
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/spatial.hh>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+template <int D>
+void check_kdtree(tg::rng& rng, tg::kdtree<D, float> const& tree, std::vector<tg::pos<D, float>> const& pts, tg::aabb<D, float> const& range)
+{
+    CHECK(tree.size() == pts.size());
+
+    // every input point appears exactly once
+    std::vector<int> seen(pts.size());
+    for (auto i = 0; i < int(tree.size()); ++i)
+    {
+        CHECK(tree.points()[i] == pts[tree.indices()[i]]);
+        ++seen[tree.indices()[i]];
+    }
+    CHECK(std::all_of(seen.begin(), seen.end(), [](int c) { return c == 1; }));
+
+    for (auto it = 0; it < 10; ++it)
+    {
+        auto const q = uniform(rng, range);
+
+        std::vector<float> dists;
+        for (auto const& p : pts)
+            dists.push_back(distance_sqr(p, q));
+        auto sorted = dists;
+        std::sort(sorted.begin(), sorted.end());
+
+        // nearest
+        auto const n = tree.nearest(q);
+        CHECK(n.distance_sqr == sorted[0]);
+        CHECK(dists[n.index] == n.distance_sqr);
+        CHECK(distance_sqr(project(q, tree), q) == sorted[0]);
+        CHECK(distance_sqr(q, tree) == sorted[0]);
+
+        // knn
+        auto const k = size_t(uniform(rng, 1, 20));
+        auto const knn = tree.knn(q, k);
+        CHECK(knn.size() == tg::min(k, pts.size()));
+        for (size_t i = 0; i < knn.size(); ++i)
+        {
+            CHECK(knn[i].distance_sqr == sorted[i]);
+            CHECK(dists[knn[i].index] == knn[i].distance_sqr);
+        }
+
+        // radius
+        auto const r = uniform(rng, 0.f, 5.f);
+        auto const in_radius = tree.radius_search(q, r);
+        auto expected = 0;
+        for (auto d : dists)
+            expected += int(d <= r * r);
+        CHECK(int(in_radius.size()) == expected);
+        for (size_t i = 0; i < in_radius.size(); ++i)
+        {
+            CHECK(dists[in_radius[i].index] <= r * r);
+            if (i > 0)
+                CHECK(in_radius[i - 1].distance_sqr <= in_radius[i].distance_sqr);
+        }
+    }
+
+    // batched knn agrees with single queries
+    std::vector<tg::pos<D, float>> queries;
+    for (auto i = 0; i < 50; ++i)
+        queries.push_back(uniform(rng, range));
+    auto const k = size_t(4);
+    std::vector<tg::kdtree_neighbor<float>> batch(queries.size() * k);
+    tree.knn_batch(queries, k, batch);
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        auto const single = tree.knn(queries[i], k);
+        for (size_t j = 0; j < k; ++j)
+        {
+            if (j < single.size())
+                CHECK(batch[i * k + j].distance_sqr == single[j].distance_sqr);
+            else
+                CHECK(batch[i * k + j].index == tg::u32(-1));
+        }
+    }
+}
+}
+
+TEST("KdTree - LeafCount")
+{
+    // reference: recursive median splits
+    auto const reference = [](size_t n) {
+        auto const rec = [](auto const& self, size_t m) -> size_t { return m <= tg::kdtree_leaf_size ? 1 : self(self, m / 2) + self(self, m - m / 2); };
+        return rec(rec, n);
+    };
+
+    for (size_t n = 1; n < 3000; ++n)
+        CHECK(tg::detail::kdtree_leaf_count(n, tg::kdtree_leaf_size) == reference(n));
+}
+
+FUZZ_TEST("KdTree - Queries")(tg::rng& rng)
+{
+    auto const range3 = tg::aabb3(-10, 10);
+    std::vector<tg::pos3> pts3;
+    auto const cnt = uniform(rng, 1, 500);
+    for (auto i = 0; i < cnt; ++i)
+        pts3.push_back(uniform(rng, range3));
+    // duplicates and coplanar points
+    for (auto i = 0; i < cnt / 4; ++i)
+        pts3.push_back(pts3[i]);
+    for (auto i = 0; i < cnt / 4; ++i)
+        pts3.push_back({uniform(rng, -10.f, 10.f), uniform(rng, -10.f, 10.f), 1.f});
+
+    check_kdtree(rng, tg::kdtree<3, float>(pts3), pts3, range3);
+
+    auto const range2 = tg::aabb2(-10, 10);
+    std::vector<tg::pos2> pts2;
+    for (auto i = 0; i < cnt; ++i)
+        pts2.push_back(uniform(rng, range2));
+
+    check_kdtree(rng, tg::kdtree<2, float>(pts2), pts2, range2);
+}
+
+TEST("KdTree - Parallel build")
+{
+    tg::rng rng;
+    auto const range = tg::aabb3(-100, 100);
+
+    // large enough to fork during the build
+    std::vector<tg::pos3> pts;
+    for (auto i = 0; i < 200000; ++i)
+        pts.push_back(uniform(rng, range));
+
+    auto const tree = tg::kdtree<3, float>(pts);
+    check_kdtree(rng, tree, pts, range);
+
+    auto const empty = tg::kdtree<3, float>();
+    CHECK(empty.empty());
+    CHECK(empty.knn(tg::pos3::zero, 3).empty());
+    CHECK(empty.radius_search(tg::pos3::zero, 1.f).empty());
+}
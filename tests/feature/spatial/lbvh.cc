@@ -0,0 +1,114 @@
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/spatial.hh>
+
+#include <vector>
+
+namespace
+{
+void check_lbvh(tg::rng& rng, tg::lbvh<float> const& tree, std::vector<tg::triangle3> const& tris)
+{
+    auto const range = tg::aabb3(-10, 10);
+
+    CHECK(tree.size() == tris.size());
+    CHECK(tree.bounds() == aabb_of(tris));
+
+    // internal bounds contain their children
+    for (auto const& n : tree.nodes())
+        for (auto c : {n.left, n.right})
+        {
+            auto const& cb = (c & tg::lbvh_leaf_bit) ? aabb_of(tree.triangles()[c & ~tg::lbvh_leaf_bit]) : tree.nodes()[c].bounds;
+            CHECK(contains(n.bounds, cb));
+        }
+
+    for (auto it = 0; it < 10; ++it)
+    {
+        auto const ray = tg::ray3(uniform(rng, range), tg::uniform<tg::dir3>(rng));
+
+        auto bestT = tg::max<float>();
+        auto bestIdx = -1;
+        for (auto i = 0; i < int(tris.size()); ++i)
+            if (auto const t = tg::closest_intersection_parameter(ray, tris[i]); t.has_value() && t.value() < bestT)
+            {
+                bestT = t.value();
+                bestIdx = i;
+            }
+
+        auto const hit = tree.closest_hit(ray);
+        CHECK(hit.has_value() == (bestIdx >= 0));
+        CHECK(tg::intersects(ray, tree) == (bestIdx >= 0));
+        if (hit.has_value() && bestIdx >= 0)
+            CHECK(hit.value().t == nx::approx(bestT));
+
+        auto const box = aabb_of(uniform(rng, range), uniform(rng, range));
+        auto foundCnt = 0;
+        tree.for_each_intersecting(box, [&](tg::u32 idx) {
+            CHECK(tg::intersects(tris[idx], box));
+            ++foundCnt;
+        });
+        auto expectedCnt = 0;
+        for (auto const& t : tris)
+            expectedCnt += int(tg::intersects(t, box));
+        CHECK(foundCnt == expectedCnt);
+    }
+}
+}
+
+FUZZ_TEST("Lbvh - Build and refit")(tg::rng& rng)
+{
+    auto const range = tg::aabb3(-10, 10);
+
+    std::vector<tg::triangle3> tris;
+    auto const cnt = uniform(rng, 1, 300);
+    for (auto i = 0; i < cnt; ++i)
+    {
+        auto const c = uniform(rng, range);
+        auto const s = uniform(rng, 0.1f, 2.0f);
+        tris.emplace_back(c + tg::uniform<tg::dir3>(rng) * s, c + tg::uniform<tg::dir3>(rng) * s, c + tg::uniform<tg::dir3>(rng) * s);
+    }
+
+    auto tree = tg::lbvh<float>(tris);
+    check_lbvh(rng, tree, tris);
+
+    // deform and refit
+    for (auto& t : tris)
+    {
+        t.pos0 += uniform_vec(rng, tg::aabb3(-1, 1));
+        t.pos1 += uniform_vec(rng, tg::aabb3(-1, 1));
+        t.pos2 += uniform_vec(rng, tg::aabb3(-1, 1));
+    }
+    tree.refit(tris);
+    check_lbvh(rng, tree, tris);
+}
+
+TEST("Lbvh - Parallel build")
+{
+    tg::rng rng;
+    auto const range = tg::aabb3(-100, 100);
+
+    // large enough to use multiple threads, includes duplicated triangles
+    std::vector<tg::triangle3> tris;
+    for (auto i = 0; i < 20000; ++i)
+    {
+        auto const c = uniform(rng, range);
+        tris.emplace_back(c, c + tg::vec3(1, 0, 0), c + tg::vec3(0, 1, 0));
+    }
+    for (auto i = 0; i < 1000; ++i)
+        tris.push_back(tris[i]);
+
+    auto tree = tg::lbvh<float>(tris);
+    check_lbvh(rng, tree, tris);
+
+    for (auto& t : tris)
+    {
+        t.pos0.z += 5;
+        t.pos1.z += 5;
+        t.pos2.z += 5;
+    }
+    tree.refit(tris);
+    check_lbvh(rng, tree, tris);
+
+    auto const single = tg::lbvh<float>(tg::span<tg::triangle3 const>(tris.data(), 1));
+    CHECK(single.bounds() == aabb_of(tris[0]));
+    CHECK(single.closest_hit(tg::ray3(centroid_of(tris[0]) + tg::vec3(0, 0, 1), tg::dir3::neg_z)).has_value());
+}
@@ -0,0 +1,120 @@
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/spatial.hh>
+
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+/// closed mesh of the surface of [-s, s]^3 with res x res quads per face, outward facing
+void make_cube(int res, float s, std::vector<tg::pos3>& vertices, std::vector<tg::u32>& indices)
+{
+    std::map<std::tuple<int, int, int>, tg::u32> vertex_ids;
+    auto const vertex = [&](int x, int y, int z) {
+        auto const key = std::make_tuple(x, y, z);
+        auto const it = vertex_ids.find(key);
+        if (it != vertex_ids.end())
+            return it->second;
+        auto const id = tg::u32(vertices.size());
+        vertices.push_back(tg::pos3(float(x), float(y), float(z)) * (2 * s / float(res)) - tg::vec3(s));
+        vertex_ids[key] = id;
+        return id;
+    };
+
+    for (auto k = 0; k < 3; ++k)
+        for (auto side = 0; side < 2; ++side)
+        {
+            // (u, v, k) is right-handed, swap u and v for the negative side
+            auto u = (k + 1) % 3;
+            auto v = (k + 2) % 3;
+            if (side == 0)
+                std::swap(u, v);
+
+            for (auto i = 0; i < res; ++i)
+                for (auto j = 0; j < res; ++j)
+                {
+                    tg::u32 q[4];
+                    int const offsets[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+                    for (auto c = 0; c < 4; ++c)
+                    {
+                        int p[3];
+                        p[k] = side * res;
+                        p[u] = i + offsets[c][0];
+                        p[v] = j + offsets[c][1];
+                        q[c] = vertex(p[0], p[1], p[2]);
+                    }
+                    indices.insert(indices.end(), {q[0], q[1], q[2], q[0], q[2], q[3]});
+                }
+        }
+}
+}
+
+FUZZ_TEST("MeshDistance - Closest and signed distance")(tg::rng& rng)
+{
+    std::vector<tg::pos3> vertices;
+    std::vector<tg::u32> indices;
+    make_cube(uniform(rng, 1, 6), 1.f, vertices, indices);
+
+    auto const md = tg::mesh_distance<float>(vertices, indices);
+    CHECK(md.triangle_count() * 3 == indices.size());
+    CHECK(aabb_of(md) == tg::aabb3(-1, 1));
+
+    std::vector<tg::pos3> queries;
+    for (auto i = 0; i < 50; ++i)
+        queries.push_back(uniform(rng, tg::aabb3(-3, 3)));
+    // near edges and corners, where the face normal alone gives wrong signs
+    for (auto i = 0; i < 50; ++i)
+        queries.push_back(tg::pos3(uniform(rng, {-1.f, 1.f}), uniform(rng, {-1.f, 1.f}), uniform(rng, -1.1f, 1.1f)) * 1.05f);
+
+    std::vector<float> signed_dists(queries.size());
+    md.signed_distance_batch(queries, signed_dists);
+
+    for (size_t qi = 0; qi < queries.size(); ++qi)
+    {
+        auto const q = queries[qi];
+
+        // brute force
+        auto best = tg::max<float>();
+        for (size_t t = 0; t < md.triangle_count(); ++t)
+            best = tg::min(best, distance_sqr(q, project(q, md.triangle_at(t))));
+
+        auto const c = md.closest(q);
+        CHECK(c.distance_sqr == nx::approx(best).abs(1e-5f));
+        CHECK(distance_sqr(c.point, q) == nx::approx(c.distance_sqr).abs(1e-5f));
+        CHECK(distance_sqr(q, project(q, md.triangle_at(c.triangle))) == nx::approx(best).abs(1e-5f));
+        CHECK(distance_sqr(q, md) == nx::approx(best).abs(1e-5f));
+
+        // sign
+        auto const box = tg::aabb3(-1, 1);
+        auto const d = md.signed_distance(q);
+        CHECK(signed_dists[qi] == d);
+        CHECK(tg::abs(d) == nx::approx(tg::sqrt(best)).abs(1e-4f));
+        if (tg::sqrt(best) > 1e-4f)
+        {
+            auto const inside = q.x > -1 && q.x < 1 && q.y > -1 && q.y < 1 && q.z > -1 && q.z < 1;
+            CHECK((d < 0) == inside);
+            CHECK((signed_distance(q, md) < 0) == inside);
+        }
+    }
+}
+
+TEST("MeshDistance - Hausdorff")
+{
+    std::vector<tg::pos3> va, vb;
+    std::vector<tg::u32> ia, ib;
+    make_cube(4, 1.f, va, ia);
+    make_cube(3, 2.f, vb, ib);
+
+    auto const a = tg::mesh_distance<float>(va, ia);
+    auto const b = tg::mesh_distance<float>(vb, ib);
+
+    // every point of the small cube is 1 away from the large one, the corners of the large cube are sqrt(3) away from the small one
+    CHECK(a.directed_hausdorff_distance(b) == nx::approx(1.f));
+    CHECK(a.directed_hausdorff_distance(b, 3) == nx::approx(1.f));
+    CHECK(b.directed_hausdorff_distance(a) == nx::approx(tg::sqrt(3.f)));
+    CHECK(hausdorff_distance(a, b, 2) == nx::approx(tg::sqrt(3.f)));
+    CHECK(hausdorff_distance(a, a) == 0.f);
+}
@@ -0,0 +1,82 @@
+#include <nexus/test.hh>
+
+#include <typed-geometry/feature/spatial.hh>
+
+#include <vector>
+
+namespace
+{
+/// closed, outward facing mesh of the surface of b (12 triangles)
+void make_box(tg::aabb3 const& b, std::vector<tg::pos3>& vertices, std::vector<tg::u32>& indices)
+{
+    for (auto i = 0; i < 8; ++i)
+        vertices.push_back({i & 1 ? b.max.x : b.min.x, i & 2 ? b.max.y : b.min.y, i & 4 ? b.max.z : b.min.z});
+
+    // quads (ccw from outside) of the faces -x, +x, -y, +y, -z, +z
+    tg::u32 const quads[6][4] = {{0, 4, 6, 2}, {1, 3, 7, 5}, {0, 1, 5, 4}, {2, 6, 7, 3}, {0, 2, 3, 1}, {4, 5, 7, 6}};
+    for (auto const& q : quads)
+        indices.insert(indices.end(), {q[0], q[1], q[2], q[0], q[2], q[3]});
+}
+}
+
+TEST("SdfGrid - Bake")
+{
+    std::vector<tg::pos3> vertices;
+    std::vector<tg::u32> indices;
+    make_box(tg::aabb3({-1, -0.5f, -0.7f}, {1, 0.5f, 0.7f}), vertices, indices);
+    auto const md = tg::mesh_distance<float>(vertices, indices);
+
+    // sanity: the mesh is closed and outward facing
+    CHECK(md.signed_distance(tg::pos3::zero) == nx::approx(-0.5f));
+    CHECK(md.signed_distance({3, 0, 0}) == nx::approx(2.f));
+
+    auto const voxel_size = 0.0625f;
+    auto const bounds = tg::aabb3(-2, 2);
+    auto const sdf = tg::bake_sdf(md, bounds, voxel_size);
+    auto const sdf16 = tg::bake_sdf_i16(md, bounds, voxel_size, 1.f);
+
+    CHECK(sdf.dims == tg::isize3(64, 64, 64));
+    CHECK(sdf16.dims == sdf.dims);
+    CHECK(sdf.values.size() == 64 * 64 * 64);
+
+    auto max_err = 0.f;
+    for (auto z = 0; z < sdf.dims.depth; ++z)
+        for (auto y = 0; y < sdf.dims.height; ++y)
+            for (auto x = 0; x < sdf.dims.width; ++x)
+            {
+                auto const exact = md.signed_distance(sdf.center_of(x, y, z));
+                auto const d = sdf.distance_at(x, y, z);
+
+                // narrow band is exact
+                if (tg::abs(exact) <= 2 * voxel_size)
+                    CHECK(d == nx::approx(exact).abs(1e-5f));
+
+                // propagated values are distances to surface points, so never smaller than the exact distance
+                CHECK(tg::abs(d) >= tg::abs(exact) - 1e-5f);
+                CHECK((d < 0) == (exact < 0));
+                max_err = tg::max(max_err, tg::abs(d - exact));
+
+                // quantized
+                auto const q = sdf16.distance_at(x, y, z);
+                CHECK(q == nx::approx(tg::clamp(d, -1.f, 1.f)).abs(sdf16.scale));
+            }
+
+    // jump flooding is exact for almost all voxels of a box
+    CHECK(max_err < voxel_size);
+}
+
+TEST("SdfGrid - Far from surface")
+{
+    std::vector<tg::pos3> vertices;
+    std::vector<tg::u32> indices;
+    make_box(tg::aabb3(-1, 1), vertices, indices);
+    auto const md = tg::mesh_distance<float>(vertices, indices);
+
+    // no voxel is near the surface, so all values are evaluated exactly
+    auto const sdf = tg::bake_sdf(md, tg::aabb3({5, 5, 5}, {6, 6.5f, 7}), 0.25f);
+    CHECK(sdf.dims == tg::isize3(4, 6, 8));
+    for (auto z = 0; z < sdf.dims.depth; ++z)
+        for (auto y = 0; y < sdf.dims.height; ++y)
+            for (auto x = 0; x < sdf.dims.width; ++x)
+                CHECK(sdf(x, y, z) == nx::approx(md.signed_distance(sdf.center_of(x, y, z))));
+}
@@ -0,0 +1,146 @@
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/spatial.hh>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace
+{
+void check_spatial_hash(tg::rng& rng, tg::spatial_hash<float> const& grid, std::vector<tg::pos3> const& pts, tg::aabb3 const& range)
+{
+    CHECK(grid.size() == pts.size());
+
+    // every input point appears exactly once, buckets are ordered by input index
+    std::vector<int> seen(pts.size());
+    for (auto i = 0; i < int(grid.size()); ++i)
+    {
+        CHECK(grid.points()[i] == pts[grid.indices()[i]]);
+        CHECK(grid.cells()[i] == grid.cell_of(pts[grid.indices()[i]]));
+        ++seen[grid.indices()[i]];
+    }
+    CHECK(std::all_of(seen.begin(), seen.end(), [](int c) { return c == 1; }));
+
+    for (auto it = 0; it < 10; ++it)
+    {
+        auto const q = uniform(rng, range);
+        auto const r = uniform(rng, 0.f, grid.cell_size());
+
+        auto found = grid.radius_search(q, r);
+        std::sort(found.begin(), found.end());
+
+        std::vector<tg::u32> expected;
+        for (auto i = 0; i < int(pts.size()); ++i)
+            if (distance_sqr(pts[i], q) <= r * r)
+                expected.push_back(tg::u32(i));
+
+        CHECK(found.size() == expected.size());
+        CHECK(std::equal(found.begin(), found.end(), expected.begin(), expected.end()));
+
+        // cell iteration
+        auto const c = grid.cell_of(q);
+        auto in_cell = 0;
+        grid.for_each_in_cell(c, [&](tg::u32 idx, tg::pos3 const& p) {
+            CHECK(p == pts[idx]);
+            CHECK(grid.cell_of(p) == c);
+            ++in_cell;
+        });
+        auto expected_in_cell = 0;
+        for (auto const& p : pts)
+            expected_in_cell += int(grid.cell_of(p) == c);
+        CHECK(in_cell == expected_in_cell);
+    }
+
+    // pairs
+    auto const r = grid.cell_size();
+    std::vector<std::pair<tg::u32, tg::u32>> pairs;
+    grid.for_each_pair(r, [&](tg::u32 i, tg::u32 j, float d2) {
+        CHECK(d2 == distance_sqr(pts[i], pts[j]));
+        pairs.emplace_back(tg::min(i, j), tg::max(i, j));
+    });
+    std::sort(pairs.begin(), pairs.end());
+
+    std::vector<std::pair<tg::u32, tg::u32>> expected_pairs;
+    for (auto i = 0; i < int(pts.size()); ++i)
+        for (auto j = i + 1; j < int(pts.size()); ++j)
+            if (distance_sqr(pts[i], pts[j]) <= r * r)
+                expected_pairs.emplace_back(tg::u32(i), tg::u32(j));
+    CHECK(pairs == expected_pairs);
+
+    // neighbors (every pair from both sides)
+    std::vector<int> neighbor_count(pts.size());
+    grid.for_each_neighbor(r, [&](tg::u32 i, tg::u32 j, float) {
+        CHECK(i != j);
+        ++neighbor_count[i];
+    });
+    std::vector<int> expected_count(pts.size());
+    for (auto const& [i, j] : expected_pairs)
+    {
+        ++expected_count[i];
+        ++expected_count[j];
+    }
+    CHECK(neighbor_count == expected_count);
+}
+}
+
+FUZZ_TEST("SpatialHash - Queries")(tg::rng& rng)
+{
+    auto const range = tg::aabb3(-10, 10);
+    std::vector<tg::pos3> pts;
+    auto const cnt = uniform(rng, 1, 500);
+    for (auto i = 0; i < cnt; ++i)
+        pts.push_back(uniform(rng, range));
+    // duplicates and points on cell borders
+    for (auto i = 0; i < cnt / 4; ++i)
+        pts.push_back(pts[i]);
+    for (auto i = 0; i < cnt / 4; ++i)
+        pts.push_back({float(uniform(rng, -10, 10)), uniform(rng, -10.f, 10.f), 0.f});
+
+    auto const cell_size = uniform(rng, 0.5f, 3.f);
+    check_spatial_hash(rng, tg::spatial_hash<float>(pts, cell_size), pts, range);
+}
+
+TEST("SpatialHash - Rebuild")
+{
+    tg::rng rng;
+    auto const range = tg::aabb3(-20, 20);
+
+    // large enough for the parallel paths
+    std::vector<tg::pos3> pts;
+    for (auto i = 0; i < 20000; ++i)
+        pts.push_back(uniform(rng, range));
+
+    tg::spatial_hash<float> grid;
+    CHECK(grid.empty());
+    CHECK(grid.radius_search(tg::pos3::zero, 1.f).empty());
+
+    grid.build(pts, 1.f);
+    auto const first = std::vector<tg::u32>(grid.indices().begin(), grid.indices().end());
+
+    // layout is deterministic
+    grid.build(pts, 1.f);
+    CHECK(std::equal(first.begin(), first.end(), grid.indices().begin(), grid.indices().end()));
+
+    // move points and rebuild in place
+    for (auto& p : pts)
+        p += tg::vec3(0.25f, -0.5f, 0.125f);
+    grid.build(pts, 1.f);
+
+    for (auto it = 0; it < 20; ++it)
+    {
+        auto const q = uniform(rng, range);
+        auto found = grid.radius_search(q, 1.f);
+        std::sort(found.begin(), found.end());
+
+        std::vector<tg::u32> expected;
+        for (auto i = 0; i < int(pts.size()); ++i)
+            if (distance_sqr(pts[i], q) <= 1.f)
+                expected.push_back(tg::u32(i));
+        CHECK(std::equal(found.begin(), found.end(), expected.begin(), expected.end()));
+    }
+
+    grid.build({}, 1.f);
+    CHECK(grid.empty());
+    CHECK(grid.radius_search(tg::pos3::zero, 1.f).empty());
+}
@@ -0,0 +1,130 @@
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/spatial.hh>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using pair_vec = std::vector<std::pair<tg::u32, tg::u32>>;
+
+pair_vec to_sorted(tg::span<tg::pair<tg::u32, tg::u32> const> pairs)
+{
+    pair_vec r;
+    for (auto const& p : pairs)
+    {
+        CHECK(p.first < p.second);
+        r.emplace_back(p.first, p.second);
+    }
+    std::sort(r.begin(), r.end());
+    return r;
+}
+
+pair_vec brute_force_pairs(std::vector<tg::aabb3> const& boxes)
+{
+    pair_vec r;
+    for (tg::u32 a = 0; a < boxes.size(); ++a)
+        for (auto b = a + 1; b < boxes.size(); ++b)
+            if (intersects(boxes[a], boxes[b]))
+                r.emplace_back(a, b);
+    return r;
+}
+
+tg::aabb3 random_box(tg::rng& rng, tg::aabb3 const& range)
+{
+    auto const c = uniform(rng, range);
+    auto const e = tg::vec3(uniform(rng, 0.1f, 2.f), uniform(rng, 0.1f, 2.f), uniform(rng, 0.1f, 2.f));
+    return {c - e, c + e};
+}
+}
+
+FUZZ_TEST("SweepAndPrune - Pairs")(tg::rng& rng)
+{
+    // stretched along y so that the automatic axis is not x
+    auto const range = tg::aabb3({-10, -40, -10}, {10, 40, 10});
+    std::vector<tg::aabb3> boxes;
+    auto const cnt = uniform(rng, 0, 400);
+    for (auto i = 0; i < cnt; ++i)
+        boxes.push_back(random_box(rng, range));
+    // touching boxes count as overlapping
+    if (cnt > 0)
+        boxes.push_back({{boxes[0].max.x, boxes[0].min.y, boxes[0].min.z}, {boxes[0].max.x + 1, boxes[0].max.y, boxes[0].max.z}});
+
+    tg::sweep_and_prune<3, float> sap;
+    sap.update(boxes);
+    CHECK(sap.size() == boxes.size());
+    if (cnt > 10)
+        CHECK(sap.axis() == 1);
+    CHECK(std::is_sorted(sap.sorted_boxes().begin(), sap.sorted_boxes().end(), [](tg::aabb3 const& a, tg::aabb3 const& b) { return a.min.y < b.min.y; }));
+
+    auto const expected = brute_force_pairs(boxes);
+    CHECK(to_sorted(sap.find_pairs()) == expected);
+    CHECK(to_sorted(sap.find_pairs_parallel()) == expected);
+
+    // coherent motion
+    for (auto frame = 0; frame < 5; ++frame)
+    {
+        for (auto& b : boxes)
+        {
+            auto const d = tg::vec3(uniform(rng, -0.3f, 0.3f), uniform(rng, -0.3f, 0.3f), uniform(rng, -0.3f, 0.3f));
+            b = {b.min + d, b.max + d};
+        }
+        sap.update(boxes);
+
+        for (auto i = 0; i < int(sap.size()); ++i)
+            CHECK(sap.sorted_boxes()[i] == boxes[sap.order()[i]]);
+
+        auto const exp = brute_force_pairs(boxes);
+        CHECK(to_sorted(sap.find_pairs()) == exp);
+    }
+
+    // fixed axis
+    tg::sweep_and_prune<3, float> sap_x(0);
+    sap_x.update(boxes);
+    CHECK(sap_x.axis() == 0);
+    CHECK(to_sorted(sap_x.find_pairs()) == brute_force_pairs(boxes));
+}
+
+TEST("SweepAndPrune - Coherence and parallel")
+{
+    tg::rng rng;
+    auto const range = tg::aabb3(-100, 100);
+
+    // large enough for the parallel sweep
+    std::vector<tg::aabb3> boxes;
+    for (auto i = 0; i < 10000; ++i)
+        boxes.push_back(random_box(rng, range));
+
+    tg::sweep_and_prune<3, float> sap;
+    sap.update(boxes);
+
+    auto const serial = sap.find_pairs();
+    auto const parallel = sap.find_pairs_parallel();
+    CHECK(serial.size() == parallel.size());
+    CHECK(std::equal(serial.begin(), serial.end(), parallel.begin(), parallel.end()));
+
+    // unchanged boxes need no swaps, small motion only few
+    sap.update(boxes);
+    CHECK(sap.swap_count() == 0);
+
+    for (auto& b : boxes)
+    {
+        auto const d = tg::vec3(uniform(rng, -0.01f, 0.01f), 0.f, 0.f);
+        b = {b.min + d, b.max + d};
+    }
+    sap.update(boxes);
+    CHECK(sap.swap_count() < boxes.size());
+    CHECK(to_sorted(sap.find_pairs_parallel()) == brute_force_pairs(boxes));
+
+    // changed count triggers a full rebuild
+    boxes.resize(100);
+    sap.update(boxes);
+    CHECK(sap.size() == 100);
+    CHECK(to_sorted(sap.find_pairs()) == brute_force_pairs(boxes));
+
+    sap.clear();
+    CHECK(sap.empty());
+    CHECK(sap.find_pairs().empty());
+}
@@ -0,0 +1,104 @@
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/feature/spatial.hh>
+
+#include <vector>
+
+namespace
+{
+/// closed, outward facing mesh of the surface of b (12 triangles)
+void make_box(tg::aabb3 const& b, std::vector<tg::pos3>& vertices, std::vector<tg::u32>& indices)
+{
+    for (auto i = 0; i < 8; ++i)
+        vertices.push_back({i & 1 ? b.max.x : b.min.x, i & 2 ? b.max.y : b.min.y, i & 4 ? b.max.z : b.min.z});
+
+    // quads (ccw from outside) of the faces -x, +x, -y, +y, -z, +z
+    tg::u32 const quads[6][4] = {{0, 4, 6, 2}, {1, 3, 7, 5}, {0, 1, 5, 4}, {2, 6, 7, 3}, {0, 2, 3, 1}, {4, 5, 7, 6}};
+    for (auto const& q : quads)
+        indices.insert(indices.end(), {q[0], q[1], q[2], q[0], q[2], q[3]});
+}
+}
+
+FUZZ_TEST("VoxelizeMesh - Surface")(tg::rng& rng)
+{
+    auto const range = tg::aabb3(-1, 1);
+    std::vector<tg::triangle3> tris;
+    auto const cnt = uniform(rng, 1, 10);
+    for (auto i = 0; i < cnt; ++i)
+        tris.emplace_back(uniform(rng, range), uniform(rng, range), uniform(rng, range));
+    // degenerate and partially outside
+    auto const p = uniform(rng, range);
+    tris.emplace_back(p, p + tg::vec3(0.3f, 0.2f, -0.1f), p + tg::vec3(0.6f, 0.4f, -0.2f));
+
+    auto const bounds = tg::aabb3(-0.8f, 0.9f);
+    auto const voxel_size = uniform(rng, 0.08f, 0.2f);
+    auto const grid = tg::voxelize_surface<float>(tris, bounds, voxel_size);
+    auto const sparse = tg::voxelize_surface_sparse<float>(tris, bounds, voxel_size);
+
+    std::vector<tg::ipos3> dense_list;
+    grid.for_each_voxel([&](tg::ipos3 v) { dense_list.push_back(v); });
+    CHECK(dense_list.size() == grid.count());
+    CHECK(dense_list.size() == sparse.size());
+    for (size_t i = 0; i < dense_list.size() && i < sparse.size(); ++i)
+        CHECK(dense_list[i] == sparse[i]);
+
+    // same as intersects(triangle3, aabb3), up to touching contacts
+    auto const eps = 1e-4f;
+    for (auto z = 0; z < grid.dims.depth; ++z)
+        for (auto y = 0; y < grid.dims.height; ++y)
+            for (auto x = 0; x < grid.dims.width; ++x)
+            {
+                auto const b = grid.voxel_bounds(x, y, z);
+                auto const grown = tg::aabb3(b.min - tg::vec3(eps), b.max + tg::vec3(eps));
+                auto const shrunk = tg::aabb3(b.min + tg::vec3(eps), b.max - tg::vec3(eps));
+
+                auto hit_grown = false;
+                auto hit_shrunk = false;
+                for (auto const& t : tris)
+                {
+                    hit_grown = hit_grown || intersects(t, grown);
+                    hit_shrunk = hit_shrunk || intersects(t, shrunk);
+                }
+
+                if (grid(x, y, z))
+                    CHECK(hit_grown);
+                else
+                    CHECK(!hit_shrunk);
+            }
+}
+
+FUZZ_TEST("VoxelizeMesh - Solid")(tg::rng& rng)
+{
+    auto const c = uniform(rng, tg::aabb3(-0.5f, 0.5f));
+    auto const e = tg::vec3(uniform(rng, 0.1f, 1.f), uniform(rng, 0.1f, 1.f), uniform(rng, 0.1f, 1.f));
+    auto const box = tg::aabb3(c - e, c + e);
+
+    std::vector<tg::pos3> vertices;
+    std::vector<tg::u32> indices;
+    make_box(box, vertices, indices);
+
+    auto const voxel_size = uniform(rng, 0.03f, 0.2f);
+    auto const grid = tg::voxelize_solid<float>(vertices, indices, tg::aabb3(-1.2f, 1.3f), voxel_size);
+
+    size_t inside_cnt = 0;
+    for (auto z = 0; z < grid.dims.depth; ++z)
+        for (auto y = 0; y < grid.dims.height; ++y)
+            for (auto x = 0; x < grid.dims.width; ++x)
+            {
+                auto const p = grid.center_of(x, y, z);
+                auto const d = tg::min(tg::min_element(p - box.min), tg::min_element(box.max - p));
+                inside_cnt += grid(x, y, z);
+                if (tg::abs(d) > 1e-4f) // skip centers on the surface
+                    CHECK(grid(x, y, z) == (d > 0));
+            }
+    CHECK(inside_cnt == grid.count());
+
+    // the box surface passes between a solid voxel center and an outside neighbor center
+    auto const surf = tg::voxelize_surface<float>(vertices, indices, tg::aabb3(-1.2f, 1.3f), voxel_size);
+    CHECK(surf.dims == grid.dims);
+    for (auto z = 0; z < grid.dims.depth; ++z)
+        for (auto y = 0; y < grid.dims.height; ++y)
+            for (auto x = 0; x + 1 < grid.dims.width; ++x)
+                if (grid(x, y, z) != grid(x + 1, y, z))
+                    CHECK((surf(x, y, z) || surf(x + 1, y, z)));
+}
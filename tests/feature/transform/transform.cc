@@ -0,0 +1,86 @@
+#include <nexus/ext/tg-approx.hh>
+#include <nexus/fuzz_test.hh>
+
+#include <typed-geometry/tg.hh>
+
+namespace
+{
+tg::affine3 random_affine(tg::rng& rng)
+{
+    auto const r = tg::aabb3(-3, 3);
+    tg::affine3 t;
+    for (auto i = 0; i < 3; ++i)
+        t.linear[i] = tg::vec3(uniform(rng, r));
+    t.translation = tg::vec3(uniform(rng, r));
+    return t;
+}
+
+tg::rigid3 random_rigid(tg::rng& rng)
+{
+    auto const q = tg::quat::from_axis_angle(tg::uniform<tg::dir3>(rng), uniform(rng, -180_deg, 180_deg));
+    return {q, tg::vec3(uniform(rng, tg::aabb3(-10, 10)))};
+}
+}
+
+FUZZ_TEST("Affine - Matches mat4")(tg::rng& rng)
+{
+    auto const a = random_affine(rng);
+    auto const b = random_affine(rng);
+    auto const p = uniform(rng, tg::aabb3(-5, 5));
+    auto const v = tg::vec3(uniform(rng, tg::aabb3(-5, 5)));
+
+    auto const ma = tg::mat4(a);
+    auto const mb = tg::mat4(b);
+    CHECK(is_affine(ma));
+    CHECK(tg::affine3::from_mat(ma) == a);
+
+    CHECK(a * p == nx::approx(ma * p).abs(1e-3f));
+    CHECK(a * v == nx::approx(tg::vec3(ma * tg::vec4(v, 0))).abs(1e-3f));
+    CHECK(tg::mat4(a * b) == nx::approx(ma * mb).abs(1e-3f));
+    CHECK((a * b) * p == nx::approx(a * (b * p)).abs(1e-2f));
+
+    if (tg::abs(determinant(a.linear)) > 0.1f)
+    {
+        auto const ai = inverse(a);
+        CHECK(ai * (a * p) == nx::approx(p).abs(1e-2f));
+        CHECK(tg::mat4(ai) == nx::approx(inverse(ma)).abs(1e-2f));
+    }
+
+    // transformed aabb contains all transformed corners and is tight
+    auto const bb = aabb_of(uniform(rng, tg::aabb3(-5, 5)), uniform(rng, tg::aabb3(-5, 5)));
+    auto const tbb = a * bb;
+    auto corners = aabb_of(a * bb.min);
+    for (auto i = 0; i < 8; ++i)
+    {
+        auto const c = tg::pos3(i & 1 ? bb.max.x : bb.min.x, i & 2 ? bb.max.y : bb.min.y, i & 4 ? bb.max.z : bb.min.z);
+        corners = aabb_of(corners, a * c);
+    }
+    CHECK(tbb.min == nx::approx(corners.min).abs(1e-3f));
+    CHECK(tbb.max == nx::approx(corners.max).abs(1e-3f));
+}
+
+FUZZ_TEST("Rigid - Matches mat4")(tg::rng& rng)
+{
+    auto const a = random_rigid(rng);
+    auto const b = random_rigid(rng);
+    auto const p = uniform(rng, tg::aabb3(-5, 5));
+    auto const d = tg::uniform<tg::dir3>(rng);
+
+    auto const ma = tg::mat4(a);
+    auto const mb = tg::mat4(b);
+
+    CHECK(a * p == nx::approx(ma * p).abs(1e-3f));
+    CHECK(a * d == nx::approx(a.rotation * d).abs(1e-4f));
+    CHECK(tg::mat4(a * b) == nx::approx(ma * mb).abs(1e-3f));
+    CHECK(tg::affine3(a) * p == nx::approx(a * p).abs(1e-3f));
+
+    auto const ai = inverse(a);
+    CHECK(ai * (a * p) == nx::approx(p).abs(1e-3f));
+    CHECK(tg::mat4(ai) == nx::approx(inverse(ma)).abs(1e-3f));
+
+    auto const ra = tg::rigid3::from_mat(ma);
+    CHECK(ra * p == nx::approx(a * p).abs(1e-3f));
+
+    CHECK(tg::rigid3::identity * p == p);
+    CHECK(tg::affine3::identity * p == p);
+}